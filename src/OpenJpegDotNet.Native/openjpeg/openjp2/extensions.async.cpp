@@ -0,0 +1 @@
+#include "extensions.async.hpp"
\ No newline at end of file
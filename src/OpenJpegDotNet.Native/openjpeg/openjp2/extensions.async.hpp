@@ -0,0 +1,200 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_ASYNC_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_ASYNC_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Runs opj_decode and opj_encode on a native thread pool so that callers do not block while a codestream
+// is processed. Completion is signalled through an optional callback, invoked on the pool thread, and
+// through the job handle, which can be polled or waited on.
+typedef struct extensions_async_job extensions_async_job_t;
+
+typedef void (*extensions_async_callback)(extensions_async_job_t* job, int32_t status, void* user_data);
+
+struct extensions_async_job
+{
+    std::mutex mutex;
+    std::condition_variable completed;
+    // The caller and the pool each hold a reference until they are done with the job
+    std::atomic<int32_t> references;
+    std::function<int32_t()> work;
+    extensions_async_callback callback;
+    void* user_data;
+    int32_t status;
+    bool done;
+};
+
+typedef struct extensions_async_pool
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<extensions_async_job_t*> queue;
+    std::vector<std::thread> threads;
+    bool closed;
+} extensions_async_pool_t;
+
+inline void extensions_async_job_unref(extensions_async_job_t* job)
+{
+    if (--job->references == 0)
+        delete job;
+}
+
+inline void extensions_async_worker(extensions_async_pool_t* pool)
+{
+    while (true)
+    {
+        extensions_async_job_t* job;
+        {
+            std::unique_lock<std::mutex> lock(pool->mutex);
+            pool->changed.wait(lock, [pool] { return pool->closed || !pool->queue.empty(); });
+            if (pool->queue.empty())
+                return;
+
+            job = pool->queue.front();
+            pool->queue.pop_front();
+        }
+
+        const auto status = job->work();
+        job->work = nullptr;
+
+        {
+            std::lock_guard<std::mutex> lock(job->mutex);
+            job->status = status;
+            job->done = true;
+        }
+        job->completed.notify_all();
+
+        if (job->callback != nullptr)
+            job->callback(job, status, job->user_data);
+
+        extensions_async_job_unref(job);
+    }
+}
+
+inline extensions_async_job_t* extensions_async_submit(extensions_async_pool_t* pool,
+                                                       std::function<int32_t()> work,
+                                                       const extensions_async_callback callback,
+                                                       void* user_data)
+{
+    auto job = new extensions_async_job_t();
+    job->references = 2;
+    job->work = std::move(work);
+    job->callback = callback;
+    job->user_data = user_data;
+    job->status = ERR_OK;
+    job->done = false;
+
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        pool->queue.push_back(job);
+    }
+    pool->changed.notify_one();
+
+    return job;
+}
+
+DLLEXPORT extensions_async_pool_t* openjpeg_openjp2_extensions_async_pool_new(const int32_t num_threads)
+{
+    auto pool = new extensions_async_pool_t();
+    pool->closed = false;
+
+    const auto count = num_threads > 0 ? num_threads : std::max(1, ::opj_get_num_cpus());
+    pool->threads.reserve(count);
+    for (int32_t index = 0; index < count; index++)
+        pool->threads.emplace_back(extensions_async_worker, pool);
+
+    return pool;
+}
+
+// Jobs already queued still run before the pool goes away
+DLLEXPORT void openjpeg_openjp2_extensions_async_pool_delete(extensions_async_pool_t* pool)
+{
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        pool->closed = true;
+    }
+    pool->changed.notify_all();
+
+    for (auto& thread : pool->threads)
+        thread.join();
+
+    delete pool;
+}
+
+// Same contract as openjpeg_openjp2_opj_decode followed by openjpeg_openjp2_opj_end_decompress.
+// codec, stream and image must stay alive and untouched until the job completes.
+DLLEXPORT extensions_async_job_t* openjpeg_openjp2_extensions_async_decode(extensions_async_pool_t* pool,
+                                                                           opj_codec_t* p_codec,
+                                                                           opj_stream_t* p_stream,
+                                                                           opj_image_t* p_image,
+                                                                           const extensions_async_callback callback,
+                                                                           void* user_data)
+{
+    return extensions_async_submit(pool, [p_codec, p_stream, p_image]
+    {
+        if (!::opj_decode(p_codec, p_stream, p_image))
+            return ERR_IMAGE_DECODE_FAILED;
+        if (!::opj_end_decompress(p_codec, p_stream))
+            return ERR_IMAGE_DECODE_FAILED;
+        return ERR_OK;
+    }, callback, user_data);
+}
+
+// Same contract as openjpeg_openjp2_opj_start_compress, openjpeg_openjp2_opj_encode and
+// openjpeg_openjp2_opj_end_compress called in a row on a codec already set up with opj_setup_encoder.
+DLLEXPORT extensions_async_job_t* openjpeg_openjp2_extensions_async_encode(extensions_async_pool_t* pool,
+                                                                           opj_codec_t* p_codec,
+                                                                           opj_image_t* p_image,
+                                                                           opj_stream_t* p_stream,
+                                                                           const extensions_async_callback callback,
+                                                                           void* user_data)
+{
+    return extensions_async_submit(pool, [p_codec, p_image, p_stream]
+    {
+        if (!::opj_start_compress(p_codec, p_image, p_stream))
+            return ERR_IMAGE_ENCODE_FAILED;
+        if (!::opj_encode(p_codec, p_stream))
+            return ERR_IMAGE_ENCODE_FAILED;
+        if (!::opj_end_compress(p_codec, p_stream))
+            return ERR_IMAGE_ENCODE_FAILED;
+        return ERR_OK;
+    }, callback, user_data);
+}
+
+DLLEXPORT bool openjpeg_openjp2_extensions_async_job_poll(extensions_async_job_t* job, int32_t* status)
+{
+    std::lock_guard<std::mutex> lock(job->mutex);
+    *status = job->status;
+    return job->done;
+}
+
+// A negative timeout waits until the job completes
+DLLEXPORT bool openjpeg_openjp2_extensions_async_job_wait(extensions_async_job_t* job,
+                                                          const int32_t timeout_ms,
+                                                          int32_t* status)
+{
+    std::unique_lock<std::mutex> lock(job->mutex);
+    if (timeout_ms < 0)
+        job->completed.wait(lock, [job] { return job->done; });
+    else
+        job->completed.wait_for(lock, std::chrono::milliseconds(timeout_ms), [job] { return job->done; });
+
+    *status = job->status;
+    return job->done;
+}
+
+// The handle can be deleted at any time, including from the completion callback; a pending job still runs
+DLLEXPORT void openjpeg_openjp2_extensions_async_job_delete(extensions_async_job_t* job)
+{
+    extensions_async_job_unref(job);
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_ASYNC_H_
\ No newline at end of file
@@ -0,0 +1 @@
+#include "extensions.boxes.hpp"
\ No newline at end of file
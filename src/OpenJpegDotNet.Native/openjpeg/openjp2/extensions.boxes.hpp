@@ -0,0 +1,261 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_BOXES_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_BOXES_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.codestream.hpp"
+
+#include <cmath>
+
+#define EXTENSIONS_JP2_UUID 0x75756964
+#define EXTENSIONS_JP2_UINF 0x75696e66
+#define EXTENSIONS_JP2_JPCH 0x6a706368
+#define EXTENSIONS_JP2_JPLH 0x6a706c68
+#define EXTENSIONS_JP2_CGRP 0x63677270
+#define EXTENSIONS_JP2_FTBL 0x6674626c
+#define EXTENSIONS_JP2_COMP 0x636f6d70
+
+#define EXTENSIONS_BOXES_MAX_DEPTH 16
+
+typedef struct extensions_box_info
+{
+    uint32_t type;
+    uint32_t depth;
+    uint64_t offset;
+    uint64_t header_length;
+    uint64_t length;
+} extensions_box_info_t;
+
+inline bool extensions_boxes_is_superbox(const uint32_t type)
+{
+    switch (type)
+    {
+        case EXTENSIONS_JP2_JP2H:
+        case EXTENSIONS_JP2_RES:
+        case EXTENSIONS_JP2_UINF:
+        case EXTENSIONS_JP2_ASOC:
+        case EXTENSIONS_JP2_JPCH:
+        case EXTENSIONS_JP2_JPLH:
+        case EXTENSIONS_JP2_CGRP:
+        case EXTENSIONS_JP2_FTBL:
+        case EXTENSIONS_JP2_COMP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Calls visitor(box, depth) for every box in [begin, end) in file order, descending into superboxes.
+// The visitor returns false to stop the walk. A truncated box is still visited but not descended into.
+template<typename Visitor>
+inline bool extensions_boxes_walk(const uint8_t* buf,
+                                  const uint64_t begin,
+                                  const uint64_t end,
+                                  const uint32_t depth,
+                                  Visitor& visitor)
+{
+    auto offset = begin;
+    while (offset < end)
+    {
+        extensions_box_t box;
+        if (!extensions_read_box_header(buf, end, offset, &box))
+            return false;
+
+        const auto complete = box.length <= end - offset;
+        if (!visitor(box, depth))
+            return false;
+        if (!complete)
+            return false;
+
+        if (depth + 1 < EXTENSIONS_BOXES_MAX_DEPTH && extensions_boxes_is_superbox(box.type))
+        {
+            if (!extensions_boxes_walk(buf, box.offset + box.header_length, box.offset + box.length, depth + 1, visitor))
+                return false;
+        }
+
+        offset += box.length;
+    }
+
+    return true;
+}
+
+// Finds the index-th box of the given type at any depth.
+inline bool extensions_boxes_find(const uint8_t* buf,
+                                  const uint64_t len,
+                                  const uint32_t type,
+                                  const uint32_t index,
+                                  extensions_box_t* result)
+{
+    auto found = false;
+    uint32_t count = 0;
+    auto visitor = [&](const extensions_box_t& box, const uint32_t)
+    {
+        if (box.type != type || box.length > len - box.offset)
+            return true;
+        if (count++ != index)
+            return true;
+
+        *result = box;
+        found = true;
+        return false;
+    };
+
+    extensions_boxes_walk(buf, EXTENSIONS_JP2_SIGNATURE_LENGTH, len, 0, visitor);
+    return found;
+}
+
+// Lists every box with its depth, offset and lengths. count receives the total number of boxes,
+// which may exceed boxes_len; only the first boxes_len entries are written.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_jp2_get_boxes(const uint8_t* buf,
+                                                            const uint64_t len,
+                                                            extensions_box_info_t* boxes,
+                                                            const uint32_t boxes_len,
+                                                            uint32_t* count)
+{
+    *count = 0;
+
+    if (!extensions_is_jp2(buf, len))
+        return ERR_IMAGE_FILE_INVALID;
+
+    uint32_t total = 0;
+    auto visitor = [&](const extensions_box_t& box, const uint32_t depth)
+    {
+        if (boxes != nullptr && total < boxes_len)
+        {
+            boxes[total].type = box.type;
+            boxes[total].depth = depth;
+            boxes[total].offset = box.offset;
+            boxes[total].header_length = box.header_length;
+            boxes[total].length = box.length;
+        }
+
+        total++;
+        return true;
+    };
+
+    extensions_boxes_walk(buf, 0, len, 0, visitor);
+    *count = total;
+    return ERR_OK;
+}
+
+// Returns the payload view of the index-th box of the given type.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_jp2_find_box(const uint8_t* buf,
+                                                           const uint64_t len,
+                                                           const uint32_t type,
+                                                           const uint32_t index,
+                                                           uint64_t* data_offset,
+                                                           uint64_t* data_len)
+{
+    *data_offset = 0;
+    *data_len = 0;
+
+    if (!extensions_is_jp2(buf, len))
+        return ERR_IMAGE_FILE_INVALID;
+
+    extensions_box_t box;
+    if (!extensions_boxes_find(buf, len, type, index, &box))
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    *data_offset = box.offset + box.header_length;
+    *data_len = box.length - box.header_length;
+    return ERR_OK;
+}
+
+// Returns the view of the ICC profile carried by a restricted or any ICC colr box.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_jp2_get_icc_profile(const uint8_t* buf,
+                                                                  const uint64_t len,
+                                                                  uint64_t* icc_offset,
+                                                                  uint64_t* icc_len)
+{
+    *icc_offset = 0;
+    *icc_len = 0;
+
+    if (!extensions_is_jp2(buf, len))
+        return ERR_IMAGE_FILE_INVALID;
+
+    extensions_box_t box;
+    for (uint32_t index = 0; extensions_boxes_find(buf, len, EXTENSIONS_JP2_COLR, index, &box); index++)
+    {
+        const auto offset = box.offset + box.header_length;
+        const auto length = box.length - box.header_length;
+        if (length <= 3)
+            continue;
+
+        const auto meth = buf[offset];
+        if (meth != 2 && meth != 3)
+            continue;
+
+        *icc_offset = offset + 3;
+        *icc_len = length - 3;
+        return ERR_OK;
+    }
+
+    return ERR_GENERAL_OUT_OF_RANGE;
+}
+
+DLLEXPORT int32_t openjpeg_openjp2_extensions_jp2_get_xml(const uint8_t* buf,
+                                                          const uint64_t len,
+                                                          const uint32_t index,
+                                                          uint64_t* xml_offset,
+                                                          uint64_t* xml_len)
+{
+    return openjpeg_openjp2_extensions_jp2_find_box(buf, len, EXTENSIONS_JP2_XML, index, xml_offset, xml_len);
+}
+
+// Returns the 16 byte UUID and the view of the data that follows it.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_jp2_get_uuid(const uint8_t* buf,
+                                                           const uint64_t len,
+                                                           const uint32_t index,
+                                                           uint8_t* uuid,
+                                                           uint64_t* data_offset,
+                                                           uint64_t* data_len)
+{
+    uint64_t offset;
+    uint64_t length;
+    const auto ret = openjpeg_openjp2_extensions_jp2_find_box(buf, len, EXTENSIONS_JP2_UUID, index, &offset, &length);
+    if (ret != ERR_OK)
+        return ret;
+    if (length < 16)
+        return ERR_IMAGE_FILE_INVALID;
+
+    memcpy(uuid, buf + offset, 16);
+    *data_offset = offset + 16;
+    *data_len = length - 16;
+    return ERR_OK;
+}
+
+// Reads the capture (resc) or default display (resd) resolution in pixels per metre.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_jp2_get_resolution(const uint8_t* buf,
+                                                                 const uint64_t len,
+                                                                 const bool capture,
+                                                                 double* resolution_x,
+                                                                 double* resolution_y)
+{
+    *resolution_x = 0;
+    *resolution_y = 0;
+
+    uint64_t offset;
+    uint64_t length;
+    const auto type = capture ? EXTENSIONS_JP2_RESC : EXTENSIONS_JP2_RESD;
+    const auto ret = openjpeg_openjp2_extensions_jp2_find_box(buf, len, type, 0, &offset, &length);
+    if (ret != ERR_OK)
+        return ret;
+    if (length < 10)
+        return ERR_IMAGE_FILE_INVALID;
+
+    const auto* p = buf + offset;
+    const auto vr_n = extensions_read_uint16(p);
+    const auto vr_d = extensions_read_uint16(p + 2);
+    const auto hr_n = extensions_read_uint16(p + 4);
+    const auto hr_d = extensions_read_uint16(p + 6);
+    const auto vr_e = (int8_t)p[8];
+    const auto hr_e = (int8_t)p[9];
+    if (vr_d == 0 || hr_d == 0)
+        return ERR_IMAGE_FILE_INVALID;
+
+    *resolution_y = (double)vr_n / vr_d * std::pow(10.0, vr_e);
+    *resolution_x = (double)hr_n / hr_d * std::pow(10.0, hr_e);
+    return ERR_OK;
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_BOXES_H_
\ No newline at end of file
@@ -0,0 +1 @@
+#include "extensions.budget.hpp"
\ No newline at end of file
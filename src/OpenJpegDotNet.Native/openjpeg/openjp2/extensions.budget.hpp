@@ -0,0 +1,244 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_BUDGET_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_BUDGET_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.codestream.hpp"
+#include "extensions.decode.hpp"
+
+// What the caller allows when the request does not fit in the budget
+#define EXTENSIONS_BUDGET_ALLOW_REDUCE 0x1
+#define EXTENSIONS_BUDGET_ALLOW_TILED  0x2
+
+// FULL means the whole output image fits, TILED means only the working set of one tile does
+// and the output has to be consumed tile by tile
+#define EXTENSIONS_BUDGET_MODE_FULL  0
+#define EXTENSIONS_BUDGET_MODE_TILED 1
+
+// Reading the main header makes the codec allocate an opj_tcp_t with an opj_tccp_t per component and a
+// codestream index entry with room for this many markers for every tile, whether it is decoded or not.
+// opj_tcp_t and opj_tccp_t are private to the library; these are their sizes in a 64-bit build of 2.4.
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/lib/openjp2/j2k.h
+#define EXTENSIONS_BUDGET_TCP_SIZE 5696
+#define EXTENSIONS_BUDGET_TCCP_SIZE 1080
+#define EXTENSIONS_BUDGET_TILE_MARKERS 100
+
+// Memory needed to decode a codestream, derived from SIZ and COD only.
+// image_bytes is the int32 output image; tile_bytes bounds what the codec holds while decoding: the coding
+// parameters and codestream index of every tile, and for the tile being decoded the int32 tile-component data,
+// as much again for wavelet and code-block scratch, and the tile buffer filled by opj_decode_tile_data.
+// The compressed input itself is not counted.
+typedef struct extensions_budget_requirement
+{
+    uint64_t image_bytes;
+    uint64_t tile_bytes;
+} extensions_budget_requirement_t;
+
+inline void extensions_budget_get_requirement(const extensions_header_info_t* info,
+                                              const std::vector<extensions_header_comp_info_t>& comps,
+                                              const uint32_t reduce,
+                                              const uint32_t x0,
+                                              const uint32_t y0,
+                                              const uint32_t x1,
+                                              const uint32_t y1,
+                                              extensions_budget_requirement_t* requirement)
+{
+    const auto tile_w = std::min(info->tdx, info->x1 - info->x0);
+    const auto tile_h = std::min(info->tdy, info->y1 - info->y0);
+
+    const uint64_t tiles = (uint64_t)info->tw * info->th;
+    const uint64_t tile_params = EXTENSIONS_BUDGET_TCP_SIZE + (uint64_t)comps.size() * EXTENSIONS_BUDGET_TCCP_SIZE;
+    const uint64_t tile_index = sizeof(opj_tile_index_t) + EXTENSIONS_BUDGET_TILE_MARKERS * sizeof(opj_marker_info_t);
+
+    requirement->image_bytes = 0;
+    requirement->tile_bytes = tiles * (tile_params + tile_index);
+    for (const auto& comp : comps)
+    {
+        const uint64_t w = extensions_ceildivpow2(extensions_ceildiv(x1, comp.dx), reduce) - extensions_ceildivpow2(extensions_ceildiv(x0, comp.dx), reduce);
+        const uint64_t h = extensions_ceildivpow2(extensions_ceildiv(y1, comp.dy), reduce) - extensions_ceildivpow2(extensions_ceildiv(y0, comp.dy), reduce);
+        requirement->image_bytes += w * h * sizeof(OPJ_INT32);
+
+        // A tile that straddles the subsampling grid can gain one sample on each axis
+        const uint64_t tw = extensions_ceildivpow2(extensions_ceildiv(tile_w, comp.dx), reduce) + 1;
+        const uint64_t th = extensions_ceildivpow2(extensions_ceildiv(tile_h, comp.dy), reduce) + 1;
+        requirement->tile_bytes += tw * th * (2 * sizeof(OPJ_INT32) + extensions_decoder_get_sample_size(comp.prec));
+    }
+}
+
+// Zero area means the whole image. Fails when the area does not intersect the image.
+inline int32_t extensions_budget_read(const uint8_t* data,
+                                      const uint64_t data_len,
+                                      const int32_t x0,
+                                      const int32_t y0,
+                                      const int32_t x1,
+                                      const int32_t y1,
+                                      extensions_header_info_t* info,
+                                      std::vector<extensions_header_comp_info_t>& comps,
+                                      uint32_t area[4])
+{
+    const auto ret = extensions_read_header_info(data, data_len, info, comps);
+    if (ret != ERR_OK)
+        return ret;
+
+    area[0] = info->x0;
+    area[1] = info->y0;
+    area[2] = info->x1;
+    area[3] = info->y1;
+    if (x0 != 0 || y0 != 0 || x1 != 0 || y1 != 0)
+    {
+        if (x0 < 0 || y0 < 0 || x1 <= x0 || y1 <= y0)
+            return ERR_GENERAL_OUT_OF_RANGE;
+
+        area[0] = std::max(area[0], (uint32_t)x0);
+        area[1] = std::max(area[1], (uint32_t)y0);
+        area[2] = std::min(area[2], (uint32_t)x1);
+        area[3] = std::min(area[3], (uint32_t)y1);
+        if (area[2] <= area[0] || area[3] <= area[1])
+            return ERR_GENERAL_OUT_OF_RANGE;
+    }
+
+    return ERR_OK;
+}
+
+// Picks the lowest reduce, starting from the requested one, for which the decode fits in the budget
+inline int32_t extensions_budget_admit(const extensions_header_info_t* info,
+                                       const std::vector<extensions_header_comp_info_t>& comps,
+                                       const uint32_t area[4],
+                                       const uint64_t budget,
+                                       const uint32_t flags,
+                                       const uint32_t reduce,
+                                       uint32_t* admitted_reduce,
+                                       int32_t* mode)
+{
+    *admitted_reduce = reduce;
+    *mode = EXTENSIONS_BUDGET_MODE_FULL;
+
+    if (info->numresolutions == 0 || reduce >= info->numresolutions)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    const auto last = (flags & EXTENSIONS_BUDGET_ALLOW_REDUCE) != 0 ? info->numresolutions - 1 : reduce;
+    extensions_budget_requirement_t requirement;
+    for (auto candidate = reduce; candidate <= last; candidate++)
+    {
+        extensions_budget_get_requirement(info, comps, candidate, area[0], area[1], area[2], area[3], &requirement);
+        if (requirement.image_bytes + requirement.tile_bytes <= budget)
+        {
+            *admitted_reduce = candidate;
+            return ERR_OK;
+        }
+    }
+
+    if ((flags & EXTENSIONS_BUDGET_ALLOW_TILED) != 0)
+    {
+        extensions_budget_get_requirement(info, comps, reduce, area[0], area[1], area[2], area[3], &requirement);
+        if (requirement.tile_bytes <= budget)
+        {
+            *mode = EXTENSIONS_BUDGET_MODE_TILED;
+            return ERR_OK;
+        }
+    }
+
+    return ERR_GENERAL_OVER_BUDGET;
+}
+
+DLLEXPORT int32_t openjpeg_openjp2_extensions_budget_estimate(const uint8_t* data,
+                                                              const uint64_t data_len,
+                                                              const uint32_t reduce,
+                                                              const int32_t x0,
+                                                              const int32_t y0,
+                                                              const int32_t x1,
+                                                              const int32_t y1,
+                                                              uint64_t* image_bytes,
+                                                              uint64_t* tile_bytes)
+{
+    *image_bytes = 0;
+    *tile_bytes = 0;
+
+    extensions_header_info_t info;
+    std::vector<extensions_header_comp_info_t> comps;
+    uint32_t area[4];
+    const auto ret = extensions_budget_read(data, data_len, x0, y0, x1, y1, &info, comps, area);
+    if (ret != ERR_OK)
+        return ret;
+    if (reduce >= info.numresolutions)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    extensions_budget_requirement_t requirement;
+    extensions_budget_get_requirement(&info, comps, reduce, area[0], area[1], area[2], area[3], &requirement);
+    *image_bytes = requirement.image_bytes;
+    *tile_bytes = requirement.tile_bytes;
+    return ERR_OK;
+}
+
+// Decides how a request can run within budget bytes without touching the codec.
+// Returns ERR_GENERAL_OVER_BUDGET when none of the allowed fallbacks fit.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_budget_admit(const uint8_t* data,
+                                                           const uint64_t data_len,
+                                                           const uint64_t budget,
+                                                           const uint32_t flags,
+                                                           const uint32_t reduce,
+                                                           const int32_t x0,
+                                                           const int32_t y0,
+                                                           const int32_t x1,
+                                                           const int32_t y1,
+                                                           uint32_t* admitted_reduce,
+                                                           int32_t* mode)
+{
+    *admitted_reduce = reduce;
+    *mode = EXTENSIONS_BUDGET_MODE_FULL;
+
+    extensions_header_info_t info;
+    std::vector<extensions_header_comp_info_t> comps;
+    uint32_t area[4];
+    const auto ret = extensions_budget_read(data, data_len, x0, y0, x1, y1, &info, comps, area);
+    if (ret != ERR_OK)
+        return ret;
+
+    return extensions_budget_admit(&info, comps, area, budget, flags, reduce, admitted_reduce, mode);
+}
+
+// Same as openjpeg_openjp2_extensions_decode_memory, but the request is admitted against budget first and
+// reduce is raised when EXTENSIONS_BUDGET_ALLOW_REDUCE is set. The whole output image is returned, so
+// EXTENSIONS_BUDGET_ALLOW_TILED is refused with ERR_GENERAL_OUT_OF_RANGE; a caller that can take the output
+// tile by tile admits with it through openjpeg_openjp2_extensions_budget_admit and decodes the tiles itself.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_budget_decode_memory(const uint8_t* data,
+                                                                   const uint64_t data_len,
+                                                                   const uint64_t budget,
+                                                                   const uint32_t flags,
+                                                                   const uint32_t reduce,
+                                                                   const uint32_t layers,
+                                                                   const int32_t x0,
+                                                                   const int32_t y0,
+                                                                   const int32_t x1,
+                                                                   const int32_t y1,
+                                                                   const int32_t num_threads,
+                                                                   const extensions_cancel_token_t* token,
+                                                                   opj_image_t** image,
+                                                                   uint32_t* admitted_reduce)
+{
+    *image = nullptr;
+    *admitted_reduce = reduce;
+
+    if ((flags & ~EXTENSIONS_BUDGET_ALLOW_REDUCE) != 0)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    int32_t mode;
+    auto ret = openjpeg_openjp2_extensions_budget_admit(data, data_len, budget, flags, reduce, x0, y0, x1, y1,
+                                                        admitted_reduce, &mode);
+    if (ret != ERR_OK)
+        return ret;
+
+    extensions_decode_options_t options;
+    options.reduce = *admitted_reduce;
+    options.layers = layers;
+    options.x0 = x0;
+    options.y0 = y0;
+    options.x1 = x1;
+    options.y1 = y1;
+    options.num_threads = num_threads;
+    options.token = token;
+
+    return extensions_decode_image(data, data_len, &options, image);
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_BUDGET_H_
\ No newline at end of file
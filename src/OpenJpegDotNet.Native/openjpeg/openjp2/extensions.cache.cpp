@@ -0,0 +1 @@
+#include "extensions.cache.hpp"
\ No newline at end of file
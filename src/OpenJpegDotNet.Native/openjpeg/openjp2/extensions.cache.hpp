@@ -0,0 +1,360 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_CACHE_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_CACHE_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.decode.hpp"
+#include "extensions.pixels.hpp"
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+
+// Caches packed pixels by the content of the input and the decode options, so that decoding the same bytes
+// with the same parameters again skips the codec. Entries are evicted least recently used first once the
+// cache holds more than max_bytes of pixels and inputs.
+
+// https://github.com/Cyan4973/xxHash/blob/v0.8.0/xxhash.h (XXH64)
+#define EXTENSIONS_XXH_PRIME64_1 0x9E3779B185EBCA87ULL
+#define EXTENSIONS_XXH_PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define EXTENSIONS_XXH_PRIME64_3 0x165667B19E3779F9ULL
+#define EXTENSIONS_XXH_PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define EXTENSIONS_XXH_PRIME64_5 0x27D4EB2F165667C5ULL
+
+inline uint64_t extensions_xxh64_rotl(const uint64_t value, const int32_t bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t extensions_xxh64_read64(const uint8_t* p)
+{
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t extensions_xxh64_read32(const uint8_t* p)
+{
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t extensions_xxh64_round(uint64_t acc, const uint64_t input)
+{
+    acc += input * EXTENSIONS_XXH_PRIME64_2;
+    acc = extensions_xxh64_rotl(acc, 31);
+    return acc * EXTENSIONS_XXH_PRIME64_1;
+}
+
+inline uint64_t extensions_xxh64_merge_round(uint64_t acc, const uint64_t value)
+{
+    acc ^= extensions_xxh64_round(0, value);
+    return acc * EXTENSIONS_XXH_PRIME64_1 + EXTENSIONS_XXH_PRIME64_4;
+}
+
+// Reads words in host order, which is little endian on every platform the library ships for
+inline uint64_t extensions_xxh64(const uint8_t* data, const uint64_t len, const uint64_t seed)
+{
+    auto p = data;
+    const auto end = data + len;
+    uint64_t h64;
+
+    if (len >= 32)
+    {
+        const auto limit = end - 32;
+        auto v1 = seed + EXTENSIONS_XXH_PRIME64_1 + EXTENSIONS_XXH_PRIME64_2;
+        auto v2 = seed + EXTENSIONS_XXH_PRIME64_2;
+        auto v3 = seed;
+        auto v4 = seed - EXTENSIONS_XXH_PRIME64_1;
+        do
+        {
+            v1 = extensions_xxh64_round(v1, extensions_xxh64_read64(p));
+            v2 = extensions_xxh64_round(v2, extensions_xxh64_read64(p + 8));
+            v3 = extensions_xxh64_round(v3, extensions_xxh64_read64(p + 16));
+            v4 = extensions_xxh64_round(v4, extensions_xxh64_read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        h64 = extensions_xxh64_rotl(v1, 1) + extensions_xxh64_rotl(v2, 7) + extensions_xxh64_rotl(v3, 12) + extensions_xxh64_rotl(v4, 18);
+        h64 = extensions_xxh64_merge_round(h64, v1);
+        h64 = extensions_xxh64_merge_round(h64, v2);
+        h64 = extensions_xxh64_merge_round(h64, v3);
+        h64 = extensions_xxh64_merge_round(h64, v4);
+    }
+    else
+    {
+        h64 = seed + EXTENSIONS_XXH_PRIME64_5;
+    }
+
+    h64 += len;
+
+    while (p + 8 <= end)
+    {
+        h64 ^= extensions_xxh64_round(0, extensions_xxh64_read64(p));
+        h64 = extensions_xxh64_rotl(h64, 27) * EXTENSIONS_XXH_PRIME64_1 + EXTENSIONS_XXH_PRIME64_4;
+        p += 8;
+    }
+
+    if (p + 4 <= end)
+    {
+        h64 ^= (uint64_t)extensions_xxh64_read32(p) * EXTENSIONS_XXH_PRIME64_1;
+        h64 = extensions_xxh64_rotl(h64, 23) * EXTENSIONS_XXH_PRIME64_2 + EXTENSIONS_XXH_PRIME64_3;
+        p += 4;
+    }
+
+    while (p < end)
+    {
+        h64 ^= (*p) * EXTENSIONS_XXH_PRIME64_5;
+        h64 = extensions_xxh64_rotl(h64, 11) * EXTENSIONS_XXH_PRIME64_1;
+        p++;
+    }
+
+    h64 ^= h64 >> 33;
+    h64 *= EXTENSIONS_XXH_PRIME64_2;
+    h64 ^= h64 >> 29;
+    h64 *= EXTENSIONS_XXH_PRIME64_3;
+    h64 ^= h64 >> 32;
+    return h64;
+}
+
+typedef struct extensions_cache_key
+{
+    uint64_t hash;
+    uint64_t length;
+    uint32_t reduce;
+    uint32_t layers;
+    int32_t x0;
+    int32_t y0;
+    int32_t x1;
+    int32_t y1;
+    int32_t format;
+    uint32_t flags;
+
+    bool operator==(const extensions_cache_key& other) const
+    {
+        return hash == other.hash && length == other.length && reduce == other.reduce && layers == other.layers &&
+               x0 == other.x0 && y0 == other.y0 && x1 == other.x1 && y1 == other.y1 && format == other.format &&
+               flags == other.flags;
+    }
+} extensions_cache_key_t;
+
+struct extensions_cache_key_hash
+{
+    size_t operator()(const extensions_cache_key_t& key) const
+    {
+        return (size_t)(key.hash ^ extensions_xxh64_rotl(key.length, 17) ^ ((uint64_t)key.reduce << 56) ^
+                        ((uint64_t)key.layers << 40) ^ ((uint64_t)(uint32_t)key.format << 32) ^ ((uint64_t)key.flags << 24));
+    }
+};
+
+// source is a copy of the input, compared on every hit so that two inputs with the same hash are never confused
+typedef struct extensions_cache_value
+{
+    extensions_pixels_t pixels;
+    std::vector<uint8_t> source;
+
+    uint64_t get_bytes() const
+    {
+        return pixels.length + source.size();
+    }
+
+    ~extensions_cache_value()
+    {
+        free(pixels.data);
+    }
+} extensions_cache_value_t;
+
+// A handle on cached pixels; they stay valid until the handle is released, even if the entry is evicted
+typedef struct extensions_cache_entry
+{
+    std::shared_ptr<extensions_cache_value_t> value;
+} extensions_cache_entry_t;
+
+typedef std::list<std::pair<extensions_cache_key_t, std::shared_ptr<extensions_cache_value_t>>> extensions_cache_list_t;
+
+typedef struct extensions_cache
+{
+    std::mutex mutex;
+    extensions_cache_list_t lru;
+    std::unordered_map<extensions_cache_key_t, extensions_cache_list_t::iterator, extensions_cache_key_hash> index;
+    uint64_t seed;
+    uint64_t max_bytes;
+    uint64_t bytes;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+} extensions_cache_t;
+
+inline void extensions_cache_evict(extensions_cache_t* cache)
+{
+    while (cache->bytes > cache->max_bytes && !cache->lru.empty())
+    {
+        const auto& last = cache->lru.back();
+        cache->bytes -= last.second->get_bytes();
+        cache->index.erase(last.first);
+        cache->lru.pop_back();
+        cache->evictions++;
+    }
+}
+
+DLLEXPORT extensions_cache_t* openjpeg_openjp2_extensions_cache_new(const uint64_t max_bytes)
+{
+    auto cache = new extensions_cache_t();
+    // Inputs cannot be made to collide on purpose without knowing the seed
+    std::random_device random;
+    cache->seed = ((uint64_t)random() << 32) | random();
+    cache->max_bytes = max_bytes;
+    cache->bytes = 0;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+    return cache;
+}
+
+DLLEXPORT void openjpeg_openjp2_extensions_cache_clear(extensions_cache_t* cache)
+{
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    cache->index.clear();
+    cache->lru.clear();
+    cache->bytes = 0;
+}
+
+DLLEXPORT void openjpeg_openjp2_extensions_cache_delete(extensions_cache_t* cache)
+{
+    delete cache;
+}
+
+// Returns the packed pixels for the input and options, converted with flags as in
+// openjpeg_openjp2_extensions_export_pixels, decoding only when they are not cached.
+// The entry must be released with openjpeg_openjp2_extensions_cache_entry_release.
+// Entries are looked up by a seeded 64-bit hash of the input and hit only when the input bytes are the same.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_cache_decode(extensions_cache_t* cache,
+                                                           const uint8_t* data,
+                                                           const uint64_t data_len,
+                                                           const uint32_t reduce,
+                                                           const uint32_t layers,
+                                                           const int32_t x0,
+                                                           const int32_t y0,
+                                                           const int32_t x1,
+                                                           const int32_t y1,
+                                                           const int32_t format,
+                                                           const uint32_t flags,
+                                                           const int32_t num_threads,
+                                                           extensions_cache_entry_t** entry)
+{
+    *entry = nullptr;
+
+    extensions_cache_key_t key;
+    key.hash = extensions_xxh64(data, data_len, cache->seed);
+    key.length = data_len;
+    key.reduce = reduce;
+    key.layers = layers;
+    key.x0 = x0;
+    key.y0 = y0;
+    key.x1 = x1;
+    key.y1 = y1;
+    key.format = format;
+    key.flags = flags;
+
+    {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        const auto it = cache->index.find(key);
+        if (it != cache->index.end() && memcmp(it->second->second->source.data(), data, (size_t)data_len) == 0)
+        {
+            cache->lru.splice(cache->lru.begin(), cache->lru, it->second);
+            cache->hits++;
+            *entry = new extensions_cache_entry_t{ it->second->second };
+            return ERR_OK;
+        }
+
+        cache->misses++;
+    }
+
+    extensions_decode_options_t options;
+    options.reduce = reduce;
+    options.layers = layers;
+    options.x0 = x0;
+    options.y0 = y0;
+    options.x1 = x1;
+    options.y1 = y1;
+    options.num_threads = num_threads;
+    options.token = nullptr;
+
+    opj_image_t* image;
+    auto ret = extensions_decode_image(data, data_len, &options, &image);
+    if (ret != ERR_OK)
+        return ret;
+
+    auto value = std::make_shared<extensions_cache_value_t>();
+    ret = extensions_pixels_pack(image, format, flags, &value->pixels);
+    ::opj_image_destroy(image);
+    if (ret != ERR_OK)
+        return ret;
+
+    value->source.assign(data, data + data_len);
+
+    {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        // Another thread may have decoded the same request meanwhile, or the entry holds another input
+        const auto it = cache->index.find(key);
+        if (it != cache->index.end())
+        {
+            cache->bytes -= it->second->second->get_bytes();
+            cache->lru.erase(it->second);
+            cache->index.erase(it);
+        }
+
+        if (value->get_bytes() <= cache->max_bytes)
+        {
+            cache->lru.emplace_front(key, value);
+            cache->index[key] = cache->lru.begin();
+            cache->bytes += value->get_bytes();
+            extensions_cache_evict(cache);
+        }
+    }
+
+    *entry = new extensions_cache_entry_t{ value };
+    return ERR_OK;
+}
+
+DLLEXPORT void openjpeg_openjp2_extensions_cache_entry_get_pixels(extensions_cache_entry_t* entry,
+                                                                  const uint8_t** pixels,
+                                                                  uint64_t* pixels_len,
+                                                                  uint32_t* width,
+                                                                  uint32_t* height,
+                                                                  uint32_t* channels,
+                                                                  uint32_t* bits)
+{
+    const auto& value = entry->value->pixels;
+    *pixels = value.data;
+    *pixels_len = value.length;
+    *width = value.width;
+    *height = value.height;
+    *channels = value.channels;
+    *bits = value.bits;
+}
+
+DLLEXPORT void openjpeg_openjp2_extensions_cache_entry_release(extensions_cache_entry_t* entry)
+{
+    delete entry;
+}
+
+DLLEXPORT void openjpeg_openjp2_extensions_cache_get_stats(extensions_cache_t* cache,
+                                                           uint64_t* hits,
+                                                           uint64_t* misses,
+                                                           uint64_t* evictions,
+                                                           uint64_t* entries,
+                                                           uint64_t* bytes)
+{
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    *hits = cache->hits;
+    *misses = cache->misses;
+    *evictions = cache->evictions;
+    *entries = cache->lru.size();
+    *bytes = cache->bytes;
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_CACHE_H_
\ No newline at end of file
@@ -0,0 +1 @@
+#include "extensions.cancel.hpp"
\ No newline at end of file
@@ -0,0 +1,63 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_CANCEL_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_CANCEL_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.decode.hpp"
+
+// A negative timeout means no deadline
+DLLEXPORT extensions_cancel_token_t* openjpeg_openjp2_extensions_cancel_token_new(const int32_t timeout_ms)
+{
+    auto token = new extensions_cancel_token_t();
+    token->cancelled = false;
+    token->has_deadline = timeout_ms >= 0;
+    if (token->has_deadline)
+        token->deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    return token;
+}
+
+DLLEXPORT void openjpeg_openjp2_extensions_cancel_token_delete(extensions_cancel_token_t* token)
+{
+    delete token;
+}
+
+// Safe to call from any thread while a decode is using the token
+DLLEXPORT void openjpeg_openjp2_extensions_cancel_token_cancel(extensions_cancel_token_t* token)
+{
+    token->cancelled = true;
+}
+
+// Returns ERR_OK, ERR_GENERAL_CANCELLED or ERR_GENERAL_DEADLINE_EXCEEDED
+DLLEXPORT int32_t openjpeg_openjp2_extensions_cancel_token_check(extensions_cancel_token_t* token)
+{
+    return extensions_cancel_token_check(token);
+}
+
+// Decodes a JPEG 2000 codestream or JP2 file held in memory, tile by tile, into a new image to be released
+// with openjpeg_openjp2_opj_image_destroy. Zero area means the whole image and token can be null.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_decode_memory(const uint8_t* data,
+                                                            const uint64_t data_len,
+                                                            const uint32_t reduce,
+                                                            const uint32_t layers,
+                                                            const int32_t x0,
+                                                            const int32_t y0,
+                                                            const int32_t x1,
+                                                            const int32_t y1,
+                                                            const int32_t num_threads,
+                                                            const extensions_cancel_token_t* token,
+                                                            opj_image_t** image)
+{
+    extensions_decode_options_t options;
+    options.reduce = reduce;
+    options.layers = layers;
+    options.x0 = x0;
+    options.y0 = y0;
+    options.x1 = x1;
+    options.y1 = y1;
+    options.num_threads = num_threads;
+    options.token = token;
+
+    return extensions_decode_image(data, data_len, &options, image);
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_CANCEL_H_
\ No newline at end of file
@@ -0,0 +1 @@
+#include "extensions.catalog.hpp"
\ No newline at end of file
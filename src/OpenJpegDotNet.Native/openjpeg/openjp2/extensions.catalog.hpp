@@ -0,0 +1,367 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_CATALOG_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_CATALOG_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.codestream.hpp"
+#include "format_defs.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#define EXTENSIONS_CATALOG_FORMAT_CSV    0
+#define EXTENSIONS_CATALOG_FORMAT_BINARY 1
+
+#define EXTENSIONS_CATALOG_DEFAULT_HEAD_SIZE 16384
+#define EXTENSIONS_CATALOG_MAX_TILES 65535
+
+typedef struct extensions_catalog_record
+{
+    std::string path;
+    int32_t status;
+    uint64_t file_size;
+    extensions_header_info_t info;
+    extensions_header_comp_info_t comp;
+    std::vector<uint64_t> tile_sizes;
+} extensions_catalog_record_t;
+
+typedef struct extensions_catalog_context
+{
+    std::filesystem::recursive_directory_iterator it;
+    std::mutex it_mutex;
+    bool recursive;
+
+    std::ofstream output;
+    std::mutex output_mutex;
+    int32_t output_format;
+
+    uint32_t head_size;
+    bool tile_sizes;
+
+    std::atomic<uint64_t> scanned;
+    std::atomic<uint64_t> failed;
+} extensions_catalog_context_t;
+
+// Hops from SOT to SOT by Psot and reads only the 12 byte marker segment of each tile-part.
+inline bool extensions_catalog_read_tile_sizes(std::ifstream& file,
+                                               const uint64_t codestream_offset,
+                                               const uint64_t codestream_end,
+                                               const uint64_t sot_offset,
+                                               std::vector<uint64_t>& tile_sizes)
+{
+    uint8_t sot[12];
+    auto pos = codestream_offset + sot_offset;
+    while (pos + sizeof(sot) <= codestream_end)
+    {
+        file.seekg((std::streamoff)pos);
+        if (!file.read((char*)sot, sizeof(sot)))
+            return false;
+
+        const auto marker = extensions_read_uint16(sot);
+        if (marker == EXTENSIONS_J2K_MS_EOC)
+            return true;
+        if (marker != EXTENSIONS_J2K_MS_SOT || extensions_read_uint16(sot + 2) != 10)
+            return false;
+
+        const auto isot = extensions_read_uint16(sot + 4);
+        uint64_t psot = extensions_read_uint32(sot + 6);
+        if (isot >= tile_sizes.size())
+            return false;
+
+        // Psot of 0 means the tile-part runs to the EOC marker
+        if (psot == 0)
+            psot = codestream_end - pos - 2;
+        if (psot < sizeof(sot))
+            return false;
+
+        tile_sizes[isot] += psot;
+        pos += psot;
+    }
+
+    return true;
+}
+
+inline void extensions_catalog_scan_file(extensions_catalog_context_t* context,
+                                         const std::filesystem::path& path,
+                                         const int32_t ext_format,
+                                         std::vector<uint8_t>& head,
+                                         extensions_catalog_record_t* record)
+{
+    record->path = path.u8string();
+    record->status = ERR_OK;
+    record->tile_sizes.clear();
+    memset(&record->info, 0, sizeof(extensions_header_info_t));
+    memset(&record->comp, 0, sizeof(extensions_header_comp_info_t));
+
+    std::error_code ec;
+    record->file_size = std::filesystem::file_size(path, ec);
+    if (ec)
+    {
+        record->status = ERR_GENERAL_FILE_IO;
+        return;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        record->status = ERR_GENERAL_FILE_IO;
+        return;
+    }
+
+    // The main header normally fits in the first read. The head grows, reading only the bytes it lacks, while the
+    // parser runs out of bytes before the end of the header, or before the first SOT when tile sizes are wanted.
+    extensions_cod_t cod;
+    uint64_t sot_offset = 0;
+    uint64_t size = 0;
+    auto next = std::min<uint64_t>(context->head_size, record->file_size);
+    while (true)
+    {
+        head.resize((size_t)next);
+        file.seekg((std::streamoff)size);
+        if (!file.read((char*)head.data() + size, (std::streamsize)(next - size)))
+        {
+            record->status = ERR_GENERAL_FILE_IO;
+            return;
+        }
+        size = next;
+
+        bool truncated;
+        record->status = extensions_header_read(head.data(), size, &record->info, &record->comp, 1, nullptr, &truncated);
+        if (record->status == ERR_OK && context->tile_sizes)
+        {
+            const auto offset = record->info.codestream_offset;
+            const auto end = std::min(size, offset + record->info.codestream_length);
+            if (!extensions_read_main_header(head.data() + offset, end - offset, &cod, &sot_offset, &truncated))
+                record->status = ERR_IMAGE_FILE_INVALID;
+            truncated = truncated && end == size;
+        }
+
+        if (!truncated || size == record->file_size)
+            break;
+
+        next = std::min<uint64_t>(size * 4, record->file_size);
+    }
+
+    if (record->status != ERR_OK)
+        return;
+
+    // A codestream that reaches the end of the head runs on to the end of the file
+    auto& info = record->info;
+    if (info.codestream_offset + info.codestream_length == size)
+        info.codestream_length = record->file_size - info.codestream_offset;
+
+    // Same rule as openjpeg_openjp2_infile_format
+    const auto magic_format = record->info.format == OPJ_CODEC_JP2 ? JP2_CFMT : J2K_CFMT;
+    if (ext_format != JPT_CFMT && ext_format != magic_format)
+        record->status = ERR_IMAGE_FILE_WRONG_EXTENSION;
+
+    if (!context->tile_sizes)
+        return;
+
+    const auto numtiles = (uint64_t)record->info.tw * record->info.th;
+    if (numtiles == 0 || numtiles > EXTENSIONS_CATALOG_MAX_TILES)
+    {
+        record->status = ERR_IMAGE_FILE_INVALID;
+        return;
+    }
+
+    // The whole file was read without reaching a tile-part
+    if (sot_offset == 0)
+    {
+        record->status = ERR_IMAGE_FILE_INVALID;
+        return;
+    }
+
+    const auto offset = record->info.codestream_offset;
+    const auto end = std::min(record->file_size, offset + record->info.codestream_length);
+    record->tile_sizes.assign((size_t)numtiles, 0);
+    file.clear();
+    if (!extensions_catalog_read_tile_sizes(file, offset, end, sot_offset, record->tile_sizes))
+        record->status = ERR_IMAGE_FILE_INVALID;
+}
+
+inline void extensions_catalog_write_csv_header(std::ofstream& output, const bool tile_sizes)
+{
+    output << "path,status,file_size,format,x0,y0,x1,y1,tx0,ty0,tdx,tdy,tw,th,numcomps,prec,sgnd,dx,dy,"
+              "numresolutions,numlayers,prog_order,irreversible,color_space,has_icc_profile,has_xml";
+    if (tile_sizes)
+        output << ",tile_sizes";
+    output << "\n";
+}
+
+inline void extensions_catalog_write_csv(std::ofstream& output,
+                                         const extensions_catalog_record_t* record,
+                                         const bool tile_sizes)
+{
+    const auto& info = record->info;
+    const auto& comp = record->comp;
+
+    output << '"';
+    for (const auto c : record->path)
+    {
+        if (c == '"')
+            output << '"';
+        output << c;
+    }
+    output << '"';
+
+    output << ',' << record->status << ',' << record->file_size << ',' << info.format
+           << ',' << info.x0 << ',' << info.y0 << ',' << info.x1 << ',' << info.y1
+           << ',' << info.tx0 << ',' << info.ty0 << ',' << info.tdx << ',' << info.tdy
+           << ',' << info.tw << ',' << info.th << ',' << info.numcomps
+           << ',' << comp.prec << ',' << comp.sgnd << ',' << comp.dx << ',' << comp.dy
+           << ',' << info.numresolutions << ',' << info.numlayers << ',' << info.prog_order
+           << ',' << info.irreversible << ',' << info.color_space
+           << ',' << info.has_icc_profile << ',' << info.has_xml;
+
+    if (tile_sizes)
+    {
+        output << ',';
+        for (size_t index = 0; index < record->tile_sizes.size(); index++)
+        {
+            if (index != 0)
+                output << ';';
+            output << record->tile_sizes[index];
+        }
+    }
+
+    output << "\n";
+}
+
+// Binary record: uint32 path length, path (UTF-8), int32 status, uint64 file size,
+// extensions_header_info_t, extensions_header_comp_info_t of component 0,
+// uint32 tile count and one uint64 byte size per tile. Native byte order.
+inline void extensions_catalog_write_binary(std::ofstream& output, const extensions_catalog_record_t* record)
+{
+    const auto path_len = (uint32_t)record->path.size();
+    const auto numtiles = (uint32_t)record->tile_sizes.size();
+    output.write((const char*)&path_len, sizeof(path_len));
+    output.write(record->path.data(), path_len);
+    output.write((const char*)&record->status, sizeof(record->status));
+    output.write((const char*)&record->file_size, sizeof(record->file_size));
+    output.write((const char*)&record->info, sizeof(record->info));
+    output.write((const char*)&record->comp, sizeof(record->comp));
+    output.write((const char*)&numtiles, sizeof(numtiles));
+    if (numtiles != 0)
+        output.write((const char*)record->tile_sizes.data(), sizeof(uint64_t) * numtiles);
+}
+
+inline bool extensions_catalog_next(extensions_catalog_context_t* context,
+                                    std::filesystem::path* path,
+                                    int32_t* ext_format)
+{
+    std::lock_guard<std::mutex> lock(context->it_mutex);
+
+    std::error_code ec;
+    const std::filesystem::recursive_directory_iterator end;
+    for (; context->it != end; context->it.increment(ec))
+    {
+        if (ec)
+            return false;
+
+        const auto& entry = *context->it;
+        if (!context->recursive && entry.is_directory(ec))
+            context->it.disable_recursion_pending();
+        if (!entry.is_regular_file(ec))
+            continue;
+
+        const auto format = get_file_format(entry.path().u8string().c_str());
+        if (format != J2K_CFMT && format != JP2_CFMT && format != JPT_CFMT)
+            continue;
+
+        *path = entry.path();
+        *ext_format = format;
+        context->it.increment(ec);
+        if (ec)
+            context->it = end;
+        return true;
+    }
+
+    return false;
+}
+
+inline void extensions_catalog_worker(extensions_catalog_context_t* context)
+{
+    std::vector<uint8_t> head;
+    extensions_catalog_record_t record;
+    std::filesystem::path path;
+    int32_t ext_format;
+
+    while (extensions_catalog_next(context, &path, &ext_format))
+    {
+        extensions_catalog_scan_file(context, path, ext_format, head, &record);
+
+        context->scanned++;
+        if (record.status != ERR_OK)
+            context->failed++;
+
+        std::lock_guard<std::mutex> lock(context->output_mutex);
+        if (context->output_format == EXTENSIONS_CATALOG_FORMAT_BINARY)
+            extensions_catalog_write_binary(context->output, &record);
+        else
+            extensions_catalog_write_csv(context->output, &record, context->tile_sizes);
+    }
+}
+
+// Indexes every .j2k/.jp2/.jpt/.j2c/.jpc file under directory by reading only the head of each file
+// (plus the SOT marker segments when tile_sizes is set) on num_threads concurrent readers.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_catalog_scan(const char* directory,
+                                                           const uint32_t directory_len,
+                                                           const bool recursive,
+                                                           const char* output,
+                                                           const uint32_t output_len,
+                                                           const int32_t output_format,
+                                                           const uint32_t head_size,
+                                                           const bool tile_sizes,
+                                                           const int32_t num_threads,
+                                                           uint64_t* scanned,
+                                                           uint64_t* failed)
+{
+    *scanned = 0;
+    *failed = 0;
+
+    if (output_format != EXTENSIONS_CATALOG_FORMAT_CSV && output_format != EXTENSIONS_CATALOG_FORMAT_BINARY)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    extensions_catalog_context_t context;
+    context.recursive = recursive;
+    context.output_format = output_format;
+    context.head_size = head_size != 0 ? head_size : EXTENSIONS_CATALOG_DEFAULT_HEAD_SIZE;
+    context.tile_sizes = tile_sizes;
+    context.scanned = 0;
+    context.failed = 0;
+
+    std::error_code ec;
+    const auto root = std::filesystem::u8path(std::string(directory, directory_len));
+    context.it = std::filesystem::recursive_directory_iterator(root, std::filesystem::directory_options::skip_permission_denied, ec);
+    if (ec)
+        return ERR_GENERAL_FILE_IO;
+
+    const auto output_path = std::filesystem::u8path(std::string(output, output_len));
+    const auto mode = output_format == EXTENSIONS_CATALOG_FORMAT_BINARY ? std::ios::binary | std::ios::trunc : std::ios::trunc;
+    context.output.open(output_path, std::ios::out | mode);
+    if (!context.output)
+        return ERR_GENERAL_FILE_IO;
+
+    if (output_format == EXTENSIONS_CATALOG_FORMAT_CSV)
+        extensions_catalog_write_csv_header(context.output, tile_sizes);
+
+    const auto count = num_threads > 0 ? num_threads : std::max(1, ::opj_get_num_cpus());
+    std::vector<std::thread> workers;
+    workers.reserve(count);
+    for (int32_t index = 0; index < count; index++)
+        workers.emplace_back(extensions_catalog_worker, &context);
+    for (auto& worker : workers)
+        worker.join();
+
+    context.output.close();
+
+    *scanned = context.scanned;
+    *failed = context.failed;
+    return context.output ? ERR_OK : ERR_GENERAL_FILE_IO;
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_CATALOG_H_
\ No newline at end of file
@@ -0,0 +1,612 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_CODESTREAM_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_CODESTREAM_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+
+#include <algorithm>
+#include <vector>
+
+// Helpers to walk JPEG 2000 codestream markers and JP2 boxes directly over a byte buffer.
+// They never create an OpenJPEG codec, so they are shared by several extension modules
+// and must stay inline because each module is compiled as its own translation unit.
+
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/lib/openjp2/j2k.h
+#define EXTENSIONS_J2K_MS_SOC 0xff4f
+#define EXTENSIONS_J2K_MS_SOT 0xff90
+#define EXTENSIONS_J2K_MS_SOD 0xff93
+#define EXTENSIONS_J2K_MS_EOC 0xffd9
+#define EXTENSIONS_J2K_MS_SIZ 0xff51
+#define EXTENSIONS_J2K_MS_COD 0xff52
+
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/lib/openjp2/jp2.h
+#define EXTENSIONS_JP2_JP   0x6a502020
+#define EXTENSIONS_JP2_FTYP 0x66747970
+#define EXTENSIONS_JP2_JP2H 0x6a703268
+#define EXTENSIONS_JP2_IHDR 0x69686472
+#define EXTENSIONS_JP2_COLR 0x636f6c72
+#define EXTENSIONS_JP2_JP2C 0x6a703263
+#define EXTENSIONS_JP2_BPCC 0x62706363
+#define EXTENSIONS_JP2_RES  0x72657320
+#define EXTENSIONS_JP2_RESC 0x72657363
+#define EXTENSIONS_JP2_RESD 0x72657364
+#define EXTENSIONS_JP2_JP2  0x6a703220
+#define EXTENSIONS_JP2_XML  0x786d6c20
+#define EXTENSIONS_JP2_ASOC 0x61736f63
+
+#define EXTENSIONS_JP2_SIGNATURE_LENGTH 12
+
+typedef struct extensions_siz
+{
+    uint16_t rsiz;
+    uint32_t x1;
+    uint32_t y1;
+    uint32_t x0;
+    uint32_t y0;
+    uint32_t tdx;
+    uint32_t tdy;
+    uint32_t tx0;
+    uint32_t ty0;
+    uint16_t numcomps;
+    // Points at the Ssiz/XRsiz/YRsiz triplets inside the caller's buffer
+    const uint8_t* comps;
+} extensions_siz_t;
+
+typedef struct extensions_cod
+{
+    uint8_t scod;
+    uint8_t prog_order;
+    uint16_t numlayers;
+    uint8_t mct;
+    uint8_t numresolutions;
+    uint8_t cblkw;
+    uint8_t cblkh;
+    uint8_t cblk_style;
+    uint8_t transform;
+} extensions_cod_t;
+
+typedef struct extensions_box
+{
+    uint32_t type;
+    uint64_t offset;
+    uint64_t header_length;
+    uint64_t length;
+} extensions_box_t;
+
+inline uint16_t extensions_read_uint16(const uint8_t* p)
+{
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+inline uint32_t extensions_read_uint32(const uint8_t* p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+inline uint64_t extensions_read_uint64(const uint8_t* p)
+{
+    return ((uint64_t)extensions_read_uint32(p) << 32) | (uint64_t)extensions_read_uint32(p + 4);
+}
+
+inline uint8_t* extensions_write_uint8(uint8_t* p, const uint8_t value)
+{
+    p[0] = value;
+    return p + 1;
+}
+
+inline uint8_t* extensions_write_uint16(uint8_t* p, const uint16_t value)
+{
+    p[0] = (uint8_t)(value >> 8);
+    p[1] = (uint8_t)(value);
+    return p + 2;
+}
+
+inline uint8_t* extensions_write_uint32(uint8_t* p, const uint32_t value)
+{
+    p[0] = (uint8_t)(value >> 24);
+    p[1] = (uint8_t)(value >> 16);
+    p[2] = (uint8_t)(value >> 8);
+    p[3] = (uint8_t)(value);
+    return p + 4;
+}
+
+inline uint8_t* extensions_write_uint64(uint8_t* p, const uint64_t value)
+{
+    p = extensions_write_uint32(p, (uint32_t)(value >> 32));
+    return extensions_write_uint32(p, (uint32_t)value);
+}
+
+inline bool extensions_is_jp2(const uint8_t* buf, const uint64_t len)
+{
+    static const uint8_t signature[EXTENSIONS_JP2_SIGNATURE_LENGTH] = { 0x00, 0x00, 0x00, 0x0c, 0x6a, 0x50, 0x20, 0x20, 0x0d, 0x0a, 0x87, 0x0a };
+    return len >= EXTENSIONS_JP2_SIGNATURE_LENGTH && memcmp(buf, signature, EXTENSIONS_JP2_SIGNATURE_LENGTH) == 0;
+}
+
+inline bool extensions_is_j2k(const uint8_t* buf, const uint64_t len)
+{
+    return len >= 4 &&
+           extensions_read_uint16(buf) == EXTENSIONS_J2K_MS_SOC &&
+           extensions_read_uint16(buf + 2) == EXTENSIONS_J2K_MS_SIZ;
+}
+
+// Reads the box header at offset without requiring the box contents to be present in the buffer.
+// A box length of 0 means the box extends to the end of the buffer.
+inline bool extensions_read_box_header(const uint8_t* buf,
+                                       const uint64_t len,
+                                       const uint64_t offset,
+                                       extensions_box_t* box)
+{
+    if (offset > len || len - offset < 8)
+        return false;
+
+    const auto lbox = extensions_read_uint32(buf + offset);
+    box->type = extensions_read_uint32(buf + offset + 4);
+    box->offset = offset;
+    box->header_length = 8;
+
+    if (lbox == 1)
+    {
+        if (len - offset < 16)
+            return false;
+
+        box->header_length = 16;
+        box->length = extensions_read_uint64(buf + offset + 8);
+    }
+    else if (lbox == 0)
+    {
+        box->length = len - offset;
+    }
+    else
+    {
+        box->length = lbox;
+    }
+
+    return box->length >= box->header_length;
+}
+
+// Reads the box header at offset and checks that the whole box lies inside the buffer.
+inline bool extensions_read_box(const uint8_t* buf,
+                                const uint64_t len,
+                                const uint64_t offset,
+                                extensions_box_t* box)
+{
+    return extensions_read_box_header(buf, len, offset, box) && box->length <= len - offset;
+}
+
+// Finds the first box of the given type among the sibling boxes in [begin, end).
+inline bool extensions_find_box(const uint8_t* buf,
+                                const uint64_t begin,
+                                const uint64_t end,
+                                const uint32_t type,
+                                extensions_box_t* box)
+{
+    auto offset = begin;
+    while (offset < end)
+    {
+        if (!extensions_read_box(buf, end, offset, box))
+            return false;
+        if (box->type == type)
+            return true;
+        offset += box->length;
+    }
+
+    return false;
+}
+
+// Parses the SIZ marker segment that must follow SOC at the head of a codestream.
+// truncated, when given, tells whether it failed only because the buffer ends inside the segment.
+inline bool extensions_read_siz(const uint8_t* buf,
+                                const uint64_t len,
+                                extensions_siz_t* siz,
+                                bool* truncated = nullptr)
+{
+    if (truncated != nullptr)
+        *truncated = false;
+
+    if (!extensions_is_j2k(buf, len))
+        return false;
+
+    if (len < 6)
+    {
+        if (truncated != nullptr)
+            *truncated = true;
+        return false;
+    }
+
+    const auto lsiz = extensions_read_uint16(buf + 4);
+    if (lsiz < 41)
+        return false;
+    if (len - 4 < lsiz)
+    {
+        if (truncated != nullptr)
+            *truncated = true;
+        return false;
+    }
+
+    const auto* p = buf + 6;
+    siz->rsiz = extensions_read_uint16(p);
+    siz->x1 = extensions_read_uint32(p + 2);
+    siz->y1 = extensions_read_uint32(p + 6);
+    siz->x0 = extensions_read_uint32(p + 10);
+    siz->y0 = extensions_read_uint32(p + 14);
+    siz->tdx = extensions_read_uint32(p + 18);
+    siz->tdy = extensions_read_uint32(p + 22);
+    siz->tx0 = extensions_read_uint32(p + 26);
+    siz->ty0 = extensions_read_uint32(p + 30);
+    siz->numcomps = extensions_read_uint16(p + 34);
+    siz->comps = p + 36;
+
+    if (siz->numcomps == 0 || lsiz != 38 + 3 * siz->numcomps)
+        return false;
+    if (siz->x0 >= siz->x1 || siz->y0 >= siz->y1 || siz->tdx == 0 || siz->tdy == 0)
+        return false;
+    if (siz->tx0 > siz->x0 || siz->ty0 > siz->y0)
+        return false;
+
+    for (uint32_t index = 0; index < siz->numcomps; index++)
+    {
+        if (siz->comps[index * 3 + 1] == 0 || siz->comps[index * 3 + 2] == 0)
+            return false;
+    }
+
+    return true;
+}
+
+inline uint8_t extensions_siz_get_ssiz(const extensions_siz_t* siz, const uint32_t compno)
+{
+    return siz->comps[compno * 3];
+}
+
+inline uint32_t extensions_siz_get_prec(const extensions_siz_t* siz, const uint32_t compno)
+{
+    return (siz->comps[compno * 3] & 0x7f) + 1;
+}
+
+inline bool extensions_siz_get_sgnd(const extensions_siz_t* siz, const uint32_t compno)
+{
+    return (siz->comps[compno * 3] & 0x80) != 0;
+}
+
+inline uint32_t extensions_siz_get_dx(const extensions_siz_t* siz, const uint32_t compno)
+{
+    return siz->comps[compno * 3 + 1];
+}
+
+inline uint32_t extensions_siz_get_dy(const extensions_siz_t* siz, const uint32_t compno)
+{
+    return siz->comps[compno * 3 + 2];
+}
+
+inline uint32_t extensions_siz_get_tw(const extensions_siz_t* siz)
+{
+    return (uint32_t)(((uint64_t)siz->x1 - siz->tx0 + siz->tdx - 1) / siz->tdx);
+}
+
+inline uint32_t extensions_siz_get_th(const extensions_siz_t* siz)
+{
+    return (uint32_t)(((uint64_t)siz->y1 - siz->ty0 + siz->tdy - 1) / siz->tdy);
+}
+
+// Walks the main header after SIZ and parses COD. Stops at the first SOT, which is returned in sot_offset.
+// A buffer that ends before the first tile-part is accepted as long as COD was seen, so callers may probe
+// just the first few kilobytes of a file; truncated, when given, tells that the buffer ended before SOT.
+inline bool extensions_read_main_header(const uint8_t* buf,
+                                        const uint64_t len,
+                                        extensions_cod_t* cod,
+                                        uint64_t* sot_offset,
+                                        bool* truncated = nullptr)
+{
+    auto has_cod = false;
+    *sot_offset = 0;
+    if (truncated != nullptr)
+        *truncated = true;
+
+    uint64_t offset = 4 + extensions_read_uint16(buf + 4);
+    while (offset + 4 <= len)
+    {
+        const auto marker = extensions_read_uint16(buf + offset);
+        if ((marker & 0xff00) != 0xff00)
+        {
+            if (truncated != nullptr)
+                *truncated = false;
+            return false;
+        }
+        if (marker == EXTENSIONS_J2K_MS_SOT)
+        {
+            *sot_offset = offset;
+            if (truncated != nullptr)
+                *truncated = false;
+            break;
+        }
+
+        const auto lmar = extensions_read_uint16(buf + offset + 2);
+        if (lmar < 2 || (marker == EXTENSIONS_J2K_MS_COD && lmar < 12))
+        {
+            if (truncated != nullptr)
+                *truncated = false;
+            return false;
+        }
+
+        if (marker == EXTENSIONS_J2K_MS_COD)
+        {
+            if (offset + 2 + lmar > len)
+                return false;
+
+            const auto* p = buf + offset + 4;
+            cod->scod = p[0];
+            cod->prog_order = p[1];
+            cod->numlayers = extensions_read_uint16(p + 2);
+            cod->mct = p[4];
+            cod->numresolutions = p[5] + 1;
+            cod->cblkw = p[6] + 2;
+            cod->cblkh = p[7] + 2;
+            cod->cblk_style = p[8];
+            cod->transform = p[9];
+            has_cod = true;
+        }
+
+        offset += 2 + lmar;
+    }
+
+    return has_cod;
+}
+
+typedef struct extensions_header_info
+{
+    int32_t format;
+    uint32_t x0;
+    uint32_t y0;
+    uint32_t x1;
+    uint32_t y1;
+    uint32_t tx0;
+    uint32_t ty0;
+    uint32_t tdx;
+    uint32_t tdy;
+    uint32_t tw;
+    uint32_t th;
+    uint32_t numcomps;
+    uint32_t numresolutions;
+    uint32_t numlayers;
+    int32_t prog_order;
+    uint32_t mct;
+    uint32_t cblkw;
+    uint32_t cblkh;
+    uint32_t irreversible;
+    uint32_t rsiz;
+    int32_t color_space;
+    uint32_t has_icc_profile;
+    uint32_t has_xml;
+    uint64_t codestream_offset;
+    uint64_t codestream_length;
+} extensions_header_info_t;
+
+typedef struct extensions_header_comp_info
+{
+    uint32_t dx;
+    uint32_t dy;
+    uint32_t prec;
+    uint32_t sgnd;
+} extensions_header_comp_info_t;
+
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/lib/openjp2/jp2.c#L1565
+inline OPJ_COLOR_SPACE extensions_header_get_color_space(const uint32_t enumcs)
+{
+    switch (enumcs)
+    {
+        case 16:
+            return OPJ_CLRSPC_SRGB;
+        case 17:
+            return OPJ_CLRSPC_GRAY;
+        case 18:
+            return OPJ_CLRSPC_SYCC;
+        case 24:
+            return OPJ_CLRSPC_EYCC;
+        case 12:
+            return OPJ_CLRSPC_CMYK;
+        default:
+            return OPJ_CLRSPC_UNKNOWN;
+    }
+}
+
+inline void extensions_header_read_jp2h(const uint8_t* buf,
+                                        const extensions_box_t* jp2h,
+                                        extensions_header_info_t* info)
+{
+    extensions_box_t box;
+    if (!extensions_find_box(buf, jp2h->offset + jp2h->header_length, jp2h->offset + jp2h->length, EXTENSIONS_JP2_COLR, &box))
+        return;
+    if (box.length - box.header_length < 3)
+        return;
+
+    const auto* p = buf + box.offset + box.header_length;
+    const auto meth = p[0];
+    if (meth == 1 && box.length - box.header_length >= 7)
+        info->color_space = extensions_header_get_color_space(extensions_read_uint32(p + 3));
+    else if (meth == 2 || meth == 3)
+        info->has_icc_profile = 1;
+}
+
+// comps_vector, when given, is resized to the components of the codestream and filled instead of comps.
+// truncated tells whether a failure is only due to the buffer ending before the main header does.
+inline bool extensions_header_read_codestream(const uint8_t* buf,
+                                              const uint64_t len,
+                                              extensions_header_info_t* info,
+                                              extensions_header_comp_info_t* comps,
+                                              uint32_t comps_len,
+                                              std::vector<extensions_header_comp_info_t>* comps_vector,
+                                              bool* truncated)
+{
+    extensions_siz_t siz;
+    if (!extensions_read_siz(buf, len, &siz, truncated))
+        return false;
+
+    if (comps_vector != nullptr)
+    {
+        comps_vector->resize(siz.numcomps);
+        comps = comps_vector->data();
+        comps_len = siz.numcomps;
+    }
+
+    extensions_cod_t cod;
+    uint64_t sot_offset;
+    if (!extensions_read_main_header(buf, len, &cod, &sot_offset, truncated))
+        return false;
+    *truncated = false;
+
+    info->x0 = siz.x0;
+    info->y0 = siz.y0;
+    info->x1 = siz.x1;
+    info->y1 = siz.y1;
+    info->tx0 = siz.tx0;
+    info->ty0 = siz.ty0;
+    info->tdx = siz.tdx;
+    info->tdy = siz.tdy;
+    info->tw = extensions_siz_get_tw(&siz);
+    info->th = extensions_siz_get_th(&siz);
+    info->numcomps = siz.numcomps;
+    info->rsiz = siz.rsiz;
+    info->numresolutions = cod.numresolutions;
+    info->numlayers = cod.numlayers;
+    info->prog_order = cod.prog_order <= OPJ_CPRL ? (int32_t)cod.prog_order : (int32_t)OPJ_PROG_UNKNOWN;
+    info->mct = cod.mct;
+    info->cblkw = 1u << cod.cblkw;
+    info->cblkh = 1u << cod.cblkh;
+    info->irreversible = cod.transform == 0 ? 1 : 0;
+
+    if (comps != nullptr)
+    {
+        const auto count = std::min(comps_len, (uint32_t)siz.numcomps);
+        for (uint32_t compno = 0; compno < count; compno++)
+        {
+            comps[compno].dx = extensions_siz_get_dx(&siz, compno);
+            comps[compno].dy = extensions_siz_get_dy(&siz, compno);
+            comps[compno].prec = extensions_siz_get_prec(&siz, compno);
+            comps[compno].sgnd = extensions_siz_get_sgnd(&siz, compno) ? 1 : 0;
+        }
+    }
+
+    return true;
+}
+
+// truncated tells whether a failure is only due to the buffer ending before the main header does, in which
+// case a longer head of the same file may still parse.
+inline int32_t extensions_header_read(const uint8_t* buf,
+                                      const uint64_t len,
+                                      extensions_header_info_t* info,
+                                      extensions_header_comp_info_t* comps,
+                                      const uint32_t comps_len,
+                                      std::vector<extensions_header_comp_info_t>* comps_vector,
+                                      bool* truncated)
+{
+    memset(info, 0, sizeof(extensions_header_info_t));
+    info->format = OPJ_CODEC_UNKNOWN;
+    info->prog_order = OPJ_PROG_UNKNOWN;
+    info->color_space = OPJ_CLRSPC_UNSPECIFIED;
+    *truncated = false;
+
+    if (buf == nullptr)
+        return ERR_IMAGE_FILE_INVALID;
+
+    if (extensions_is_j2k(buf, len))
+    {
+        info->format = OPJ_CODEC_J2K;
+        info->codestream_offset = 0;
+        info->codestream_length = len;
+        return extensions_header_read_codestream(buf, len, info, comps, comps_len, comps_vector, truncated) ? ERR_OK : ERR_IMAGE_FILE_INVALID;
+    }
+
+    if (!extensions_is_jp2(buf, len))
+    {
+        *truncated = len < EXTENSIONS_JP2_SIGNATURE_LENGTH;
+        return ERR_IMAGE_FILE_INVALID;
+    }
+
+    info->format = OPJ_CODEC_JP2;
+
+    auto has_codestream = false;
+    auto incomplete = false;
+    extensions_box_t box;
+    uint64_t offset = EXTENSIONS_JP2_SIGNATURE_LENGTH;
+    while (extensions_read_box_header(buf, len, offset, &box))
+    {
+        const auto complete = box.length <= len - offset;
+        switch (box.type)
+        {
+            case EXTENSIONS_JP2_JP2H:
+                if (!complete)
+                {
+                    *truncated = true;
+                    return ERR_IMAGE_FILE_INVALID;
+                }
+                extensions_header_read_jp2h(buf, &box, info);
+                break;
+            case EXTENSIONS_JP2_XML:
+                info->has_xml = 1;
+                break;
+            case EXTENSIONS_JP2_ASOC:
+                if (complete)
+                {
+                    extensions_box_t child;
+                    if (extensions_find_box(buf, box.offset + box.header_length, box.offset + box.length, EXTENSIONS_JP2_XML, &child))
+                        info->has_xml = 1;
+                }
+                break;
+            case EXTENSIONS_JP2_JP2C:
+                if (!has_codestream)
+                {
+                    const auto begin = box.offset + box.header_length;
+                    const auto end = std::min(len, box.offset + box.length);
+                    if (!extensions_header_read_codestream(buf + begin, end - begin, info, comps, comps_len, comps_vector, truncated))
+                    {
+                        // Running out of bytes only matters when the box runs on past the buffer
+                        *truncated = *truncated && end == len;
+                        return ERR_IMAGE_FILE_INVALID;
+                    }
+
+                    info->codestream_offset = begin;
+                    info->codestream_length = box.length - box.header_length;
+                    has_codestream = true;
+                }
+                break;
+        }
+
+        if (!complete)
+        {
+            incomplete = true;
+            break;
+        }
+        offset += box.length;
+    }
+
+    if (has_codestream)
+        return ERR_OK;
+
+    // Either a box runs on past the buffer or the buffer ends inside the header of the next one
+    const auto remaining = len - std::min(len, offset);
+    *truncated = incomplete || remaining < 8 || (remaining < 16 && extensions_read_uint32(buf + offset) == 1);
+    return ERR_IMAGE_FILE_INVALID;
+}
+
+// Parses the JP2 boxes and the codestream main header directly from memory without creating a codec.
+// The buffer may hold only the head of a file; the main header must be complete.
+inline int32_t extensions_read_header_info(const uint8_t* buf,
+                                           const uint64_t len,
+                                           extensions_header_info_t* info,
+                                           extensions_header_comp_info_t* comps,
+                                           const uint32_t comps_len)
+{
+    bool truncated;
+    return extensions_header_read(buf, len, info, comps, comps_len, nullptr, &truncated);
+}
+
+// Same as above, with comps resized to every component of the codestream
+inline int32_t extensions_read_header_info(const uint8_t* buf,
+                                           const uint64_t len,
+                                           extensions_header_info_t* info,
+                                           std::vector<extensions_header_comp_info_t>& comps)
+{
+    bool truncated;
+    return extensions_header_read(buf, len, info, nullptr, 0, &comps, &truncated);
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_CODESTREAM_H_
\ No newline at end of file
@@ -0,0 +1,1054 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_DECODE_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_DECODE_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.codestream.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Helpers to decode a codestream held in memory tile by tile through opj_read_tile_header and
+// opj_decode_tile_data, so that the caller owns every buffer the samples pass through.
+// They are shared by several extension modules and must stay inline because each module is
+// compiled as its own translation unit.
+
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/lib/openjp2/jp2.h
+#define EXTENSIONS_JP2_PCLR 0x70636c72
+#define EXTENSIONS_JP2_CDEF 0x63646566
+
+// Bands handed out per codec by extensions_decoder_decode_bands, so that a band of expensive tiles does not
+// leave the other codecs idle at the end
+#define EXTENSIONS_DECODE_BANDS_PER_DECODER 4
+
+// Lets another thread abort a decode, or bounds it by a deadline. It is checked whenever the codec reads
+// from the stream and between tiles, so a decode stops at the latest after the tile in progress.
+typedef struct extensions_cancel_token
+{
+    std::atomic<bool> cancelled;
+    bool has_deadline;
+    std::chrono::steady_clock::time_point deadline;
+} extensions_cancel_token_t;
+
+inline int32_t extensions_cancel_token_check(const extensions_cancel_token_t* token)
+{
+    if (token == nullptr)
+        return ERR_OK;
+    if (token->cancelled)
+        return ERR_GENERAL_CANCELLED;
+    if (token->has_deadline && std::chrono::steady_clock::now() >= token->deadline)
+        return ERR_GENERAL_DEADLINE_EXCEEDED;
+    return ERR_OK;
+}
+
+typedef struct extensions_memory_stream
+{
+    const uint8_t* data;
+    uint64_t length;
+    uint64_t position;
+    const extensions_cancel_token_t* token;
+} extensions_memory_stream_t;
+
+inline OPJ_SIZE_T extensions_memory_stream_read(void* p_buffer, OPJ_SIZE_T p_nb_bytes, void* p_user_data)
+{
+    auto stream = (extensions_memory_stream_t*)p_user_data;
+    if (stream->position >= stream->length)
+        return (OPJ_SIZE_T)-1;
+    if (extensions_cancel_token_check(stream->token) != ERR_OK)
+        return (OPJ_SIZE_T)-1;
+
+    const auto size = (OPJ_SIZE_T)std::min<uint64_t>(p_nb_bytes, stream->length - stream->position);
+    memcpy(p_buffer, stream->data + stream->position, size);
+    stream->position += size;
+    return size;
+}
+
+inline OPJ_OFF_T extensions_memory_stream_skip(OPJ_OFF_T p_nb_bytes, void* p_user_data)
+{
+    auto stream = (extensions_memory_stream_t*)p_user_data;
+    if (p_nb_bytes < 0 || extensions_cancel_token_check(stream->token) != ERR_OK)
+        return -1;
+
+    const auto size = std::min<uint64_t>((uint64_t)p_nb_bytes, stream->length - stream->position);
+    stream->position += size;
+    return (OPJ_OFF_T)size;
+}
+
+inline OPJ_BOOL extensions_memory_stream_seek(OPJ_OFF_T p_nb_bytes, void* p_user_data)
+{
+    auto stream = (extensions_memory_stream_t*)p_user_data;
+    if (p_nb_bytes < 0 || (uint64_t)p_nb_bytes > stream->length)
+        return OPJ_FALSE;
+
+    stream->position = (uint64_t)p_nb_bytes;
+    return OPJ_TRUE;
+}
+
+// The stream does not own the memory stream state, which must outlive it
+inline opj_stream_t* extensions_memory_stream_create(extensions_memory_stream_t* stream)
+{
+    auto p_stream = ::opj_stream_create(OPJ_J2K_STREAM_CHUNK_SIZE, OPJ_TRUE);
+    if (p_stream == nullptr)
+        return nullptr;
+
+    ::opj_stream_set_read_function(p_stream, extensions_memory_stream_read);
+    ::opj_stream_set_skip_function(p_stream, extensions_memory_stream_skip);
+    ::opj_stream_set_seek_function(p_stream, extensions_memory_stream_seek);
+    ::opj_stream_set_user_data(p_stream, stream, nullptr);
+    ::opj_stream_set_user_data_length(p_stream, stream->length);
+    return p_stream;
+}
+
+// An immutable codestream held once and read through any number of streams, each with its own position,
+// so that codecs on different threads can decode from it at the same time. The bytes are released by
+// dispose when the last reference goes.
+typedef struct extensions_source extensions_source_t;
+
+struct extensions_source
+{
+    std::atomic<int32_t> references;
+    const uint8_t* data;
+    uint64_t length;
+    void (*dispose)(extensions_source_t* source);
+};
+
+inline void extensions_source_retain(extensions_source_t* source)
+{
+    source->references++;
+}
+
+inline void extensions_source_release(extensions_source_t* source)
+{
+    if (--source->references == 0)
+    {
+        source->dispose(source);
+        delete source;
+    }
+}
+
+// A position over a source. The memory stream must stay the first member because the stream callbacks
+// receive the cursor as their user data.
+typedef struct extensions_source_cursor
+{
+    extensions_memory_stream_t stream;
+    extensions_source_t* source;
+} extensions_source_cursor_t;
+
+inline void extensions_source_cursor_free(void* p_user_data)
+{
+    auto cursor = (extensions_source_cursor_t*)p_user_data;
+    extensions_source_release(cursor->source);
+    delete cursor;
+}
+
+// The stream holds a reference on the source until opj_stream_destroy, so the caller may release its own
+// reference as soon as the stream is created. The token is optional.
+inline opj_stream_t* extensions_source_create_stream(extensions_source_t* source, const extensions_cancel_token_t* token)
+{
+    auto cursor = new extensions_source_cursor_t();
+    cursor->stream.data = source->data;
+    cursor->stream.length = source->length;
+    cursor->stream.position = 0;
+    cursor->stream.token = token;
+    cursor->source = source;
+
+    auto p_stream = extensions_memory_stream_create(&cursor->stream);
+    if (p_stream == nullptr)
+    {
+        delete cursor;
+        return nullptr;
+    }
+
+    extensions_source_retain(source);
+    ::opj_stream_set_user_data(p_stream, cursor, extensions_source_cursor_free);
+    return p_stream;
+}
+
+// Recycles opj_image_t objects together with their component planes so that repeated encodes or decodes
+// of the same shape do not go back to the allocator. Planes come from opj_image_data_alloc and are aligned.
+// Decoders and sequences holding the pool keep a reference on it, so it is deleted with the last one.
+typedef struct extensions_image_pool
+{
+    std::atomic<int32_t> references;
+    std::mutex mutex;
+    std::map<std::vector<uint32_t>, std::vector<opj_image_t*>> images;
+    uint64_t max_bytes;
+    uint64_t pooled_bytes;
+    uint64_t pooled_images;
+    uint64_t hits;
+    uint64_t misses;
+} extensions_image_pool_t;
+
+inline std::vector<uint32_t> extensions_image_pool_get_key(const uint32_t numcmpts,
+                                                           const opj_image_cmptparm_t* cmptparms)
+{
+    std::vector<uint32_t> key;
+    key.reserve(1 + numcmpts * 6);
+    key.push_back(numcmpts);
+    for (uint32_t compno = 0; compno < numcmpts; compno++)
+    {
+        key.push_back(cmptparms[compno].w);
+        key.push_back(cmptparms[compno].h);
+        key.push_back(cmptparms[compno].dx);
+        key.push_back(cmptparms[compno].dy);
+        key.push_back(cmptparms[compno].prec);
+        key.push_back(cmptparms[compno].sgnd);
+    }
+
+    return key;
+}
+
+inline std::vector<uint32_t> extensions_image_pool_get_key(const opj_image_t* image)
+{
+    std::vector<uint32_t> key;
+    key.reserve(1 + image->numcomps * 6);
+    key.push_back(image->numcomps);
+    for (uint32_t compno = 0; compno < image->numcomps; compno++)
+    {
+        const auto& comp = image->comps[compno];
+        key.push_back(comp.w);
+        key.push_back(comp.h);
+        key.push_back(comp.dx);
+        key.push_back(comp.dy);
+        key.push_back(comp.prec);
+        key.push_back(comp.sgnd);
+    }
+
+    return key;
+}
+
+inline uint64_t extensions_image_pool_get_size(const opj_image_t* image)
+{
+    uint64_t size = 0;
+    for (uint32_t compno = 0; compno < image->numcomps; compno++)
+        size += (uint64_t)image->comps[compno].w * image->comps[compno].h * sizeof(OPJ_INT32);
+    return size;
+}
+
+inline void extensions_image_pool_trim(extensions_image_pool_t* pool)
+{
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    for (auto& entry : pool->images)
+        for (auto image : entry.second)
+            ::opj_image_destroy(image);
+
+    pool->images.clear();
+    pool->pooled_bytes = 0;
+    pool->pooled_images = 0;
+}
+
+inline void extensions_image_pool_retain(extensions_image_pool_t* pool)
+{
+    pool->references++;
+}
+
+// Drops a reference and deletes the pool, with every pooled image, when it was the last one
+inline void extensions_image_pool_drop(extensions_image_pool_t* pool)
+{
+    if (--pool->references == 0)
+    {
+        extensions_image_pool_trim(pool);
+        delete pool;
+    }
+}
+
+// Same as opj_image_create, but a pooled image of the same shape is reused when available. The planes of a
+// reused image are not cleared. A null pool always creates a new image.
+inline opj_image_t* extensions_image_pool_create(extensions_image_pool_t* pool,
+                                                 const uint32_t numcmpts,
+                                                 opj_image_cmptparm_t* cmptparms,
+                                                 const OPJ_COLOR_SPACE clrspc)
+{
+    if (pool == nullptr)
+        return ::opj_image_create(numcmpts, cmptparms, clrspc);
+
+    const auto key = extensions_image_pool_get_key(numcmpts, cmptparms);
+    opj_image_t* image = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        const auto it = pool->images.find(key);
+        if (it != pool->images.end() && !it->second.empty())
+        {
+            image = it->second.back();
+            it->second.pop_back();
+            pool->pooled_bytes -= extensions_image_pool_get_size(image);
+            pool->pooled_images--;
+            pool->hits++;
+        }
+        else
+        {
+            pool->misses++;
+        }
+    }
+
+    if (image == nullptr)
+        return ::opj_image_create(numcmpts, cmptparms, clrspc);
+
+    // Restore everything opj_image_create would have initialised except the planes themselves
+    image->x0 = 0;
+    image->y0 = 0;
+    image->x1 = 0;
+    image->y1 = 0;
+    image->color_space = clrspc;
+    for (uint32_t compno = 0; compno < numcmpts; compno++)
+    {
+        auto& comp = image->comps[compno];
+        comp.x0 = cmptparms[compno].x0;
+        comp.y0 = cmptparms[compno].y0;
+        comp.bpp = cmptparms[compno].bpp;
+        comp.factor = 0;
+        comp.resno_decoded = 0;
+        comp.alpha = 0;
+    }
+
+    return image;
+}
+
+// ICC profiles are allocated and released with malloc and free, which are what opj_malloc and opj_free come down
+// to in the static openjp2 linked here, so an image from opj_decode and one from this file are treated alike
+inline bool extensions_image_copy_icc_profile(opj_image_t* image, const opj_image_t* header)
+{
+    if (header->icc_profile_len == 0)
+        return true;
+
+    image->icc_profile_buf = (OPJ_BYTE*)malloc(header->icc_profile_len);
+    if (image->icc_profile_buf == nullptr)
+        return false;
+
+    memcpy(image->icc_profile_buf, header->icc_profile_buf, header->icc_profile_len);
+    image->icc_profile_len = header->icc_profile_len;
+    return true;
+}
+
+inline void extensions_image_free_icc_profile(opj_image_t* image)
+{
+    free(image->icc_profile_buf);
+    image->icc_profile_buf = nullptr;
+    image->icc_profile_len = 0;
+}
+
+// Hands an image back to the pool so that its planes are recycled, or destroys it when the pool is null or
+// full. Any opj_image_t may be recycled, including one produced by opj_decode.
+inline void extensions_image_pool_recycle(extensions_image_pool_t* pool, opj_image_t* image)
+{
+    if (image == nullptr)
+        return;
+
+    auto poolable = pool != nullptr && image->numcomps != 0 && image->comps != nullptr;
+    for (uint32_t compno = 0; poolable && compno < image->numcomps; compno++)
+        poolable = image->comps[compno].data != nullptr;
+
+    if (poolable)
+    {
+        extensions_image_free_icc_profile(image);
+        const auto size = extensions_image_pool_get_size(image);
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        if (pool->pooled_bytes + size <= pool->max_bytes)
+        {
+            pool->images[extensions_image_pool_get_key(image)].push_back(image);
+            pool->pooled_bytes += size;
+            pool->pooled_images++;
+            return;
+        }
+    }
+
+    ::opj_image_destroy(image);
+}
+
+inline uint32_t extensions_ceildiv(const uint32_t a, const uint32_t b)
+{
+    return (uint32_t)(((uint64_t)a + b - 1) / b);
+}
+
+inline uint32_t extensions_ceildivpow2(const uint32_t a, const uint32_t b)
+{
+    return (uint32_t)(((uint64_t)a + ((uint64_t)1 << b) - 1) >> b);
+}
+
+// Zero area means the whole image. The token is optional.
+typedef struct extensions_decode_options
+{
+    uint32_t reduce;
+    uint32_t layers;
+    int32_t x0;
+    int32_t y0;
+    int32_t x1;
+    int32_t y1;
+    int32_t num_threads;
+    const extensions_cancel_token_t* token;
+} extensions_decode_options_t;
+
+// A component of the decoded output: compno is the component of the codestream it comes from and alpha its
+// type in the channel definition of a JP2 file
+typedef struct extensions_decoder_channel
+{
+    uint32_t compno;
+    uint16_t alpha;
+} extensions_decoder_channel_t;
+
+// The stream points at source, so a decoder must not be moved or copied while it is open.
+// x0, y0, x1 and y1 are the output area on the reference grid. The header holds the area the codec decodes,
+// which is the output area widened to whole tiles, and its components stay in codestream order; channels
+// gives the order of the output components.
+typedef struct extensions_decoder
+{
+    extensions_memory_stream_t source;
+    opj_codec_t* codec;
+    opj_stream_t* stream;
+    opj_image_t* header;
+    uint32_t reduce;
+    uint32_t layers;
+    uint32_t x0;
+    uint32_t y0;
+    uint32_t x1;
+    uint32_t y1;
+    std::vector<extensions_decoder_channel_t> channels;
+} extensions_decoder_t;
+
+// Geometry of a component of the decoded output, in reduced component coordinates
+typedef struct extensions_comp_rect
+{
+    uint32_t x0;
+    uint32_t y0;
+    uint32_t w;
+    uint32_t h;
+} extensions_comp_rect_t;
+
+// One component of a decoded tile, cropped to the output area. x0 and y0 are relative to the top left corner
+// of the output component; rows of data are stride samples apart because the codec hands out whole tiles.
+typedef struct extensions_tile_comp
+{
+    uint32_t x0;
+    uint32_t y0;
+    uint32_t w;
+    uint32_t h;
+    uint32_t stride;
+    uint32_t sample_size;
+    uint32_t sgnd;
+    const uint8_t* data;
+} extensions_tile_comp_t;
+
+typedef struct extensions_tile
+{
+    uint32_t index;
+    int32_t x0;
+    int32_t y0;
+    int32_t x1;
+    int32_t y1;
+    std::vector<extensions_tile_comp_t> comps;
+} extensions_tile_t;
+
+inline void extensions_decoder_close(extensions_decoder_t* decoder)
+{
+    if (decoder->header != nullptr)
+        ::opj_image_destroy(decoder->header);
+    if (decoder->stream != nullptr)
+        ::opj_stream_destroy(decoder->stream);
+    if (decoder->codec != nullptr)
+        ::opj_destroy_codec(decoder->codec);
+
+    decoder->header = nullptr;
+    decoder->stream = nullptr;
+    decoder->codec = nullptr;
+}
+
+// Palettes are only applied by opj_decode, so the tile path would hand out palette indices
+inline bool extensions_decoder_has_palette(const uint8_t* data, const uint64_t length)
+{
+    extensions_box_t jp2h;
+    if (!extensions_find_box(data, EXTENSIONS_JP2_SIGNATURE_LENGTH, length, EXTENSIONS_JP2_JP2H, &jp2h))
+        return false;
+
+    extensions_box_t pclr;
+    return extensions_find_box(data, jp2h.offset + jp2h.header_length, jp2h.offset + jp2h.length, EXTENSIONS_JP2_PCLR, &pclr);
+}
+
+// The codec applies the channel definition in opj_decode only, and only the first time, so it is told to
+// ignore it and every path applies it itself through channels.
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/lib/openjp2/jp2.c (opj_jp2_apply_cdef)
+inline void extensions_decoder_read_channels(const uint8_t* data,
+                                             const uint64_t length,
+                                             const uint32_t numcomps,
+                                             std::vector<extensions_decoder_channel_t>& channels)
+{
+    channels.resize(numcomps);
+    for (uint32_t compno = 0; compno < numcomps; compno++)
+    {
+        channels[compno].compno = compno;
+        channels[compno].alpha = 0;
+    }
+
+    extensions_box_t jp2h;
+    if (!extensions_is_jp2(data, length) ||
+        !extensions_find_box(data, EXTENSIONS_JP2_SIGNATURE_LENGTH, length, EXTENSIONS_JP2_JP2H, &jp2h))
+        return;
+
+    extensions_box_t cdef;
+    if (!extensions_find_box(data, jp2h.offset + jp2h.header_length, jp2h.offset + jp2h.length, EXTENSIONS_JP2_CDEF, &cdef) ||
+        cdef.length - cdef.header_length < 2)
+        return;
+
+    const auto p = data + cdef.offset + cdef.header_length;
+    const auto n = std::min<uint64_t>(extensions_read_uint16(p), (cdef.length - cdef.header_length - 2) / 6);
+
+    std::vector<uint16_t> cns(n);
+    for (uint64_t i = 0; i < n; i++)
+        cns[i] = extensions_read_uint16(p + 2 + i * 6);
+
+    for (uint64_t i = 0; i < n; i++)
+    {
+        const auto cn = cns[i];
+        const auto typ = extensions_read_uint16(p + 2 + i * 6 + 2);
+        const auto asoc = extensions_read_uint16(p + 2 + i * 6 + 4);
+        if (cn >= numcomps)
+            continue;
+        if (asoc == 0 || asoc == 65535)
+        {
+            channels[cn].alpha = typ;
+            continue;
+        }
+
+        const auto acn = (uint16_t)(asoc - 1);
+        if (acn >= numcomps)
+            continue;
+
+        // Only color channels are moved to their association, and the later definitions follow them
+        if (cn != acn && typ == 0)
+        {
+            std::swap(channels[cn], channels[acn]);
+            for (auto j = i + 1; j < n; j++)
+            {
+                if (cns[j] == cn)
+                    cns[j] = acn;
+                else if (cns[j] == acn)
+                    cns[j] = cn;
+            }
+        }
+
+        channels[cn].alpha = typ;
+    }
+}
+
+// opj_read_tile_header reports the size of the whole tile, but opj_decode_tile_data writes only the part inside
+// the decode area when the area cuts through the tile. The codec is therefore given the output area widened to
+// the tile grid, so that every tile comes out whole, and extensions_decoder_decode_tiles crops them.
+inline int32_t extensions_decoder_align_area(extensions_decoder_t* decoder)
+{
+    extensions_header_info_t info;
+    const auto ret = extensions_read_header_info(decoder->source.data, decoder->source.length, &info, nullptr, 0);
+    if (ret != ERR_OK)
+        return ret;
+    if (info.tdx == 0 || info.tdy == 0)
+        return ERR_IMAGE_FILE_INVALID;
+
+    // https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/lib/openjp2/j2k.c (opj_j2k_set_decode_area)
+    const auto x0 = std::max<uint64_t>(info.x0, info.tx0 + (uint64_t)((decoder->x0 - info.tx0) / info.tdx) * info.tdx);
+    const auto y0 = std::max<uint64_t>(info.y0, info.ty0 + (uint64_t)((decoder->y0 - info.ty0) / info.tdy) * info.tdy);
+    const auto x1 = std::min<uint64_t>(info.x1, info.tx0 + (uint64_t)extensions_ceildiv(decoder->x1 - info.tx0, info.tdx) * info.tdx);
+    const auto y1 = std::min<uint64_t>(info.y1, info.ty0 + (uint64_t)extensions_ceildiv(decoder->y1 - info.ty0, info.tdy) * info.tdy);
+    if (x0 == decoder->x0 && y0 == decoder->y0 && x1 == decoder->x1 && y1 == decoder->y1)
+        return ERR_OK;
+
+    if (!::opj_set_decode_area(decoder->codec, decoder->header, (OPJ_INT32)x0, (OPJ_INT32)y0, (OPJ_INT32)x1, (OPJ_INT32)y1))
+        return ERR_GENERAL_OUT_OF_RANGE;
+    return ERR_OK;
+}
+
+// The memory must stay valid until the decoder is closed
+inline int32_t extensions_decoder_open(extensions_decoder_t* decoder,
+                                       const uint8_t* data,
+                                       const uint64_t length,
+                                       const extensions_decode_options_t* options)
+{
+    decoder->source.data = data;
+    decoder->source.length = length;
+    decoder->source.position = 0;
+    decoder->source.token = options->token;
+    decoder->codec = nullptr;
+    decoder->stream = nullptr;
+    decoder->header = nullptr;
+    decoder->reduce = options->reduce;
+    decoder->layers = options->layers;
+
+    OPJ_CODEC_FORMAT format;
+    if (extensions_is_jp2(data, length))
+    {
+        if (extensions_decoder_has_palette(data, length))
+            return ERR_IMAGE_FILE_INVALID;
+        format = OPJ_CODEC_JP2;
+    }
+    else if (extensions_is_j2k(data, length))
+    {
+        format = OPJ_CODEC_J2K;
+    }
+    else
+    {
+        return ERR_IMAGE_FILE_INVALID;
+    }
+
+    opj_dparameters_t parameters;
+    ::opj_set_default_decoder_parameters(&parameters);
+    parameters.cp_reduce = options->reduce;
+    parameters.cp_layer = options->layers;
+    parameters.flags |= OPJ_DPARAMETERS_IGNORE_PCLR_CMAP_CDEF_FLAG;
+
+    decoder->codec = ::opj_create_decompress(format);
+    if (decoder->codec == nullptr)
+        return ERR_GENERAL_MEMALLOC;
+
+    if (!::opj_setup_decoder(decoder->codec, &parameters))
+    {
+        extensions_decoder_close(decoder);
+        return ERR_IMAGE_FILE_INVALID;
+    }
+
+    if (options->num_threads > 1)
+        ::opj_codec_set_threads(decoder->codec, options->num_threads);
+
+    decoder->stream = extensions_memory_stream_create(&decoder->source);
+    if (decoder->stream == nullptr)
+    {
+        extensions_decoder_close(decoder);
+        return ERR_GENERAL_MEMALLOC;
+    }
+
+    if (!::opj_read_header(decoder->stream, decoder->codec, &decoder->header))
+    {
+        extensions_decoder_close(decoder);
+        const auto ret = extensions_cancel_token_check(options->token);
+        return ret != ERR_OK ? ret : ERR_IMAGE_FILE_INVALID;
+    }
+
+    const auto has_area = options->x0 != 0 || options->y0 != 0 || options->x1 != 0 || options->y1 != 0;
+    if (has_area && !::opj_set_decode_area(decoder->codec, decoder->header, options->x0, options->y0, options->x1, options->y1))
+    {
+        extensions_decoder_close(decoder);
+        return ERR_GENERAL_OUT_OF_RANGE;
+    }
+
+    extensions_decoder_read_channels(data, length, decoder->header->numcomps, decoder->channels);
+
+    // opj_set_decode_area has clamped the area to the image
+    decoder->x0 = decoder->header->x0;
+    decoder->y0 = decoder->header->y0;
+    decoder->x1 = decoder->header->x1;
+    decoder->y1 = decoder->header->y1;
+
+    if (has_area)
+    {
+        const auto ret = extensions_decoder_align_area(decoder);
+        if (ret != ERR_OK)
+        {
+            extensions_decoder_close(decoder);
+            return ret;
+        }
+    }
+
+    return ERR_OK;
+}
+
+// Component compno of the output, in the header
+inline const opj_image_comp_t& extensions_decoder_get_comp(const extensions_decoder_t* decoder, const uint32_t compno)
+{
+    return decoder->header->comps[decoder->channels[compno].compno];
+}
+
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/lib/openjp2/j2k.c (opj_j2k_update_image_dimensions)
+inline extensions_comp_rect_t extensions_decoder_get_comp_rect(const extensions_decoder_t* decoder, const uint32_t compno)
+{
+    const auto& comp = extensions_decoder_get_comp(decoder, compno);
+
+    extensions_comp_rect_t rect;
+    rect.x0 = extensions_ceildivpow2(extensions_ceildiv(decoder->x0, comp.dx), decoder->reduce);
+    rect.y0 = extensions_ceildivpow2(extensions_ceildiv(decoder->y0, comp.dy), decoder->reduce);
+    rect.w = extensions_ceildivpow2(extensions_ceildiv(decoder->x1, comp.dx), decoder->reduce) - rect.x0;
+    rect.h = extensions_ceildivpow2(extensions_ceildiv(decoder->y1, comp.dy), decoder->reduce) - rect.y0;
+    return rect;
+}
+
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/lib/openjp2/tcd.c (opj_tcd_update_tile_data)
+inline uint32_t extensions_decoder_get_sample_size(const uint32_t prec)
+{
+    auto size = (prec + 7) >> 3;
+    return size == 3 ? 4 : size;
+}
+
+// Allocates an image shaped like the decoded output of the decoder, from pool when it is not null
+inline opj_image_t* extensions_decoder_create_image(const extensions_decoder_t* decoder, extensions_image_pool_t* pool = nullptr)
+{
+    const auto header = decoder->header;
+    std::vector<opj_image_cmptparm_t> cmptparms(header->numcomps);
+    for (uint32_t compno = 0; compno < header->numcomps; compno++)
+    {
+        const auto& comp = extensions_decoder_get_comp(decoder, compno);
+        const auto rect = extensions_decoder_get_comp_rect(decoder, compno);
+        auto& cmptparm = cmptparms[compno];
+        memset(&cmptparm, 0, sizeof(opj_image_cmptparm_t));
+        cmptparm.dx = comp.dx;
+        cmptparm.dy = comp.dy;
+        cmptparm.w = rect.w;
+        cmptparm.h = rect.h;
+        cmptparm.x0 = rect.x0;
+        cmptparm.y0 = rect.y0;
+        cmptparm.prec = comp.prec;
+        cmptparm.sgnd = comp.sgnd;
+    }
+
+    auto image = extensions_image_pool_create(pool, header->numcomps, cmptparms.data(), header->color_space);
+    if (image == nullptr)
+        return nullptr;
+
+    image->x0 = decoder->x0;
+    image->y0 = decoder->y0;
+    image->x1 = decoder->x1;
+    image->y1 = decoder->y1;
+    for (uint32_t compno = 0; compno < header->numcomps; compno++)
+    {
+        image->comps[compno].factor = decoder->reduce;
+        image->comps[compno].alpha = decoder->channels[compno].alpha;
+    }
+
+    return image;
+}
+
+// Whether an image created for a previous codestream can receive the output of this decoder
+inline bool extensions_decoder_image_matches(const extensions_decoder_t* decoder, const opj_image_t* image)
+{
+    const auto header = decoder->header;
+    if (image == nullptr || image->numcomps != header->numcomps)
+        return false;
+
+    for (uint32_t compno = 0; compno < header->numcomps; compno++)
+    {
+        const auto& source = extensions_decoder_get_comp(decoder, compno);
+        const auto rect = extensions_decoder_get_comp_rect(decoder, compno);
+        const auto& comp = image->comps[compno];
+        if (comp.w != rect.w || comp.h != rect.h || comp.x0 != rect.x0 || comp.y0 != rect.y0 ||
+            comp.dx != source.dx || comp.dy != source.dy || comp.prec != source.prec || comp.sgnd != source.sgnd ||
+            comp.alpha != decoder->channels[compno].alpha)
+            return false;
+    }
+
+    return true;
+}
+
+// Decodes every tile intersecting the decode area into buffer, which is grown as needed and can be
+// reused across calls, and hands each one to callback(const extensions_tile_t&) before the next tile
+// is read. A callback returning anything but ERR_OK stops decoding and its value is returned.
+// A cancelled or expired token stops decoding with its own error code.
+template<typename Callback>
+inline int32_t extensions_decoder_decode_tiles(extensions_decoder_t* decoder, std::vector<uint8_t>& buffer, Callback callback)
+{
+    const auto header = decoder->header;
+
+    extensions_tile_t tile;
+    tile.comps.resize(header->numcomps);
+
+    // The buffer holds the components in codestream order; tile.comps is in output order
+    std::vector<const uint8_t*> planes(header->numcomps);
+
+    const auto token = decoder->source.token;
+    const auto failed = [token]
+    {
+        const auto ret = extensions_cancel_token_check(token);
+        return ret != ERR_OK ? ret : ERR_IMAGE_DECODE_FAILED;
+    };
+
+    OPJ_BOOL go_on = OPJ_TRUE;
+    while (go_on)
+    {
+        const auto cancelled = extensions_cancel_token_check(token);
+        if (cancelled != ERR_OK)
+            return cancelled;
+
+        OPJ_UINT32 tile_index;
+        OPJ_UINT32 data_size;
+        OPJ_INT32 tile_x0, tile_y0, tile_x1, tile_y1;
+        OPJ_UINT32 numcomps;
+        if (!::opj_read_tile_header(decoder->codec, decoder->stream, &tile_index, &data_size,
+                                    &tile_x0, &tile_y0, &tile_x1, &tile_y1, &numcomps, &go_on))
+            return failed();
+        if (!go_on)
+            break;
+        if (numcomps != header->numcomps)
+            return ERR_IMAGE_DECODE_FAILED;
+
+        if (buffer.size() < data_size)
+            buffer.resize(data_size);
+        if (!::opj_decode_tile_data(decoder->codec, tile_index, buffer.data(), data_size, decoder->stream))
+            return failed();
+
+        tile.index = tile_index;
+        tile.x0 = tile_x0;
+        tile.y0 = tile_y0;
+        tile.x1 = tile_x1;
+        tile.y1 = tile_y1;
+
+        uint64_t offset = 0;
+        for (uint32_t compno = 0; compno < numcomps; compno++)
+        {
+            const auto& comp = header->comps[compno];
+            const auto tx0 = extensions_ceildivpow2(extensions_ceildiv((uint32_t)tile_x0, comp.dx), decoder->reduce);
+            const auto ty0 = extensions_ceildivpow2(extensions_ceildiv((uint32_t)tile_y0, comp.dy), decoder->reduce);
+            const auto tx1 = extensions_ceildivpow2(extensions_ceildiv((uint32_t)tile_x1, comp.dx), decoder->reduce);
+            const auto ty1 = extensions_ceildivpow2(extensions_ceildiv((uint32_t)tile_y1, comp.dy), decoder->reduce);
+            planes[compno] = buffer.data() + offset;
+            offset += (uint64_t)(tx1 > tx0 ? tx1 - tx0 : 0) * (ty1 > ty0 ? ty1 - ty0 : 0) * extensions_decoder_get_sample_size(comp.prec);
+        }
+
+        if (offset != data_size)
+            return ERR_IMAGE_DECODE_FAILED;
+
+        // Every tile is decoded whole, see extensions_decoder_align_area, and its components are cropped to
+        // the output area
+        for (uint32_t compno = 0; compno < numcomps; compno++)
+        {
+            const auto& comp = extensions_decoder_get_comp(decoder, compno);
+            const auto rect = extensions_decoder_get_comp_rect(decoder, compno);
+            const auto tx0 = extensions_ceildivpow2(extensions_ceildiv((uint32_t)tile_x0, comp.dx), decoder->reduce);
+            const auto ty0 = extensions_ceildivpow2(extensions_ceildiv((uint32_t)tile_y0, comp.dy), decoder->reduce);
+            const auto tx1 = extensions_ceildivpow2(extensions_ceildiv((uint32_t)tile_x1, comp.dx), decoder->reduce);
+            const auto ty1 = extensions_ceildivpow2(extensions_ceildiv((uint32_t)tile_y1, comp.dy), decoder->reduce);
+            const auto cx0 = std::max(tx0, rect.x0);
+            const auto cy0 = std::max(ty0, rect.y0);
+            const auto cx1 = std::min(tx1, rect.x0 + rect.w);
+            const auto cy1 = std::min(ty1, rect.y0 + rect.h);
+
+            auto& tile_comp = tile.comps[compno];
+            tile_comp.x0 = cx0 - rect.x0;
+            tile_comp.y0 = cy0 - rect.y0;
+            tile_comp.w = cx1 > cx0 ? cx1 - cx0 : 0;
+            tile_comp.h = cy1 > cy0 ? cy1 - cy0 : 0;
+            tile_comp.stride = tx1 > tx0 ? tx1 - tx0 : 0;
+            tile_comp.sample_size = extensions_decoder_get_sample_size(comp.prec);
+            tile_comp.sgnd = comp.sgnd;
+            tile_comp.data = planes[decoder->channels[compno].compno];
+            if (tile_comp.w != 0 && tile_comp.h != 0)
+                tile_comp.data += ((uint64_t)(cy0 - ty0) * tile_comp.stride + (cx0 - tx0)) * tile_comp.sample_size;
+        }
+
+        const auto ret = callback(tile);
+        if (ret != ERR_OK)
+            return ret;
+    }
+
+    if (!::opj_end_decompress(decoder->codec, decoder->stream))
+        return failed();
+
+    return ERR_OK;
+}
+
+inline int32_t extensions_tile_comp_get_sample(const extensions_tile_comp_t& comp, const uint32_t x, const uint32_t y)
+{
+    const auto index = (uint64_t)y * comp.stride + x;
+    switch (comp.sample_size)
+    {
+        case 1:
+            return comp.sgnd ? (int32_t)((const int8_t*)comp.data)[index] : (int32_t)comp.data[index];
+        case 2:
+            return comp.sgnd ? (int32_t)((const int16_t*)comp.data)[index] : (int32_t)((const uint16_t*)comp.data)[index];
+        default:
+            return ((const int32_t*)comp.data)[index];
+    }
+}
+
+// Widens a decoded tile into the int32 planes of an image created by extensions_decoder_create_image
+inline void extensions_tile_copy_to_image(const extensions_tile_t& tile, opj_image_t* image)
+{
+    for (uint32_t compno = 0; compno < image->numcomps; compno++)
+    {
+        const auto& tile_comp = tile.comps[compno];
+        const auto& comp = image->comps[compno];
+        for (uint32_t y = 0; y < tile_comp.h; y++)
+        {
+            auto dst = comp.data + (uint64_t)(tile_comp.y0 + y) * comp.w + tile_comp.x0;
+            const uint64_t src = (uint64_t)y * tile_comp.stride;
+            switch (tile_comp.sample_size)
+            {
+                case 1:
+                    if (tile_comp.sgnd)
+                        for (uint32_t x = 0; x < tile_comp.w; x++) dst[x] = ((const int8_t*)tile_comp.data)[src + x];
+                    else
+                        for (uint32_t x = 0; x < tile_comp.w; x++) dst[x] = tile_comp.data[src + x];
+                    break;
+                case 2:
+                    if (tile_comp.sgnd)
+                        for (uint32_t x = 0; x < tile_comp.w; x++) dst[x] = ((const int16_t*)tile_comp.data)[src + x];
+                    else
+                        for (uint32_t x = 0; x < tile_comp.w; x++) dst[x] = ((const uint16_t*)tile_comp.data)[src + x];
+                    break;
+                default:
+                    memcpy(dst, (const int32_t*)tile_comp.data + src, tile_comp.w * sizeof(int32_t));
+                    break;
+            }
+        }
+    }
+}
+
+// Decodes a whole codestream or JP2 file held in memory into a new image, tile by tile. The image is taken
+// from pool when it is not null.
+inline int32_t extensions_decode_image(const uint8_t* data,
+                                       const uint64_t data_len,
+                                       const extensions_decode_options_t* options,
+                                       opj_image_t** image,
+                                       extensions_image_pool_t* pool = nullptr)
+{
+    *image = nullptr;
+
+    extensions_decoder_t decoder;
+    auto ret = extensions_decoder_open(&decoder, data, data_len, options);
+    if (ret != ERR_OK)
+        return ret;
+
+    auto output = extensions_decoder_create_image(&decoder, pool);
+    if (output == nullptr)
+    {
+        extensions_decoder_close(&decoder);
+        return ERR_GENERAL_MEMALLOC;
+    }
+
+    std::vector<uint8_t> buffer;
+    ret = extensions_decoder_decode_tiles(&decoder, buffer, [output](const extensions_tile_t& tile)
+    {
+        extensions_tile_copy_to_image(tile, output);
+        return ERR_OK;
+    });
+
+    if (ret == ERR_OK && !extensions_image_copy_icc_profile(output, decoder.header))
+        ret = ERR_GENERAL_MEMALLOC;
+
+    extensions_decoder_close(&decoder);
+
+    if (ret != ERR_OK)
+    {
+        extensions_image_pool_recycle(pool, output);
+        return ret;
+    }
+
+    *image = output;
+    return ERR_OK;
+}
+
+// Decodes the tiles intersecting the decode area of layout, which must be open, with up to num_decoders codecs
+// of their own over the same memory. Each codec reads a band of whole tile rows, or tile columns when the area
+// spans more tiles across than down, so that it parses and skips only the tile-parts of its band.
+// callback(const extensions_tile_t&, uint32_t slot) is called on the decoding threads with the tile components
+// placed in the output of layout; slot is below num_decoders and tells the threads apart for scratch memory.
+// Bands never overlap in the output. The first failure stops the other codecs after their current tile.
+template<typename Callback>
+inline int32_t extensions_decoder_decode_bands(const extensions_decoder_t* layout,
+                                               const extensions_decode_options_t* options,
+                                               const uint32_t num_decoders,
+                                               Callback callback)
+{
+    const auto data = layout->source.data;
+    const auto length = layout->source.length;
+    const auto header = layout->header;
+
+    extensions_header_info_t info;
+    const auto ret = extensions_read_header_info(data, length, &info, nullptr, 0);
+    if (ret != ERR_OK)
+        return ret;
+    if (info.tdx == 0 || info.tdy == 0)
+        return ERR_IMAGE_FILE_INVALID;
+
+    // https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/lib/openjp2/j2k.c (opj_j2k_set_decode_area)
+    const auto tx_begin = (layout->x0 - info.tx0) / info.tdx;
+    const auto tx_end = extensions_ceildiv(layout->x1 - info.tx0, info.tdx);
+    const auto ty_begin = (layout->y0 - info.ty0) / info.tdy;
+    const auto ty_end = extensions_ceildiv(layout->y1 - info.ty0, info.tdy);
+    const auto by_rows = ty_end - ty_begin >= tx_end - tx_begin;
+    const auto lines = by_rows ? ty_end - ty_begin : tx_end - tx_begin;
+    const auto bands = num_decoders <= 1 ? 1 : std::min(lines, num_decoders * EXTENSIONS_DECODE_BANDS_PER_DECODER);
+    const auto slots = std::min(std::max(num_decoders, 1u), bands);
+
+    std::vector<extensions_comp_rect_t> rects(header->numcomps);
+    for (uint32_t compno = 0; compno < header->numcomps; compno++)
+        rects[compno] = extensions_decoder_get_comp_rect(layout, compno);
+
+    std::atomic<uint32_t> next(0);
+    std::atomic<int32_t> status(ERR_OK);
+    const auto fail = [&status](const int32_t error)
+    {
+        auto expected = (int32_t)ERR_OK;
+        status.compare_exchange_strong(expected, error);
+    };
+
+    const auto run = [&](const uint32_t slot)
+    {
+        extensions_decoder_t decoder;
+        std::vector<uint8_t> buffer;
+        std::vector<extensions_comp_rect_t> offsets(header->numcomps);
+        extensions_tile_t placed;
+
+        for (auto band = next++; band < bands && status == ERR_OK; band = next++)
+        {
+            const auto first = (uint32_t)((uint64_t)band * lines / bands);
+            const auto last = (uint32_t)((uint64_t)(band + 1) * lines / bands);
+
+            auto band_options = *options;
+            band_options.x0 = (int32_t)layout->x0;
+            band_options.y0 = (int32_t)layout->y0;
+            band_options.x1 = (int32_t)layout->x1;
+            band_options.y1 = (int32_t)layout->y1;
+            if (by_rows)
+            {
+                band_options.y0 = (int32_t)std::max<uint64_t>(layout->y0, info.ty0 + (uint64_t)(ty_begin + first) * info.tdy);
+                band_options.y1 = (int32_t)std::min<uint64_t>(layout->y1, info.ty0 + (uint64_t)(ty_begin + last) * info.tdy);
+            }
+            else
+            {
+                band_options.x0 = (int32_t)std::max<uint64_t>(layout->x0, info.tx0 + (uint64_t)(tx_begin + first) * info.tdx);
+                band_options.x1 = (int32_t)std::min<uint64_t>(layout->x1, info.tx0 + (uint64_t)(tx_begin + last) * info.tdx);
+            }
+
+            auto band_ret = extensions_decoder_open(&decoder, data, length, &band_options);
+            if (band_ret != ERR_OK)
+            {
+                fail(band_ret);
+                break;
+            }
+
+            for (uint32_t compno = 0; compno < header->numcomps; compno++)
+            {
+                const auto rect = extensions_decoder_get_comp_rect(&decoder, compno);
+                offsets[compno].x0 = rect.x0 - rects[compno].x0;
+                offsets[compno].y0 = rect.y0 - rects[compno].y0;
+            }
+
+            band_ret = extensions_decoder_decode_tiles(&decoder, buffer, [&](const extensions_tile_t& tile)
+            {
+                const auto current = status.load();
+                if (current != ERR_OK)
+                    return current;
+
+                placed = tile;
+                for (uint32_t compno = 0; compno < header->numcomps; compno++)
+                {
+                    placed.comps[compno].x0 += offsets[compno].x0;
+                    placed.comps[compno].y0 += offsets[compno].y0;
+                }
+                return (int32_t)callback(placed, slot);
+            });
+
+            extensions_decoder_close(&decoder);
+            if (band_ret != ERR_OK)
+                fail(band_ret);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t slot = 1; slot < slots; slot++)
+        threads.emplace_back(run, slot);
+    run(0);
+    for (auto& thread : threads)
+        thread.join();
+
+    return status;
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_DECODE_H_
\ No newline at end of file
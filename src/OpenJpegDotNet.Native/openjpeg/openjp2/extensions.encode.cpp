@@ -0,0 +1 @@
+#include "extensions.encode.hpp"
\ No newline at end of file
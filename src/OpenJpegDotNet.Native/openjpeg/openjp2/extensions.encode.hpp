@@ -0,0 +1,140 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_ENCODE_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_ENCODE_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.decode.hpp"
+#include "extensions.pixels.hpp"
+
+// Tile size used when the parameters do not ask for tiles
+#define EXTENSIONS_ENCODE_TILE_SIZE 1024
+
+template<typename T>
+inline void extensions_encode_narrow(const int32_t* src, uint8_t* dst, const uint32_t count)
+{
+    auto out = (T*)dst;
+    for (uint32_t index = 0; index < count; index++)
+        out[index] = (T)src[index];
+}
+
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/tests/test_tile_encoder.c (main)
+// Encodes pixels borrowed from the caller without building the int32 image: each tile is converted from src
+// into one reusable buffer in the layout opj_write_tile expects and handed to the codec, so peak memory is one
+// tile on top of what the codec itself holds.
+// p_codec comes from openjpeg_openjp2_opj_create_compress and p_stream is opened for writing. parameters is
+// used as is, except that a tile size of EXTENSIONS_ENCODE_TILE_SIZE is applied when tile_size_on is false.
+// src is described as for openjpeg_openjp2_extensions_import_pixels and must stay pinned until this returns;
+// every channel becomes a component of precision prec with no subsampling.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_encode_pixels(opj_codec_t* p_codec,
+                                                            const opj_cparameters_t* parameters,
+                                                            const uint8_t* src,
+                                                            const uint64_t src_len,
+                                                            const uint32_t width,
+                                                            const uint32_t height,
+                                                            const uint32_t channels,
+                                                            const uint32_t sample_bytes,
+                                                            const uint64_t pixel_stride,
+                                                            const uint64_t row_stride,
+                                                            const uint64_t channel_stride,
+                                                            const uint32_t prec,
+                                                            const bool sgnd,
+                                                            const int32_t color_space,
+                                                            const uint32_t flags,
+                                                            opj_stream_t* p_stream)
+{
+    if (p_codec == nullptr || parameters == nullptr || p_stream == nullptr || src == nullptr ||
+        width == 0 || height == 0 || channels == 0 || (sample_bytes != 1 && sample_bytes != 2) ||
+        pixel_stride < sample_bytes || prec == 0 || prec > 8 * sample_bytes)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    const auto last = (channels - 1) * channel_stride + (height - 1) * row_stride + (width - 1) * pixel_stride + sample_bytes;
+    if (src_len < last)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    auto local = *parameters;
+    if (!local.tile_size_on)
+    {
+        local.tile_size_on = OPJ_TRUE;
+        local.cp_tx0 = 0;
+        local.cp_ty0 = 0;
+        local.cp_tdx = EXTENSIONS_ENCODE_TILE_SIZE;
+        local.cp_tdy = EXTENSIONS_ENCODE_TILE_SIZE;
+    }
+    // The tile grid may not start after the image origin, which is 0 here
+    if (local.cp_tdx <= 0 || local.cp_tdy <= 0 || local.cp_tx0 != 0 || local.cp_ty0 != 0)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    std::vector<opj_image_cmptparm_t> cmptparms(channels);
+    for (auto& cmptparm : cmptparms)
+    {
+        memset(&cmptparm, 0, sizeof(opj_image_cmptparm_t));
+        cmptparm.dx = 1;
+        cmptparm.dy = 1;
+        cmptparm.w = width;
+        cmptparm.h = height;
+        cmptparm.prec = prec;
+        cmptparm.sgnd = sgnd ? 1 : 0;
+    }
+
+    // The planes are left unallocated; tiles are supplied through opj_write_tile
+    auto image = ::opj_image_tile_create(channels, cmptparms.data(), (OPJ_COLOR_SPACE)color_space);
+    if (image == nullptr)
+        return ERR_GENERAL_MEMALLOC;
+
+    image->x0 = 0;
+    image->y0 = 0;
+    image->x1 = width;
+    image->y1 = height;
+
+    if (!::opj_setup_encoder(p_codec, &local, image) || !::opj_start_compress(p_codec, image, p_stream))
+    {
+        ::opj_image_destroy(image);
+        return ERR_IMAGE_ENCODE_FAILED;
+    }
+
+    const auto tdx = (uint32_t)local.cp_tdx;
+    const auto tdy = (uint32_t)local.cp_tdy;
+    const auto tiles_x = extensions_ceildiv(width, tdx);
+    const auto tiles_y = extensions_ceildiv(height, tdy);
+    const auto tile_sample_size = extensions_decoder_get_sample_size(prec);
+    const auto big_endian = (flags & EXTENSIONS_IMPORT_BIG_ENDIAN) != 0;
+
+    std::vector<uint8_t> buffer((uint64_t)std::min(tdx, width) * std::min(tdy, height) * channels * tile_sample_size);
+    std::vector<int32_t> row(std::min(tdx, width));
+
+    auto ret = ERR_OK;
+    for (uint32_t tile_index = 0; tile_index < tiles_x * tiles_y && ret == ERR_OK; tile_index++)
+    {
+        const auto x0 = (tile_index % tiles_x) * tdx;
+        const auto y0 = (tile_index / tiles_x) * tdy;
+        const auto w = std::min(width - x0, tdx);
+        const auto h = std::min(height - y0, tdy);
+
+        // One plane per component, as opj_tcd_copy_tile_data reads it
+        auto out = buffer.data();
+        for (uint32_t compno = 0; compno < channels; compno++)
+        {
+            for (uint32_t y = 0; y < h; y++, out += (uint64_t)w * tile_sample_size)
+            {
+                const auto in = src + channel_stride * compno + row_stride * (y0 + y) + pixel_stride * x0;
+                extensions_simd_widen(in, pixel_stride, sample_bytes, sgnd, big_endian, row.data(), w);
+                if (tile_sample_size == 1)
+                    extensions_encode_narrow<uint8_t>(row.data(), out, w);
+                else
+                    extensions_encode_narrow<uint16_t>(row.data(), out, w);
+            }
+        }
+
+        const auto size = (uint64_t)w * h * channels * tile_sample_size;
+        if (!::opj_write_tile(p_codec, tile_index, buffer.data(), (OPJ_UINT32)size, p_stream))
+            ret = ERR_IMAGE_ENCODE_FAILED;
+    }
+
+    if (ret == ERR_OK && !::opj_end_compress(p_codec, p_stream))
+        ret = ERR_IMAGE_ENCODE_FAILED;
+
+    ::opj_image_destroy(image);
+    return ret;
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_ENCODE_H_
\ No newline at end of file
@@ -0,0 +1 @@
+#include "extensions.export.hpp"
\ No newline at end of file
@@ -0,0 +1,168 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_EXPORT_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_EXPORT_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.pixels.hpp"
+
+// Writes a decoded image into a buffer owned by the caller, such as the locked bits of a bitmap.
+// format is one of EXTENSIONS_PIXEL_FORMAT_* and flags a combination of EXTENSIONS_PIXEL_*.
+
+// Rows of one BIP work unit; units of whole rows keep threads off each other's cache lines
+#define EXTENSIONS_BAND_BIP_ROWS 16
+
+DLLEXPORT int32_t openjpeg_openjp2_extensions_export_get_info(const opj_image_t* image,
+                                                              const int32_t format,
+                                                              const uint32_t flags,
+                                                              uint32_t* width,
+                                                              uint32_t* height,
+                                                              uint32_t* channels,
+                                                              uint32_t* bits)
+{
+    return extensions_pixels_get_info(image, format, flags, width, height, channels, bits);
+}
+
+// Rows are stride bytes apart and dst_len must cover the last row.
+// EXTENSIONS_PIXEL_FORMAT_PLANAR is not supported here; use openjpeg_openjp2_extensions_imagetobmp instead.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_export_pixels(const opj_image_t* image,
+                                                            const int32_t format,
+                                                            const uint32_t flags,
+                                                            uint8_t* dst,
+                                                            const uint64_t stride,
+                                                            const uint64_t dst_len)
+{
+    uint32_t width, height, channels, bits;
+    const auto ret = extensions_pixels_get_info(image, format, flags, &width, &height, &channels, &bits);
+    if (ret != ERR_OK)
+        return ret;
+
+    const auto row_bytes = (uint64_t)width * channels * (bits / 8);
+    if (dst == nullptr || stride < row_bytes || dst_len < stride * (height - 1) + row_bytes)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    switch (format)
+    {
+        case EXTENSIONS_PIXEL_FORMAT_RGB24:
+        case EXTENSIONS_PIXEL_FORMAT_BGR24:
+        case EXTENSIONS_PIXEL_FORMAT_RGBA32:
+        case EXTENSIONS_PIXEL_FORMAT_BGRA32:
+            return extensions_pixels_export_rgb(image, format, flags, dst, stride);
+        default:
+            return ERR_GENERAL_OUT_OF_RANGE;
+    }
+}
+
+// Writes one component on its own grid, rescaled from its precision to sample_type, one of EXTENSIONS_SAMPLE_*.
+// Signed samples are offset to unsigned first. Rows are stride bytes apart and dst_len must cover the last row;
+// dst and stride must be aligned to the sample size.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_export_component(const opj_image_t* image,
+                                                               const uint32_t compno,
+                                                               const int32_t sample_type,
+                                                               uint8_t* dst,
+                                                               const uint64_t stride,
+                                                               const uint64_t dst_len)
+{
+    if (compno >= image->numcomps)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    const auto& comp = image->comps[compno];
+    const auto sample_bytes = extensions_pixels_get_sample_bytes(sample_type);
+    if (comp.data == nullptr || comp.w == 0 || comp.h == 0 || comp.prec == 0 || comp.prec > 31 || sample_bytes == 0)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    const auto row_bytes = (uint64_t)comp.w * sample_bytes;
+    if (dst == nullptr || (uintptr_t)dst % sample_bytes != 0 || stride < row_bytes || stride % sample_bytes != 0 ||
+        dst_len < stride * (comp.h - 1) + row_bytes)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    for (uint32_t y = 0; y < comp.h; y++)
+        extensions_pixels_scale_row(comp.data + (uint64_t)comp.w * y, sample_type, dst + stride * y, comp.w, comp.prec, comp.sgnd != 0);
+
+    return ERR_OK;
+}
+
+// Writes num_bands components, listed in bands, as one tightly packed block in the given EXTENSIONS_BAND_LAYOUT_*,
+// rescaled to sample_type. Null bands means every component in order. All bands must share the same grid
+// and dst must be aligned to the sample size.
+// BSQ and BIL are split across threads by band, BIP by blocks of rows.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_export_bands(const opj_image_t* image,
+                                                           const uint32_t* bands,
+                                                           const uint32_t num_bands,
+                                                           const int32_t layout,
+                                                           const int32_t sample_type,
+                                                           const int32_t num_threads,
+                                                           uint8_t* dst,
+                                                           const uint64_t dst_len)
+{
+    const auto count = bands != nullptr ? num_bands : image->numcomps;
+    const auto sample_bytes = extensions_pixels_get_sample_bytes(sample_type);
+    if (count == 0 || sample_bytes == 0 || dst == nullptr || (uintptr_t)dst % sample_bytes != 0 ||
+        (layout != EXTENSIONS_BAND_LAYOUT_BSQ && layout != EXTENSIONS_BAND_LAYOUT_BIL && layout != EXTENSIONS_BAND_LAYOUT_BIP))
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    std::vector<const opj_image_comp_t*> comps(count);
+    for (uint32_t band = 0; band < count; band++)
+    {
+        const auto compno = bands != nullptr ? bands[band] : band;
+        if (compno >= image->numcomps)
+            return ERR_GENERAL_OUT_OF_RANGE;
+
+        const auto& comp = image->comps[compno];
+        const auto& first = image->comps[bands != nullptr ? bands[0] : 0];
+        if (comp.data == nullptr || comp.w == 0 || comp.h == 0 || comp.prec == 0 || comp.prec > 31 ||
+            comp.w != first.w || comp.h != first.h || comp.dx != first.dx || comp.dy != first.dy)
+            return ERR_GENERAL_OUT_OF_RANGE;
+
+        comps[band] = &comp;
+    }
+
+    const auto width = comps[0]->w;
+    const auto height = comps[0]->h;
+    const auto row_bytes = (uint64_t)width * sample_bytes;
+    if (dst_len < row_bytes * height * count)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    switch (layout)
+    {
+        case EXTENSIONS_BAND_LAYOUT_BSQ:
+        case EXTENSIONS_BAND_LAYOUT_BIL:
+        {
+            // Offsets of row y of a band from the start of the block
+            const auto band_step = layout == EXTENSIONS_BAND_LAYOUT_BSQ ? row_bytes * height : row_bytes;
+            const auto row_step = layout == EXTENSIONS_BAND_LAYOUT_BSQ ? row_bytes : row_bytes * count;
+            extensions_pixels_parallel(count, num_threads, [&](const uint32_t band)
+            {
+                const auto& comp = *comps[band];
+                for (uint32_t y = 0; y < height; y++)
+                    extensions_pixels_scale_row(comp.data + (uint64_t)width * y, sample_type,
+                                                dst + band_step * band + row_step * y, width, comp.prec, comp.sgnd != 0);
+            });
+            break;
+        }
+        case EXTENSIONS_BAND_LAYOUT_BIP:
+        {
+            const auto units = (height + EXTENSIONS_BAND_BIP_ROWS - 1) / EXTENSIONS_BAND_BIP_ROWS;
+            const auto pixel_bytes = (uint64_t)sample_bytes * count;
+            extensions_pixels_parallel(units, num_threads, [&](const uint32_t unit)
+            {
+                std::vector<uint8_t> scratch(row_bytes);
+                const auto y1 = std::min(height, (unit + 1) * EXTENSIONS_BAND_BIP_ROWS);
+                for (auto y = unit * EXTENSIONS_BAND_BIP_ROWS; y < y1; y++)
+                {
+                    const auto row = dst + pixel_bytes * width * y;
+                    for (uint32_t band = 0; band < count; band++)
+                    {
+                        const auto& comp = *comps[band];
+                        extensions_pixels_scale_row(comp.data + (uint64_t)width * y, sample_type, scratch.data(), width, comp.prec, comp.sgnd != 0);
+                        extensions_pixels_scatter_row(scratch.data(), row + (uint64_t)sample_bytes * band, width, pixel_bytes, sample_bytes);
+                    }
+                }
+            });
+            break;
+        }
+    }
+
+    return ERR_OK;
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_EXPORT_H_
\ No newline at end of file
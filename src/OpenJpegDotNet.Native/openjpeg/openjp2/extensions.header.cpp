@@ -0,0 +1 @@
+#include "extensions.header.hpp"
\ No newline at end of file
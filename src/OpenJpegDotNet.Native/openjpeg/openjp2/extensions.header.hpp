@@ -0,0 +1,17 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_HEADER_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_HEADER_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.codestream.hpp"
+
+DLLEXPORT int32_t openjpeg_openjp2_extensions_read_header_info(const uint8_t* buf,
+                                                               const uint64_t len,
+                                                               extensions_header_info_t* info,
+                                                               extensions_header_comp_info_t* comps,
+                                                               const uint32_t comps_len)
+{
+    return extensions_read_header_info(buf, len, info, comps, comps_len);
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_HEADER_H_
\ No newline at end of file
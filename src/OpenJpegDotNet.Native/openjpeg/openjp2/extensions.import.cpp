@@ -0,0 +1 @@
+#include "extensions.import.hpp"
\ No newline at end of file
@@ -0,0 +1,65 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_IMPORT_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_IMPORT_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.pixels.hpp"
+
+// Fills the int32 planes of an image to be encoded from pixels owned by the caller, such as the locked bits
+// of a bitmap or a raw frame, in place of the per-sample loops of imagetoraw and frametoimage.
+
+// Rows of one work unit
+#define EXTENSIONS_IMPORT_ROWS 32
+
+// Sample c of pixel (x, y) is read from src + c * channel_stride + y * row_stride + x * pixel_stride and goes to
+// component c, which is signed or unsigned as the component says. For interleaved input channel_stride is
+// sample_bytes and pixel_stride channels * sample_bytes; for planar input pixel_stride is sample_bytes and
+// channel_stride the size of a plane. The first channels components must share the same size.
+// Rows are split across num_threads threads; zero or less means one per CPU.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_import_pixels(opj_image_t* image,
+                                                            const uint8_t* src,
+                                                            const uint64_t src_len,
+                                                            const uint32_t channels,
+                                                            const uint32_t sample_bytes,
+                                                            const uint64_t pixel_stride,
+                                                            const uint64_t row_stride,
+                                                            const uint64_t channel_stride,
+                                                            const uint32_t flags,
+                                                            const int32_t num_threads)
+{
+    if (src == nullptr || channels == 0 || channels > image->numcomps || (sample_bytes != 1 && sample_bytes != 2) ||
+        pixel_stride < sample_bytes)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    const auto& first = image->comps[0];
+    for (uint32_t compno = 0; compno < channels; compno++)
+    {
+        const auto& comp = image->comps[compno];
+        if (comp.data == nullptr || comp.w == 0 || comp.h == 0 || comp.w != first.w || comp.h != first.h)
+            return ERR_GENERAL_OUT_OF_RANGE;
+    }
+
+    const auto width = first.w;
+    const auto height = first.h;
+    const auto last = (channels - 1) * channel_stride + (height - 1) * row_stride + (width - 1) * pixel_stride + sample_bytes;
+    if (src_len < last)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    const auto big_endian = (flags & EXTENSIONS_IMPORT_BIG_ENDIAN) != 0;
+    const auto units = (height + EXTENSIONS_IMPORT_ROWS - 1) / EXTENSIONS_IMPORT_ROWS;
+    extensions_pixels_parallel(units, num_threads, [&](const uint32_t unit)
+    {
+        const auto y1 = std::min(height, (unit + 1) * EXTENSIONS_IMPORT_ROWS);
+        for (uint32_t compno = 0; compno < channels; compno++)
+        {
+            const auto& comp = image->comps[compno];
+            for (auto y = unit * EXTENSIONS_IMPORT_ROWS; y < y1; y++)
+                extensions_simd_widen(src + channel_stride * compno + row_stride * y, pixel_stride, sample_bytes,
+                                      comp.sgnd != 0, big_endian, comp.data + (uint64_t)width * y, width);
+        }
+    });
+
+    return ERR_OK;
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_IMPORT_H_
\ No newline at end of file
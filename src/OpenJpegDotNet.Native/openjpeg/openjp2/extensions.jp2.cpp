@@ -0,0 +1 @@
+#include "extensions.jp2.hpp"
\ No newline at end of file
@@ -0,0 +1,210 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_JP2_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_JP2_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.codestream.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/lib/openjp2/jp2.c#L1998
+inline uint32_t extensions_jp2_get_enumcs(const OPJ_COLOR_SPACE color_space, const uint32_t numcomps)
+{
+    switch (color_space)
+    {
+        case OPJ_CLRSPC_SRGB:
+            return 16;
+        case OPJ_CLRSPC_GRAY:
+            return 17;
+        case OPJ_CLRSPC_SYCC:
+            return 18;
+        case OPJ_CLRSPC_EYCC:
+            return 24;
+        case OPJ_CLRSPC_CMYK:
+            return 12;
+        default:
+            return numcomps < 3 ? 17 : 16;
+    }
+}
+
+// Converts pixels per metre into the VR_N/VR_D * 10^VR_E form of the resolution box
+inline void extensions_jp2_get_resolution(double value, uint16_t* num, uint16_t* den, int8_t* exp)
+{
+    int32_t e = 0;
+    while (value > 65535.0 && e < 127)
+    {
+        value /= 10.0;
+        e++;
+    }
+    while (value < 6553.5 && std::floor(value) != value && e > -128)
+    {
+        value *= 10.0;
+        e--;
+    }
+
+    *num = (uint16_t)std::min(65535.0, std::floor(value + 0.5));
+    *den = 1;
+    *exp = (int8_t)e;
+}
+
+DLLEXPORT int32_t openjpeg_openjp2_extensions_j2k_to_jp2(const uint8_t* codestream,
+                                                         const uint64_t codestream_len,
+                                                         const OPJ_COLOR_SPACE color_space,
+                                                         const uint8_t* icc_profile,
+                                                         const uint32_t icc_profile_len,
+                                                         const double resolution_x,
+                                                         const double resolution_y,
+                                                         uint8_t** jp2,
+                                                         uint64_t* jp2_len)
+{
+    *jp2 = nullptr;
+    *jp2_len = 0;
+
+    extensions_siz_t siz;
+    if (!extensions_read_siz(codestream, codestream_len, &siz))
+        return ERR_IMAGE_FILE_INVALID;
+
+    const uint32_t numcomps = siz.numcomps;
+    auto bpc = extensions_siz_get_ssiz(&siz, 0);
+    for (uint32_t compno = 1; compno < numcomps; compno++)
+    {
+        if (extensions_siz_get_ssiz(&siz, compno) != bpc)
+        {
+            bpc = 255;
+            break;
+        }
+    }
+
+    const auto has_icc = icc_profile != nullptr && icc_profile_len > 0;
+    const auto has_res = resolution_x > 0 && resolution_y > 0;
+
+    const uint64_t ihdr_len = 8 + 14;
+    const uint64_t bpcc_len = bpc == 255 ? 8 + numcomps : 0;
+    const uint64_t colr_len = 8 + 3 + (has_icc ? icc_profile_len : 4);
+    const uint64_t res_len = has_res ? 8 + 8 + 10 : 0;
+    const uint64_t jp2h_len = 8 + ihdr_len + bpcc_len + colr_len + res_len;
+    const auto xl = codestream_len > 0xffffffffULL - 8;
+    const uint64_t jp2c_header_len = xl ? 16 : 8;
+    const uint64_t header_len = EXTENSIONS_JP2_SIGNATURE_LENGTH + 20 + jp2h_len + jp2c_header_len;
+
+    auto buf = (uint8_t*)malloc(header_len + codestream_len);
+    if (buf == nullptr)
+        return ERR_GENERAL_MEMALLOC;
+
+    auto p = buf;
+
+    // Signature box
+    p = extensions_write_uint32(p, EXTENSIONS_JP2_SIGNATURE_LENGTH);
+    p = extensions_write_uint32(p, EXTENSIONS_JP2_JP);
+    p = extensions_write_uint32(p, 0x0d0a870a);
+
+    // File Type box
+    p = extensions_write_uint32(p, 20);
+    p = extensions_write_uint32(p, EXTENSIONS_JP2_FTYP);
+    p = extensions_write_uint32(p, EXTENSIONS_JP2_JP2);
+    p = extensions_write_uint32(p, 0);
+    p = extensions_write_uint32(p, EXTENSIONS_JP2_JP2);
+
+    // JP2 Header box
+    p = extensions_write_uint32(p, (uint32_t)jp2h_len);
+    p = extensions_write_uint32(p, EXTENSIONS_JP2_JP2H);
+
+    p = extensions_write_uint32(p, (uint32_t)ihdr_len);
+    p = extensions_write_uint32(p, EXTENSIONS_JP2_IHDR);
+    p = extensions_write_uint32(p, siz.y1 - siz.y0);
+    p = extensions_write_uint32(p, siz.x1 - siz.x0);
+    p = extensions_write_uint16(p, (uint16_t)numcomps);
+    p = extensions_write_uint8(p, bpc);
+    p = extensions_write_uint8(p, 7);
+    p = extensions_write_uint8(p, 0);
+    p = extensions_write_uint8(p, 0);
+
+    if (bpcc_len != 0)
+    {
+        p = extensions_write_uint32(p, (uint32_t)bpcc_len);
+        p = extensions_write_uint32(p, EXTENSIONS_JP2_BPCC);
+        for (uint32_t compno = 0; compno < numcomps; compno++)
+            p = extensions_write_uint8(p, extensions_siz_get_ssiz(&siz, compno));
+    }
+
+    p = extensions_write_uint32(p, (uint32_t)colr_len);
+    p = extensions_write_uint32(p, EXTENSIONS_JP2_COLR);
+    p = extensions_write_uint8(p, has_icc ? 2 : 1);
+    p = extensions_write_uint8(p, 0);
+    p = extensions_write_uint8(p, 0);
+    if (has_icc)
+    {
+        memcpy(p, icc_profile, icc_profile_len);
+        p += icc_profile_len;
+    }
+    else
+    {
+        p = extensions_write_uint32(p, extensions_jp2_get_enumcs(color_space, numcomps));
+    }
+
+    if (has_res)
+    {
+        uint16_t vr_n, vr_d, hr_n, hr_d;
+        int8_t vr_e, hr_e;
+        extensions_jp2_get_resolution(resolution_y, &vr_n, &vr_d, &vr_e);
+        extensions_jp2_get_resolution(resolution_x, &hr_n, &hr_d, &hr_e);
+
+        p = extensions_write_uint32(p, (uint32_t)res_len);
+        p = extensions_write_uint32(p, EXTENSIONS_JP2_RES);
+        p = extensions_write_uint32(p, 8 + 10);
+        p = extensions_write_uint32(p, EXTENSIONS_JP2_RESD);
+        p = extensions_write_uint16(p, vr_n);
+        p = extensions_write_uint16(p, vr_d);
+        p = extensions_write_uint16(p, hr_n);
+        p = extensions_write_uint16(p, hr_d);
+        p = extensions_write_uint8(p, (uint8_t)vr_e);
+        p = extensions_write_uint8(p, (uint8_t)hr_e);
+    }
+
+    // Contiguous Codestream box
+    if (xl)
+    {
+        p = extensions_write_uint32(p, 1);
+        p = extensions_write_uint32(p, EXTENSIONS_JP2_JP2C);
+        p = extensions_write_uint64(p, jp2c_header_len + codestream_len);
+    }
+    else
+    {
+        p = extensions_write_uint32(p, (uint32_t)(jp2c_header_len + codestream_len));
+        p = extensions_write_uint32(p, EXTENSIONS_JP2_JP2C);
+    }
+
+    memcpy(p, codestream, codestream_len);
+
+    *jp2 = buf;
+    *jp2_len = header_len + codestream_len;
+    return ERR_OK;
+}
+
+DLLEXPORT int32_t openjpeg_openjp2_extensions_jp2_to_j2k(const uint8_t* jp2,
+                                                         const uint64_t jp2_len,
+                                                         uint64_t* codestream_offset,
+                                                         uint64_t* codestream_len)
+{
+    *codestream_offset = 0;
+    *codestream_len = 0;
+
+    if (!extensions_is_jp2(jp2, jp2_len))
+        return ERR_IMAGE_FILE_INVALID;
+
+    extensions_box_t box;
+    if (!extensions_find_box(jp2, EXTENSIONS_JP2_SIGNATURE_LENGTH, jp2_len, EXTENSIONS_JP2_JP2C, &box))
+        return ERR_IMAGE_FILE_INVALID;
+
+    const auto offset = box.offset + box.header_length;
+    const auto length = box.length - box.header_length;
+    if (!extensions_is_j2k(jp2 + offset, length))
+        return ERR_IMAGE_FILE_INVALID;
+
+    *codestream_offset = offset;
+    *codestream_len = length;
+    return ERR_OK;
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_JP2_H_
\ No newline at end of file
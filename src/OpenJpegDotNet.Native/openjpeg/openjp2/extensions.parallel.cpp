@@ -0,0 +1 @@
+#include "extensions.parallel.hpp"
\ No newline at end of file
@@ -0,0 +1,73 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_PARALLEL_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_PARALLEL_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.decode.hpp"
+
+// opj_codec_set_threads only spreads the code-blocks of one tile over threads, while the tile-part headers
+// and tier-2 of every tile are still read one after the other. Here several codecs decode disjoint bands of
+// tiles of the same memory at once, straight into one output image.
+
+// Same as openjpeg_openjp2_extensions_decode_memory, but with up to num_decoders codecs at once, each handed
+// num_threads. An image of a single tile row and column is decoded by one codec.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_parallel_decode_memory(const uint8_t* data,
+                                                                     const uint64_t data_len,
+                                                                     const uint32_t reduce,
+                                                                     const uint32_t layers,
+                                                                     const int32_t x0,
+                                                                     const int32_t y0,
+                                                                     const int32_t x1,
+                                                                     const int32_t y1,
+                                                                     const uint32_t num_decoders,
+                                                                     const int32_t num_threads,
+                                                                     const extensions_cancel_token_t* token,
+                                                                     opj_image_t** image)
+{
+    *image = nullptr;
+
+    extensions_decode_options_t options;
+    options.reduce = reduce;
+    options.layers = layers;
+    options.x0 = x0;
+    options.y0 = y0;
+    options.x1 = x1;
+    options.y1 = y1;
+    options.num_threads = num_threads;
+    options.token = token;
+
+    // Only reads the header, to lay out the output
+    extensions_decoder_t layout;
+    auto ret = extensions_decoder_open(&layout, data, data_len, &options);
+    if (ret != ERR_OK)
+        return ret;
+
+    auto output = extensions_decoder_create_image(&layout);
+    if (output == nullptr)
+    {
+        extensions_decoder_close(&layout);
+        return ERR_GENERAL_MEMALLOC;
+    }
+
+    ret = extensions_decoder_decode_bands(&layout, &options, num_decoders, [output](const extensions_tile_t& tile, const uint32_t)
+    {
+        extensions_tile_copy_to_image(tile, output);
+        return ERR_OK;
+    });
+
+    if (ret == ERR_OK && !extensions_image_copy_icc_profile(output, layout.header))
+        ret = ERR_GENERAL_MEMALLOC;
+
+    extensions_decoder_close(&layout);
+
+    if (ret != ERR_OK)
+    {
+        ::opj_image_destroy(output);
+        return ret;
+    }
+
+    *image = output;
+    return ERR_OK;
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_PARALLEL_H_
\ No newline at end of file
@@ -0,0 +1,877 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_PIXELS_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_PIXELS_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.decode.hpp"
+#include "extensions.simd.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Helpers to pack the int32 planes of a decoded image into the pixel layouts handed to callers.
+// They are shared by several extension modules and must stay inline because each module is
+// compiled as its own translation unit.
+
+// Same layout as openjpeg_openjp2_extensions_imagetobmp: up to 4 planes one after another,
+// 8 bits per sample when the precision fits, 16 bits otherwise
+#define EXTENSIONS_PIXEL_FORMAT_PLANAR 0
+// 8-bit interleaved pixels converted to RGB from the color space of the image
+#define EXTENSIONS_PIXEL_FORMAT_RGB24  1
+#define EXTENSIONS_PIXEL_FORMAT_BGR24  2
+// Same with a fourth byte of opacity, taken from the component flagged as alpha or opaque when there is none
+#define EXTENSIONS_PIXEL_FORMAT_RGBA32 3
+#define EXTENSIONS_PIXEL_FORMAT_BGRA32 4
+
+// Exports the components as they are, without converting sYCC, e-YCC or CMYK to RGB
+#define EXTENSIONS_PIXEL_NO_COLOR_CONVERSION 0x1
+// Upsamples subsampled components bilinearly instead of replicating the nearest sample
+#define EXTENSIONS_PIXEL_UPSAMPLE_BILINEAR   0x2
+// Multiplies the colors of RGBA32 and BGRA32 by their opacity
+#define EXTENSIONS_PIXEL_PREMULTIPLY_ALPHA   0x4
+
+// Two-byte samples of imported pixels are big endian instead of little endian
+#define EXTENSIONS_IMPORT_BIG_ENDIAN 0x1
+
+// Sample types of exported planes. Integer types span their full range and float32 spans [0, 1].
+#define EXTENSIONS_SAMPLE_UINT8   0
+#define EXTENSIONS_SAMPLE_UINT16  1
+#define EXTENSIONS_SAMPLE_FLOAT32 2
+
+// Layouts of a multi-band export, named as in ENVI headers
+// BSQ: each band is a whole plane; BIL: row y of every band in turn; BIP: every band of a pixel in turn
+#define EXTENSIONS_BAND_LAYOUT_BSQ 0
+#define EXTENSIONS_BAND_LAYOUT_BIL 1
+#define EXTENSIONS_BAND_LAYOUT_BIP 2
+
+// Packed pixels allocated with malloc and released with stdlib_free
+typedef struct extensions_pixels
+{
+    uint8_t* data;
+    uint64_t length;
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+    uint32_t bits;
+} extensions_pixels_t;
+
+template<typename T>
+inline void extensions_pixels_pack_plane(const opj_image_comp_t& comp, const int32_t min, const int32_t max, T* dst)
+{
+    const auto mask = (int32_t)((1u << comp.prec) - 1);
+    const auto count = (uint64_t)comp.w * comp.h;
+    const auto src = comp.data;
+    for (uint64_t index = 0; index < count; index++)
+        dst[index] = (T)(std::min(max, std::max(min, src[index])) & mask);
+}
+
+inline int32_t extensions_pixels_check_planar(const opj_image_t* image)
+{
+    if (image->numcomps == 0 || image->comps[0].w == 0 || image->comps[0].h == 0)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    const auto numcomps = std::min(image->numcomps, 4u);
+    const auto& first = image->comps[0];
+    for (uint32_t compno = 1; compno < numcomps; compno++)
+    {
+        const auto& comp = image->comps[compno];
+        if (comp.dx != first.dx || comp.dy != first.dy || comp.prec != first.prec || comp.sgnd != first.sgnd ||
+            comp.w != first.w || comp.h != first.h)
+            return ERR_GENERAL_OUT_OF_RANGE;
+    }
+
+    if (first.prec == 0 || first.prec > 16)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    return ERR_OK;
+}
+
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/bin/jp2/convert.c (imagetoraw_common)
+// The image must have passed extensions_pixels_check_planar
+inline void extensions_pixels_write_planar(const opj_image_t* image, uint8_t* data)
+{
+    const auto numcomps = std::min(image->numcomps, 4u);
+    const auto& first = image->comps[0];
+    const auto bits = first.prec <= 8 ? 8u : 16u;
+    const auto plane = (uint64_t)first.w * first.h;
+    for (uint32_t compno = 0; compno < numcomps; compno++)
+    {
+        const auto& comp = image->comps[compno];
+        if (bits == 8)
+        {
+            if (comp.sgnd)
+                extensions_pixels_pack_plane(comp, -128, 127, (int8_t*)data + plane * compno);
+            else
+                extensions_pixels_pack_plane(comp, 0, 255, data + plane * compno);
+        }
+        else
+        {
+            if (comp.sgnd)
+                extensions_pixels_pack_plane(comp, -32768, 32767, (int16_t*)data + plane * compno);
+            else
+                extensions_pixels_pack_plane(comp, 0, 65535, (uint16_t*)data + plane * compno);
+        }
+    }
+}
+
+inline int32_t extensions_pixels_pack_planar(const opj_image_t* image, extensions_pixels_t* pixels)
+{
+    const auto ret = extensions_pixels_check_planar(image);
+    if (ret != ERR_OK)
+        return ret;
+
+    const auto numcomps = std::min(image->numcomps, 4u);
+    const auto& first = image->comps[0];
+    const auto bits = first.prec <= 8 ? 8u : 16u;
+    const auto length = (uint64_t)first.w * first.h * numcomps * (bits / 8);
+    auto data = (uint8_t*)malloc(length);
+    if (data == nullptr)
+        return ERR_GENERAL_MEMALLOC;
+
+    extensions_pixels_write_planar(image, data);
+
+    pixels->data = data;
+    pixels->length = length;
+    pixels->width = first.w;
+    pixels->height = first.h;
+    pixels->channels = numcomps;
+    pixels->bits = bits;
+    return ERR_OK;
+}
+
+// Runs work(unit) for units 0 to count - 1 on up to num_threads threads, the calling thread included
+template<typename Work>
+inline void extensions_pixels_parallel(const uint32_t count, const int32_t num_threads, Work work)
+{
+    const auto requested = num_threads > 0 ? num_threads : std::max(1, ::opj_get_num_cpus());
+    const auto thread_count = std::min<uint32_t>((uint32_t)requested, count);
+
+    std::atomic<uint32_t> next(0);
+    const auto run = [&]
+    {
+        for (auto unit = next++; unit < count; unit = next++)
+            work(unit);
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t index = 1; index < thread_count; index++)
+        threads.emplace_back(run);
+    run();
+    for (auto& thread : threads)
+        thread.join();
+}
+
+template<uint32_t Size>
+inline void extensions_pixels_scatter(const uint8_t* src, uint8_t* dst, const uint32_t count, const uint64_t step)
+{
+    // The destination of a band inside a pixel need not be aligned for the sample type
+    for (uint32_t index = 0; index < count; index++)
+        memcpy(dst + step * index, src + Size * index, Size);
+}
+
+inline void extensions_pixels_scatter_row(const uint8_t* src, uint8_t* dst, const uint32_t count, const uint64_t step, const uint32_t sample_bytes)
+{
+    switch (sample_bytes)
+    {
+        case 1:
+            extensions_pixels_scatter<1>(src, dst, count, step);
+            break;
+        case 2:
+            extensions_pixels_scatter<2>(src, dst, count, step);
+            break;
+        default:
+            extensions_pixels_scatter<4>(src, dst, count, step);
+            break;
+    }
+}
+
+inline uint32_t extensions_pixels_get_sample_bytes(const int32_t sample_type)
+{
+    switch (sample_type)
+    {
+        case EXTENSIONS_SAMPLE_UINT8:
+            return 1;
+        case EXTENSIONS_SAMPLE_UINT16:
+            return 2;
+        case EXTENSIONS_SAMPLE_FLOAT32:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+// Rescales one row of samples of the given precision to sample_type
+inline void extensions_pixels_scale_row(const int32_t* src,
+                                        const int32_t sample_type,
+                                        void* dst,
+                                        const uint32_t count,
+                                        const uint32_t prec,
+                                        const bool sgnd)
+{
+    switch (sample_type)
+    {
+        case EXTENSIONS_SAMPLE_UINT8:
+            extensions_simd_scale_to_uint8(src, (uint8_t*)dst, count, prec, sgnd);
+            break;
+        case EXTENSIONS_SAMPLE_UINT16:
+            extensions_simd_scale_to_uint16(src, (uint16_t*)dst, count, prec, sgnd);
+            break;
+        case EXTENSIONS_SAMPLE_FLOAT32:
+            extensions_simd_scale_to_float32(src, (float*)dst, count, prec, sgnd);
+            break;
+    }
+}
+
+typedef enum extensions_pixels_color
+{
+    EXTENSIONS_PIXELS_COLOR_GRAY,
+    EXTENSIONS_PIXELS_COLOR_RGB,
+    EXTENSIONS_PIXELS_COLOR_SYCC,
+    EXTENSIONS_PIXELS_COLOR_EYCC,
+    EXTENSIONS_PIXELS_COLOR_CMYK
+} extensions_pixels_color_t;
+
+// Maps the output grid onto the samples of one component. The output grid is that of the finest component,
+// and coarser components, such as 4:2:2 and 4:2:0 chroma, are upsampled to it row by row.
+// Samples are co-sited with the reference grid as in the JPEG 2000 canvas: sample i of a component sits at
+// (x0 + i) * dx, and bilinear upsampling interpolates between those positions.
+typedef struct extensions_pixels_sampler
+{
+    const opj_image_comp_t* comp;
+    bool bilinear;
+    // Nearest: the output row is a plain copy of the component row when identity is set
+    bool identity;
+    std::vector<uint32_t> columns;
+    std::vector<uint32_t> rows;
+    // Bilinear: source columns and rows on both sides of each output sample and the weight of the far side
+    std::vector<uint32_t> rights;
+    std::vector<uint32_t> bottoms;
+    std::vector<float> weights_x;
+    std::vector<float> weights_y;
+    // The last two component rows resampled horizontally, so each one is computed once
+    std::vector<float> lines[2];
+    int64_t line_rows[2];
+} extensions_pixels_sampler_t;
+
+inline uint32_t extensions_pixels_map(const uint32_t ref_origin, const uint32_t ref_d, const uint32_t origin, const uint32_t d, const uint32_t size, const uint32_t index)
+{
+    // Both grids are scaled by the same reduce factor, so the ratio of the subsampling steps still holds
+    const auto position = (int64_t)((uint64_t)(ref_origin + index) * ref_d / d) - origin;
+    return (uint32_t)std::min<int64_t>(size - 1, std::max<int64_t>(0, position));
+}
+
+inline void extensions_pixels_map_bilinear(const uint32_t ref_origin,
+                                           const uint32_t ref_d,
+                                           const uint32_t origin,
+                                           const uint32_t d,
+                                           const uint32_t size,
+                                           const uint32_t index,
+                                           uint32_t* near,
+                                           uint32_t* far,
+                                           float* weight)
+{
+    const auto position = (uint64_t)(ref_origin + index) * ref_d;
+    const auto left = (int64_t)(position / d) - origin;
+    *weight = (float)(position % d) / (float)d;
+    *near = (uint32_t)std::min<int64_t>(size - 1, std::max<int64_t>(0, left));
+    *far = (uint32_t)std::min<int64_t>(size - 1, std::max<int64_t>(0, left + 1));
+    if (*near == *far)
+        *weight = 0.0f;
+}
+
+inline void extensions_pixels_sampler_init(extensions_pixels_sampler_t* sampler,
+                                           const opj_image_comp_t& ref,
+                                           const opj_image_comp_t& comp,
+                                           const uint32_t width,
+                                           const uint32_t height,
+                                           const uint32_t flags)
+{
+    sampler->comp = &comp;
+    sampler->bilinear = (flags & EXTENSIONS_PIXEL_UPSAMPLE_BILINEAR) != 0 && (comp.dx != ref.dx || comp.dy != ref.dy);
+    sampler->identity = comp.dx == ref.dx && comp.x0 == ref.x0 && comp.w >= width;
+    sampler->line_rows[0] = -1;
+    sampler->line_rows[1] = -1;
+
+    if (!sampler->bilinear)
+    {
+        sampler->columns.resize(sampler->identity ? 0 : width);
+        for (uint32_t x = 0; x < sampler->columns.size(); x++)
+            sampler->columns[x] = extensions_pixels_map(ref.x0, ref.dx, comp.x0, comp.dx, comp.w, x);
+
+        sampler->rows.resize(height);
+        for (uint32_t y = 0; y < height; y++)
+            sampler->rows[y] = extensions_pixels_map(ref.y0, ref.dy, comp.y0, comp.dy, comp.h, y);
+        return;
+    }
+
+    sampler->columns.resize(width);
+    sampler->rights.resize(width);
+    sampler->weights_x.resize(width);
+    for (uint32_t x = 0; x < width; x++)
+        extensions_pixels_map_bilinear(ref.x0, ref.dx, comp.x0, comp.dx, comp.w, x,
+                                       &sampler->columns[x], &sampler->rights[x], &sampler->weights_x[x]);
+
+    sampler->rows.resize(height);
+    sampler->bottoms.resize(height);
+    sampler->weights_y.resize(height);
+    for (uint32_t y = 0; y < height; y++)
+        extensions_pixels_map_bilinear(ref.y0, ref.dy, comp.y0, comp.dy, comp.h, y,
+                                       &sampler->rows[y], &sampler->bottoms[y], &sampler->weights_y[y]);
+
+    sampler->lines[0].resize(width);
+    sampler->lines[1].resize(width);
+}
+
+// Returns the component row resampled horizontally to the output width
+inline const float* extensions_pixels_sampler_line(extensions_pixels_sampler_t* sampler, const uint32_t row, const uint32_t width)
+{
+    for (auto slot = 0; slot < 2; slot++)
+        if (sampler->line_rows[slot] == row)
+            return sampler->lines[slot].data();
+
+    // Rows are visited top to bottom, so the line with the lower row is the one no longer needed
+    const auto slot = sampler->line_rows[0] <= sampler->line_rows[1] ? 0 : 1;
+    sampler->line_rows[slot] = row;
+
+    const auto src = sampler->comp->data + (uint64_t)row * sampler->comp->w;
+    auto dst = sampler->lines[slot].data();
+    if (sampler->identity)
+    {
+        for (uint32_t x = 0; x < width; x++)
+            dst[x] = (float)src[x];
+        return dst;
+    }
+
+    const auto columns = sampler->columns.data();
+    const auto rights = sampler->rights.data();
+    const auto weights = sampler->weights_x.data();
+    for (uint32_t x = 0; x < width; x++)
+    {
+        const auto left = (float)src[columns[x]];
+        dst[x] = left + ((float)src[rights[x]] - left) * weights[x];
+    }
+    return dst;
+}
+
+inline void extensions_pixels_sampler_read(extensions_pixels_sampler_t* sampler, const uint32_t y, const uint32_t width, int32_t* dst)
+{
+    if (sampler->bilinear)
+    {
+        const auto top = extensions_pixels_sampler_line(sampler, sampler->rows[y], width);
+        const auto bottom = extensions_pixels_sampler_line(sampler, sampler->bottoms[y], width);
+        extensions_simd_lerp_rows(top, bottom, sampler->weights_y[y], dst, width);
+        return;
+    }
+
+    const auto src = sampler->comp->data + (uint64_t)sampler->rows[y] * sampler->comp->w;
+    if (sampler->identity)
+    {
+        memcpy(dst, src, width * sizeof(int32_t));
+        return;
+    }
+
+    const auto columns = sampler->columns.data();
+    for (uint32_t x = 0; x < width; x++)
+        dst[x] = src[columns[x]];
+}
+
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/bin/jp2/opj_decompress.c (main)
+// Follows the choice opj_decompress makes before calling the color.c conversions
+inline extensions_pixels_color_t extensions_pixels_get_color(const opj_image_t* image, const uint32_t flags)
+{
+    if (image->numcomps < 3)
+        return EXTENSIONS_PIXELS_COLOR_GRAY;
+    if ((flags & EXTENSIONS_PIXEL_NO_COLOR_CONVERSION) != 0)
+        return EXTENSIONS_PIXELS_COLOR_RGB;
+
+    // opj_decompress treats three components with subsampled chroma as sYCC whatever the header says
+    // https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/bin/jp2/opj_decompress.c
+    if (image->numcomps == 3 && image->comps[0].dx == image->comps[0].dy && image->comps[1].dx != 1)
+        return EXTENSIONS_PIXELS_COLOR_SYCC;
+
+    switch (image->color_space)
+    {
+        case OPJ_CLRSPC_SYCC:
+            return EXTENSIONS_PIXELS_COLOR_SYCC;
+        case OPJ_CLRSPC_EYCC:
+            return EXTENSIONS_PIXELS_COLOR_EYCC;
+        case OPJ_CLRSPC_CMYK:
+            return image->numcomps >= 4 ? EXTENSIONS_PIXELS_COLOR_CMYK : EXTENSIONS_PIXELS_COLOR_RGB;
+        default:
+            return EXTENSIONS_PIXELS_COLOR_RGB;
+    }
+}
+
+inline uint32_t extensions_pixels_get_color_comps(const extensions_pixels_color_t color)
+{
+    switch (color)
+    {
+        case EXTENSIONS_PIXELS_COLOR_GRAY:
+            return 1;
+        case EXTENSIONS_PIXELS_COLOR_CMYK:
+            return 4;
+        default:
+            return 3;
+    }
+}
+
+// The size of the output grid, which is the size of the finest of the components used
+inline int32_t extensions_pixels_get_grid(const opj_image_t* image, const uint32_t numcomps, uint32_t* refno)
+{
+    if (image->numcomps < numcomps || numcomps == 0)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    *refno = 0;
+    for (uint32_t compno = 0; compno < numcomps; compno++)
+    {
+        const auto& comp = image->comps[compno];
+        if (comp.data == nullptr || comp.w == 0 || comp.h == 0 || comp.dx == 0 || comp.dy == 0 ||
+            comp.prec == 0 || comp.prec > 31)
+            return ERR_GENERAL_OUT_OF_RANGE;
+
+        const auto& ref = image->comps[*refno];
+        if ((uint64_t)comp.dx * comp.dy < (uint64_t)ref.dx * ref.dy)
+            *refno = compno;
+    }
+
+    return ERR_OK;
+}
+
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/lib/openjp2/jp2.c (opj_jp2_apply_cdef)
+// The first component after the color components that cdef marks as opacity (1) or premultiplied opacity (2).
+// Returns numcomps when there is none.
+inline uint32_t extensions_pixels_find_alpha(const opj_image_t* image, const uint32_t first)
+{
+    for (auto compno = first; compno < image->numcomps; compno++)
+        if (image->comps[compno].alpha != 0)
+            return compno;
+    return image->numcomps;
+}
+
+inline int32_t extensions_pixels_get_info(const opj_image_t* image,
+                                          const int32_t format,
+                                          const uint32_t flags,
+                                          uint32_t* width,
+                                          uint32_t* height,
+                                          uint32_t* channels,
+                                          uint32_t* bits)
+{
+    *width = 0;
+    *height = 0;
+    *channels = 0;
+    *bits = 0;
+
+    switch (format)
+    {
+        case EXTENSIONS_PIXEL_FORMAT_PLANAR:
+        {
+            if (image->numcomps == 0 || image->comps[0].prec == 0 || image->comps[0].prec > 16)
+                return ERR_GENERAL_OUT_OF_RANGE;
+
+            *width = image->comps[0].w;
+            *height = image->comps[0].h;
+            *channels = std::min(image->numcomps, 4u);
+            *bits = image->comps[0].prec <= 8 ? 8 : 16;
+            return ERR_OK;
+        }
+        case EXTENSIONS_PIXEL_FORMAT_RGB24:
+        case EXTENSIONS_PIXEL_FORMAT_BGR24:
+        case EXTENSIONS_PIXEL_FORMAT_RGBA32:
+        case EXTENSIONS_PIXEL_FORMAT_BGRA32:
+        {
+            const auto color = extensions_pixels_get_color(image, flags);
+            uint32_t refno;
+            const auto ret = extensions_pixels_get_grid(image, extensions_pixels_get_color_comps(color), &refno);
+            if (ret != ERR_OK)
+                return ret;
+
+            *width = image->comps[refno].w;
+            *height = image->comps[refno].h;
+            *channels = format == EXTENSIONS_PIXEL_FORMAT_RGBA32 || format == EXTENSIONS_PIXEL_FORMAT_BGRA32 ? 4 : 3;
+            *bits = 8;
+            return ERR_OK;
+        }
+        default:
+            return ERR_GENERAL_OUT_OF_RANGE;
+    }
+}
+
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/bin/common/color.c
+// Converts the image to RGB one row at a time while interleaving it into dst, so no full-size intermediate
+// planes are allocated. Rows are stride bytes apart. format is one of the RGB24, BGR24, RGBA32 and BGRA32
+// formats; premultiplication is fused into the interleave.
+inline int32_t extensions_pixels_export_rgb(const opj_image_t* image,
+                                            const int32_t format,
+                                            const uint32_t flags,
+                                            uint8_t* dst,
+                                            const uint64_t stride)
+{
+    const auto color = extensions_pixels_get_color(image, flags);
+    const auto numcomps = extensions_pixels_get_color_comps(color);
+    uint32_t refno;
+    const auto ret = extensions_pixels_get_grid(image, numcomps, &refno);
+    if (ret != ERR_OK)
+        return ret;
+
+    const auto bgr = format == EXTENSIONS_PIXEL_FORMAT_BGR24 || format == EXTENSIONS_PIXEL_FORMAT_BGRA32;
+    const auto with_alpha = format == EXTENSIONS_PIXEL_FORMAT_RGBA32 || format == EXTENSIONS_PIXEL_FORMAT_BGRA32;
+    const auto alphano = with_alpha ? extensions_pixels_find_alpha(image, numcomps) : image->numcomps;
+    const auto has_alpha = alphano < image->numcomps;
+    if (has_alpha)
+    {
+        const auto& alpha = image->comps[alphano];
+        if (alpha.data == nullptr || alpha.w == 0 || alpha.h == 0 || alpha.dx == 0 || alpha.dy == 0 ||
+            alpha.prec == 0 || alpha.prec > 31)
+            return ERR_GENERAL_OUT_OF_RANGE;
+    }
+
+    const auto premultiplied = has_alpha && image->comps[alphano].alpha == 2;
+    const auto premultiply = (flags & EXTENSIONS_PIXEL_PREMULTIPLY_ALPHA) != 0 && !premultiplied;
+    const auto unpremultiply = (flags & EXTENSIONS_PIXEL_PREMULTIPLY_ALPHA) == 0 && premultiplied;
+
+    const auto& ref = image->comps[refno];
+    const auto width = ref.w;
+    const auto height = ref.h;
+
+    extensions_pixels_sampler_t samplers[5];
+    for (uint32_t compno = 0; compno < numcomps; compno++)
+        extensions_pixels_sampler_init(&samplers[compno], ref, image->comps[compno], width, height, flags);
+    if (has_alpha)
+        extensions_pixels_sampler_init(&samplers[4], ref, image->comps[alphano], width, height, flags);
+
+    // The alpha component is read into the fifth row
+    std::vector<int32_t> rows(width * (size_t)5);
+    std::vector<uint8_t> bytes(width * (size_t)4, 255);
+    int32_t* row[5];
+    uint8_t* channel[4];
+    for (uint32_t index = 0; index < 5; index++)
+        row[index] = rows.data() + width * (size_t)index;
+    for (uint32_t index = 0; index < 4; index++)
+        channel[index] = bytes.data() + width * (size_t)index;
+
+    const auto& comps = image->comps;
+    for (uint32_t y = 0; y < height; y++)
+    {
+        for (uint32_t compno = 0; compno < numcomps; compno++)
+            extensions_pixels_sampler_read(&samplers[compno], y, width, row[compno]);
+
+        switch (color)
+        {
+            case EXTENSIONS_PIXELS_COLOR_GRAY:
+                extensions_simd_scale_to_uint8(row[0], channel[0], width, comps[0].prec, comps[0].sgnd != 0);
+                memcpy(channel[1], channel[0], width);
+                memcpy(channel[2], channel[0], width);
+                break;
+            case EXTENSIONS_PIXELS_COLOR_RGB:
+                for (uint32_t index = 0; index < 3; index++)
+                    extensions_simd_scale_to_uint8(row[index], channel[index], width, comps[index].prec, comps[index].sgnd != 0);
+                break;
+            case EXTENSIONS_PIXELS_COLOR_SYCC:
+                extensions_simd_sycc_to_rgb(row[0], row[1], row[2], width, comps[0].prec);
+                for (uint32_t index = 0; index < 3; index++)
+                    extensions_simd_scale_to_uint8(row[index], channel[index], width, comps[0].prec, false);
+                break;
+            case EXTENSIONS_PIXELS_COLOR_EYCC:
+                extensions_simd_eycc_to_rgb(row[0], row[1], row[2], width, comps[0].prec,
+                                            comps[0].sgnd != 0, comps[1].sgnd != 0, comps[2].sgnd != 0);
+                for (uint32_t index = 0; index < 3; index++)
+                    extensions_simd_scale_to_uint8(row[index], channel[index], width, comps[0].prec, false);
+                break;
+            case EXTENSIONS_PIXELS_COLOR_CMYK:
+                extensions_simd_cmyk_to_rgb(row[0], row[1], row[2], row[3], width,
+                                            comps[0].prec, comps[1].prec, comps[2].prec, comps[3].prec);
+                for (uint32_t index = 0; index < 3; index++)
+                    extensions_simd_scale_to_uint8(row[index], channel[index], width, comps[0].prec, false);
+                break;
+        }
+
+        const auto r = channel[bgr ? 2 : 0];
+        const auto g = channel[1];
+        const auto b = channel[bgr ? 0 : 2];
+        if (!with_alpha)
+        {
+            extensions_simd_interleave3(r, g, b, dst + stride * y, width);
+            continue;
+        }
+
+        const auto a = channel[3];
+        if (has_alpha)
+        {
+            const auto& alpha = image->comps[alphano];
+            extensions_pixels_sampler_read(&samplers[4], y, width, row[4]);
+            extensions_simd_scale_to_uint8(row[4], a, width, alpha.prec, alpha.sgnd != 0);
+        }
+        if (unpremultiply)
+        {
+            for (uint32_t index = 0; index < 3; index++)
+                extensions_simd_unpremultiply(channel[index], a, width);
+        }
+        extensions_simd_interleave4(r, g, b, a, dst + stride * y, width, premultiply);
+    }
+
+    return ERR_OK;
+}
+
+inline int32_t extensions_pixels_pack(const opj_image_t* image, const int32_t format, const uint32_t flags, extensions_pixels_t* pixels)
+{
+    memset(pixels, 0, sizeof(extensions_pixels_t));
+
+    switch (format)
+    {
+        case EXTENSIONS_PIXEL_FORMAT_PLANAR:
+            return extensions_pixels_pack_planar(image, pixels);
+        case EXTENSIONS_PIXEL_FORMAT_RGB24:
+        case EXTENSIONS_PIXEL_FORMAT_BGR24:
+        case EXTENSIONS_PIXEL_FORMAT_RGBA32:
+        case EXTENSIONS_PIXEL_FORMAT_BGRA32:
+        {
+            uint32_t width, height, channels, bits;
+            auto ret = extensions_pixels_get_info(image, format, flags, &width, &height, &channels, &bits);
+            if (ret != ERR_OK)
+                return ret;
+
+            const auto stride = (uint64_t)width * channels;
+            const auto length = stride * height;
+            auto data = (uint8_t*)malloc(length);
+            if (data == nullptr)
+                return ERR_GENERAL_MEMALLOC;
+
+            ret = extensions_pixels_export_rgb(image, format, flags, data, stride);
+            if (ret != ERR_OK)
+            {
+                free(data);
+                return ret;
+            }
+
+            pixels->data = data;
+            pixels->length = length;
+            pixels->width = width;
+            pixels->height = height;
+            pixels->channels = channels;
+            pixels->bits = bits;
+            return ERR_OK;
+        }
+        default:
+            return ERR_GENERAL_OUT_OF_RANGE;
+    }
+}
+
+// Converts an image into buffer, which is grown as needed and can be reused across calls, in the layout
+// of extensions_pixels_pack. pixels->data points into buffer rather than to memory of its own.
+inline int32_t extensions_pixels_convert(const opj_image_t* image,
+                                         const int32_t format,
+                                         const uint32_t flags,
+                                         std::vector<uint8_t>& buffer,
+                                         extensions_pixels_t* pixels)
+{
+    memset(pixels, 0, sizeof(extensions_pixels_t));
+
+    auto ret = format == EXTENSIONS_PIXEL_FORMAT_PLANAR ? extensions_pixels_check_planar(image) : ERR_OK;
+    if (ret != ERR_OK)
+        return ret;
+
+    uint32_t width, height, channels, bits;
+    ret = extensions_pixels_get_info(image, format, flags, &width, &height, &channels, &bits);
+    if (ret != ERR_OK)
+        return ret;
+
+    const auto length = (uint64_t)width * height * channels * (bits / 8);
+    if (buffer.size() < length)
+        buffer.resize(length);
+
+    if (format == EXTENSIONS_PIXEL_FORMAT_PLANAR)
+        extensions_pixels_write_planar(image, buffer.data());
+    else
+        ret = extensions_pixels_export_rgb(image, format, flags, buffer.data(), (uint64_t)width * channels);
+    if (ret != ERR_OK)
+        return ret;
+
+    pixels->data = buffer.data();
+    pixels->length = length;
+    pixels->width = width;
+    pixels->height = height;
+    pixels->channels = channels;
+    pixels->bits = bits;
+    return ERR_OK;
+}
+
+// A decoded tile widened to int32 planes and wrapped in an image, so that it can be converted on its own.
+// Component origins are those of the tile in the output, so subsampled components line up as they do in
+// the whole image, but bilinear upsampling does not reach into the neighbouring tiles.
+typedef struct extensions_pixels_tile_image
+{
+    opj_image_t image;
+    std::vector<opj_image_comp_t> comps;
+    std::vector<std::vector<int32_t>> planes;
+} extensions_pixels_tile_image_t;
+
+inline void extensions_pixels_tile_image_set(extensions_pixels_tile_image_t* tile_image,
+                                             const extensions_decoder_t* decoder,
+                                             const extensions_tile_t& tile)
+{
+    const auto header = decoder->header;
+    tile_image->comps.resize(header->numcomps);
+    tile_image->planes.resize(header->numcomps);
+
+    memset(&tile_image->image, 0, sizeof(opj_image_t));
+    tile_image->image.numcomps = header->numcomps;
+    tile_image->image.color_space = header->color_space;
+    tile_image->image.comps = tile_image->comps.data();
+
+    for (uint32_t compno = 0; compno < header->numcomps; compno++)
+    {
+        const auto rect = extensions_decoder_get_comp_rect(decoder, compno);
+        const auto& tile_comp = tile.comps[compno];
+        const auto count = (uint64_t)tile_comp.w * tile_comp.h;
+        auto& plane = tile_image->planes[compno];
+        if (plane.size() < count)
+            plane.resize(count);
+
+        for (uint32_t y = 0; y < tile_comp.h; y++)
+        {
+            const auto src = tile_comp.data + (uint64_t)y * tile_comp.stride * tile_comp.sample_size;
+            const auto dst = plane.data() + (uint64_t)y * tile_comp.w;
+            if (tile_comp.sample_size == 4)
+                memcpy(dst, src, tile_comp.w * sizeof(int32_t));
+            else
+                extensions_simd_widen(src, tile_comp.sample_size, tile_comp.sample_size, tile_comp.sgnd != 0, false, dst, tile_comp.w);
+        }
+
+        const auto& source = extensions_decoder_get_comp(decoder, compno);
+        auto& comp = tile_image->comps[compno];
+        memset(&comp, 0, sizeof(opj_image_comp_t));
+        comp.dx = source.dx;
+        comp.dy = source.dy;
+        comp.w = tile_comp.w;
+        comp.h = tile_comp.h;
+        comp.x0 = rect.x0 + tile_comp.x0;
+        comp.y0 = rect.y0 + tile_comp.y0;
+        comp.prec = source.prec;
+        comp.sgnd = source.sgnd;
+        comp.factor = decoder->reduce;
+        comp.alpha = decoder->channels[compno].alpha;
+        comp.data = plane.data();
+    }
+}
+
+// Some components of a decoded output laid out as a raw raster in one of the EXTENSIONS_BAND_LAYOUT_*, rescaled to
+// an EXTENSIONS_SAMPLE_* type. Tiles are written into it as they are decoded, so the int32 planes of the whole
+// image never exist.
+typedef struct extensions_pixels_raster
+{
+    uint8_t* data;
+    std::vector<uint32_t> compnos;
+    int32_t layout;
+    int32_t sample_type;
+    uint32_t sample_bytes;
+    uint32_t width;
+    uint32_t height;
+    uint64_t length;
+} extensions_pixels_raster_t;
+
+// Null bands means every component in order. All bands must share the same grid. data is left to the caller.
+inline int32_t extensions_pixels_raster_init(extensions_pixels_raster_t* raster,
+                                             const extensions_decoder_t* decoder,
+                                             const uint32_t* bands,
+                                             const uint32_t num_bands,
+                                             const int32_t layout,
+                                             const int32_t sample_type)
+{
+    const auto header = decoder->header;
+    const auto count = bands != nullptr ? num_bands : header->numcomps;
+    raster->data = nullptr;
+    raster->layout = layout;
+    raster->sample_type = sample_type;
+    raster->sample_bytes = extensions_pixels_get_sample_bytes(sample_type);
+    if (count == 0 || raster->sample_bytes == 0 ||
+        (layout != EXTENSIONS_BAND_LAYOUT_BSQ && layout != EXTENSIONS_BAND_LAYOUT_BIL && layout != EXTENSIONS_BAND_LAYOUT_BIP))
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    raster->compnos.resize(count);
+    for (uint32_t band = 0; band < count; band++)
+    {
+        const auto compno = bands != nullptr ? bands[band] : band;
+        if (compno >= header->numcomps)
+            return ERR_GENERAL_OUT_OF_RANGE;
+
+        const auto& comp = extensions_decoder_get_comp(decoder, compno);
+        const auto& first = extensions_decoder_get_comp(decoder, raster->compnos[0]);
+        if (comp.prec == 0 || comp.prec > 31 || (band > 0 && (comp.dx != first.dx || comp.dy != first.dy)))
+            return ERR_GENERAL_OUT_OF_RANGE;
+
+        raster->compnos[band] = compno;
+    }
+
+    const auto rect = extensions_decoder_get_comp_rect(decoder, raster->compnos[0]);
+    if (rect.w == 0 || rect.h == 0)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    raster->width = rect.w;
+    raster->height = rect.h;
+    raster->length = (uint64_t)rect.w * rect.h * count * raster->sample_bytes;
+    return ERR_OK;
+}
+
+inline uint64_t extensions_pixels_raster_get_offset(const extensions_pixels_raster_t* raster, const uint32_t band, const uint32_t x, const uint32_t y)
+{
+    const uint64_t count = raster->compnos.size();
+    switch (raster->layout)
+    {
+        case EXTENSIONS_BAND_LAYOUT_BSQ:
+            return (((uint64_t)band * raster->height + y) * raster->width + x) * raster->sample_bytes;
+        case EXTENSIONS_BAND_LAYOUT_BIL:
+            return (((uint64_t)y * count + band) * raster->width + x) * raster->sample_bytes;
+        default:
+            return (((uint64_t)y * raster->width + x) * count + band) * raster->sample_bytes;
+    }
+}
+
+// Writes a tile placed in the output of the decoder the raster was laid out for. wide and scaled are rows of
+// scratch kept by the caller, one pair per thread.
+inline void extensions_pixels_raster_write_tile(const extensions_pixels_raster_t* raster,
+                                                const extensions_decoder_t* decoder,
+                                                const extensions_tile_t& tile,
+                                                std::vector<int32_t>& wide,
+                                                std::vector<uint8_t>& scaled)
+{
+    const auto count = (uint32_t)raster->compnos.size();
+    const auto step = raster->layout == EXTENSIONS_BAND_LAYOUT_BIP ? (uint64_t)raster->sample_bytes * count : raster->sample_bytes;
+
+    for (uint32_t band = 0; band < count; band++)
+    {
+        const auto compno = raster->compnos[band];
+        const auto& comp = extensions_decoder_get_comp(decoder, compno);
+        const auto& tile_comp = tile.comps[compno];
+        if (tile_comp.w == 0 || tile_comp.h == 0)
+            continue;
+
+        if (wide.size() < tile_comp.w)
+            wide.resize(tile_comp.w);
+        if (scaled.size() < (uint64_t)tile_comp.w * raster->sample_bytes)
+            scaled.resize((uint64_t)tile_comp.w * raster->sample_bytes);
+
+        for (uint32_t y = 0; y < tile_comp.h; y++)
+        {
+            const auto src = tile_comp.data + (uint64_t)y * tile_comp.stride * tile_comp.sample_size;
+            if (tile_comp.sample_size == 4)
+                memcpy(wide.data(), src, tile_comp.w * sizeof(int32_t));
+            else
+                extensions_simd_widen(src, tile_comp.sample_size, tile_comp.sample_size, tile_comp.sgnd != 0, false, wide.data(), tile_comp.w);
+
+            const auto dst = raster->data + extensions_pixels_raster_get_offset(raster, band, tile_comp.x0, tile_comp.y0 + y);
+            if (step == raster->sample_bytes)
+            {
+                extensions_pixels_scale_row(wide.data(), raster->sample_type, dst, tile_comp.w, comp.prec, comp.sgnd != 0);
+            }
+            else
+            {
+                extensions_pixels_scale_row(wide.data(), raster->sample_type, scaled.data(), tile_comp.w, comp.prec, comp.sgnd != 0);
+                extensions_pixels_scatter_row(scaled.data(), dst, tile_comp.w, step, raster->sample_bytes);
+            }
+        }
+    }
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_PIXELS_H_
\ No newline at end of file
@@ -0,0 +1 @@
+#include "extensions.pool.hpp"
\ No newline at end of file
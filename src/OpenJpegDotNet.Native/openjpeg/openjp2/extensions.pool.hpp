@@ -0,0 +1,100 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_POOL_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_POOL_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.decode.hpp"
+
+// The pool and the helpers creating and recycling images through it live in extensions.decode.hpp, so that
+// the decode modules can take their output from a pool.
+
+DLLEXPORT extensions_image_pool_t* openjpeg_openjp2_extensions_image_pool_new(const uint64_t max_bytes)
+{
+    auto pool = new extensions_image_pool_t();
+    pool->references = 1;
+    pool->max_bytes = max_bytes;
+    pool->pooled_bytes = 0;
+    pool->pooled_images = 0;
+    pool->hits = 0;
+    pool->misses = 0;
+    return pool;
+}
+
+DLLEXPORT void openjpeg_openjp2_extensions_image_pool_trim(extensions_image_pool_t* pool)
+{
+    extensions_image_pool_trim(pool);
+}
+
+// Sequences created with the pool keep it alive until they are deleted as well
+DLLEXPORT void openjpeg_openjp2_extensions_image_pool_delete(extensions_image_pool_t* pool)
+{
+    extensions_image_pool_drop(pool);
+}
+
+// Same contract as openjpeg_openjp2_opj_image_create, but a pooled image of the same shape is reused when
+// available. The planes of a reused image are not cleared.
+DLLEXPORT opj_image_t* openjpeg_openjp2_extensions_image_pool_acquire(extensions_image_pool_t* pool,
+                                                                      const uint32_t numcmpts,
+                                                                      opj_image_cmptparm_t** cmptparms,
+                                                                      const uint32_t cmptparms_len,
+                                                                      const OPJ_COLOR_SPACE clrspc)
+{
+    if (numcmpts == 0 || numcmpts > cmptparms_len)
+        return nullptr;
+
+    std::vector<opj_image_cmptparm_t> compparams(numcmpts);
+    for (uint32_t index = 0; index < numcmpts; index++) compparams[index] = *(cmptparms[index]);
+
+    return extensions_image_pool_create(pool, numcmpts, compparams.data(), clrspc);
+}
+
+// Returns an image to the pool. Any opj_image_t may be released, including one produced by opj_decode;
+// its planes are then recycled for later requests of the same shape. Images beyond max_bytes are destroyed.
+DLLEXPORT void openjpeg_openjp2_extensions_image_pool_release(extensions_image_pool_t* pool,
+                                                              opj_image_t* image)
+{
+    extensions_image_pool_recycle(pool, image);
+}
+
+DLLEXPORT void openjpeg_openjp2_extensions_image_pool_get_stats(extensions_image_pool_t* pool,
+                                                                uint64_t* hits,
+                                                                uint64_t* misses,
+                                                                uint64_t* pooled_images,
+                                                                uint64_t* pooled_bytes)
+{
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    *hits = pool->hits;
+    *misses = pool->misses;
+    *pooled_images = pool->pooled_images;
+    *pooled_bytes = pool->pooled_bytes;
+}
+
+// Same as openjpeg_openjp2_extensions_decode_memory, but the image is taken from the pool when one of the
+// same shape is available, so it is best handed back with openjpeg_openjp2_extensions_image_pool_release.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_image_pool_decode_memory(extensions_image_pool_t* pool,
+                                                                       const uint8_t* data,
+                                                                       const uint64_t data_len,
+                                                                       const uint32_t reduce,
+                                                                       const uint32_t layers,
+                                                                       const int32_t x0,
+                                                                       const int32_t y0,
+                                                                       const int32_t x1,
+                                                                       const int32_t y1,
+                                                                       const int32_t num_threads,
+                                                                       const extensions_cancel_token_t* token,
+                                                                       opj_image_t** image)
+{
+    extensions_decode_options_t options;
+    options.reduce = reduce;
+    options.layers = layers;
+    options.x0 = x0;
+    options.y0 = y0;
+    options.x1 = x1;
+    options.y1 = y1;
+    options.num_threads = num_threads;
+    options.token = token;
+
+    return extensions_decode_image(data, data_len, &options, image, pool);
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_POOL_H_
\ No newline at end of file
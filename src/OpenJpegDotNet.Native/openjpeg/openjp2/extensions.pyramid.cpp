@@ -0,0 +1 @@
+#include "extensions.pyramid.hpp"
\ No newline at end of file
@@ -0,0 +1,282 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_PYRAMID_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_PYRAMID_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.decode.hpp"
+#include "extensions.pixels.hpp"
+#include "extensions.simd.hpp"
+
+// Builds every zoom level of an image from a single decode, for tile servers. The coarser levels are 2x2 box
+// averages of the int32 planes of the level above, on the same grid as a decode with one more reduce would
+// have, instead of a decode per reduce each running the whole codestream through tier-1 again.
+
+// Rows of one reduce work unit
+#define EXTENSIONS_PYRAMID_ROWS 16
+
+// One tile of one level. column and row place it in the grid of tile_size tiles of its level, x and y in pixels.
+// Rows follow each other without padding; planar components follow each other.
+typedef struct extensions_pyramid_tile
+{
+    uint32_t level;
+    uint32_t column;
+    uint32_t row;
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+    uint32_t bits;
+    const uint8_t* data;
+    uint64_t length;
+} extensions_pyramid_tile_t;
+
+// The pixels are only valid during the call. Returning anything but ERR_OK stops the pyramid and that value
+// is returned.
+typedef int32_t (*extensions_pyramid_callback)(const extensions_pyramid_tile_t* tile, void* user_data);
+
+// Averages row y of the reduced component from the rows and columns of the component above that it covers.
+// Samples past the edges of the component above are replaced by the nearest ones inside, so an edge sample
+// is the average of the samples that exist.
+inline void extensions_pyramid_reduce_row(const opj_image_comp_t& src, const opj_image_comp_t& dst, const uint32_t y)
+{
+    const auto clamp = [](const uint64_t value, const uint32_t origin, const uint32_t size)
+    {
+        return (uint32_t)(std::min<uint64_t>(std::max<uint64_t>(value, origin), (uint64_t)origin + size - 1) - origin);
+    };
+
+    const auto row = 2 * ((uint64_t)dst.y0 + y);
+    const auto top = src.data + (uint64_t)clamp(row, src.y0, src.h) * src.w;
+    const auto bottom = src.data + (uint64_t)clamp(row + 1, src.y0, src.h) * src.w;
+    auto out = dst.data + (uint64_t)y * dst.w;
+
+    // The first and last samples may cover a column past the edge; those in between cover two inside
+    const uint32_t first = 2 * (uint64_t)dst.x0 < src.x0 ? 1 : 0;
+    auto last = 2 * ((uint64_t)dst.x0 + dst.w - 1) + 1 >= (uint64_t)src.x0 + src.w ? dst.w - 1 : dst.w;
+    last = std::max(first, last);
+
+    const auto edge = [&](const uint32_t x)
+    {
+        const auto column = 2 * ((uint64_t)dst.x0 + x);
+        const auto left = clamp(column, src.x0, src.w);
+        const auto right = clamp(column + 1, src.x0, src.w);
+        const auto sum = (int64_t)top[left] + top[right] + bottom[left] + bottom[right];
+        out[x] = (int32_t)((sum + 2) >> 2);
+    };
+
+    for (uint32_t x = 0; x < first && x < dst.w; x++)
+        edge(x);
+
+    if (last > first)
+    {
+        const auto offset = 2 * ((uint64_t)dst.x0 + first) - src.x0;
+        extensions_simd_reduce_rows(top + offset, bottom + offset, out + first, last - first, src.prec <= 29);
+    }
+
+    for (auto x = last; x < dst.w; x++)
+        edge(x);
+}
+
+// On the reference grid a level can come out empty, such as a single row at an odd origin
+inline bool extensions_pyramid_can_reduce(const opj_image_t* image)
+{
+    for (uint32_t compno = 0; compno < image->numcomps; compno++)
+    {
+        const auto& comp = image->comps[compno];
+        if (extensions_ceildiv(comp.x0 + comp.w, 2) <= extensions_ceildiv(comp.x0, 2) ||
+            extensions_ceildiv(comp.y0 + comp.h, 2) <= extensions_ceildiv(comp.y0, 2))
+            return false;
+    }
+
+    return true;
+}
+
+// Creates the next level of image, on the grid of a decode with one more reduce
+inline opj_image_t* extensions_pyramid_reduce(const opj_image_t* image, const int32_t num_threads)
+{
+    std::vector<opj_image_cmptparm_t> cmptparms(image->numcomps);
+    for (uint32_t compno = 0; compno < image->numcomps; compno++)
+    {
+        const auto& comp = image->comps[compno];
+        auto& cmptparm = cmptparms[compno];
+        memset(&cmptparm, 0, sizeof(opj_image_cmptparm_t));
+        cmptparm.dx = comp.dx;
+        cmptparm.dy = comp.dy;
+        cmptparm.x0 = extensions_ceildiv(comp.x0, 2);
+        cmptparm.y0 = extensions_ceildiv(comp.y0, 2);
+        cmptparm.w = extensions_ceildiv(comp.x0 + comp.w, 2) - cmptparm.x0;
+        cmptparm.h = extensions_ceildiv(comp.y0 + comp.h, 2) - cmptparm.y0;
+        cmptparm.prec = comp.prec;
+        cmptparm.sgnd = comp.sgnd;
+    }
+
+    auto reduced = ::opj_image_create(image->numcomps, cmptparms.data(), image->color_space);
+    if (reduced == nullptr)
+        return nullptr;
+
+    reduced->x0 = image->x0;
+    reduced->y0 = image->y0;
+    reduced->x1 = image->x1;
+    reduced->y1 = image->y1;
+
+    std::vector<std::pair<uint32_t, uint32_t>> units;
+    for (uint32_t compno = 0; compno < image->numcomps; compno++)
+    {
+        reduced->comps[compno].factor = image->comps[compno].factor + 1;
+        reduced->comps[compno].alpha = image->comps[compno].alpha;
+        for (uint32_t y = 0; y < reduced->comps[compno].h; y += EXTENSIONS_PYRAMID_ROWS)
+            units.emplace_back(compno, y);
+    }
+
+    extensions_pixels_parallel((uint32_t)units.size(), num_threads, [&](const uint32_t unit)
+    {
+        const auto compno = units[unit].first;
+        const auto& dst = reduced->comps[compno];
+        const auto y1 = std::min(dst.h, units[unit].second + EXTENSIONS_PYRAMID_ROWS);
+        for (auto y = units[unit].second; y < y1; y++)
+            extensions_pyramid_reduce_row(image->comps[compno], dst, y);
+    });
+
+    return reduced;
+}
+
+// Cuts converted pixels into tiles of tile_size and hands them to callback, row by row
+inline int32_t extensions_pyramid_emit(const extensions_pixels_t* pixels,
+                                       const bool planar,
+                                       const uint32_t level,
+                                       const uint32_t tile_size,
+                                       const extensions_cancel_token_t* token,
+                                       std::vector<uint8_t>& buffer,
+                                       const extensions_pyramid_callback callback,
+                                       void* user_data)
+{
+    // Planar pixels hold one plane per channel, interleaved ones a single plane of whole pixels
+    const auto sample_bytes = pixels->bits / 8;
+    const auto planes = planar ? pixels->channels : 1;
+    const auto pixel_bytes = planar ? sample_bytes : sample_bytes * pixels->channels;
+    const auto plane_bytes = (uint64_t)pixels->width * pixels->height * pixel_bytes;
+
+    for (uint32_t y = 0, row = 0; y < pixels->height; y += tile_size, row++)
+    {
+        for (uint32_t x = 0, column = 0; x < pixels->width; x += tile_size, column++)
+        {
+            const auto ret = extensions_cancel_token_check(token);
+            if (ret != ERR_OK)
+                return ret;
+
+            extensions_pyramid_tile_t tile;
+            tile.level = level;
+            tile.column = column;
+            tile.row = row;
+            tile.x = x;
+            tile.y = y;
+            tile.width = std::min(tile_size, pixels->width - x);
+            tile.height = std::min(tile_size, pixels->height - y);
+            tile.channels = pixels->channels;
+            tile.bits = pixels->bits;
+            tile.length = (uint64_t)tile.width * tile.height * pixel_bytes * planes;
+            if (buffer.size() < tile.length)
+                buffer.resize(tile.length);
+
+            const auto row_bytes = (uint64_t)tile.width * pixel_bytes;
+            auto dst = buffer.data();
+            for (uint32_t plane = 0; plane < planes; plane++)
+            {
+                const auto src = pixels->data + plane_bytes * plane + ((uint64_t)y * pixels->width + x) * pixel_bytes;
+                for (uint32_t line = 0; line < tile.height; line++, dst += row_bytes)
+                    memcpy(dst, src + (uint64_t)line * pixels->width * pixel_bytes, (size_t)row_bytes);
+            }
+
+            tile.data = buffer.data();
+            const auto callback_ret = callback(&tile, user_data);
+            if (callback_ret != ERR_OK)
+                return callback_ret;
+        }
+    }
+
+    return ERR_OK;
+}
+
+// Decodes a JPEG 2000 codestream or JP2 file held in memory once at reduce and calls callback with the tiles of
+// that level and of the coarser ones, each converted to format as in openjpeg_openjp2_extensions_tiles_decode,
+// from the finest level to the coarsest. level counts from the full resolution, so the first one is reduce.
+// levels is how many levels to produce at most; zero means until a whole level fits in one tile. The decode runs
+// on up to num_decoders codecs, each handed num_threads, which also bounds the threads reducing a level.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_pyramid_decode(const uint8_t* data,
+                                                             const uint64_t data_len,
+                                                             const uint32_t reduce,
+                                                             const uint32_t layers,
+                                                             const uint32_t levels,
+                                                             const uint32_t tile_size,
+                                                             const int32_t format,
+                                                             const uint32_t flags,
+                                                             const uint32_t num_decoders,
+                                                             const int32_t num_threads,
+                                                             const extensions_cancel_token_t* token,
+                                                             const extensions_pyramid_callback callback,
+                                                             void* user_data)
+{
+    if (tile_size == 0 || callback == nullptr)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    extensions_decode_options_t options;
+    options.reduce = reduce;
+    options.layers = layers;
+    options.x0 = 0;
+    options.y0 = 0;
+    options.x1 = 0;
+    options.y1 = 0;
+    options.num_threads = num_threads;
+    options.token = token;
+
+    extensions_decoder_t decoder;
+    auto ret = extensions_decoder_open(&decoder, data, data_len, &options);
+    if (ret != ERR_OK)
+        return ret;
+
+    auto image = extensions_decoder_create_image(&decoder);
+    if (image == nullptr)
+    {
+        extensions_decoder_close(&decoder);
+        return ERR_GENERAL_MEMALLOC;
+    }
+
+    ret = extensions_decoder_decode_bands(&decoder, &options, num_decoders, [image](const extensions_tile_t& tile, const uint32_t)
+    {
+        extensions_tile_copy_to_image(tile, image);
+        return ERR_OK;
+    });
+    extensions_decoder_close(&decoder);
+
+    std::vector<uint8_t> converted;
+    std::vector<uint8_t> buffer;
+    for (uint32_t level = 0; ret == ERR_OK && (levels == 0 || level < levels); level++)
+    {
+        extensions_pixels_t pixels;
+        ret = extensions_pixels_convert(image, format, flags, converted, &pixels);
+        if (ret != ERR_OK)
+            break;
+
+        ret = extensions_pyramid_emit(&pixels, format == EXTENSIONS_PIXEL_FORMAT_PLANAR, reduce + level, tile_size, token,
+                                      buffer, callback, user_data);
+        if (ret != ERR_OK)
+            break;
+
+        const auto last = levels == 0 ? pixels.width <= tile_size && pixels.height <= tile_size
+                                      : level + 1 == levels;
+        if (last || !extensions_pyramid_can_reduce(image))
+            break;
+
+        const auto reduced = extensions_pyramid_reduce(image, num_threads);
+        ::opj_image_destroy(image);
+        image = reduced;
+        if (image == nullptr)
+            ret = ERR_GENERAL_MEMALLOC;
+    }
+
+    if (image != nullptr)
+        ::opj_image_destroy(image);
+    return ret;
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_PYRAMID_H_
\ No newline at end of file
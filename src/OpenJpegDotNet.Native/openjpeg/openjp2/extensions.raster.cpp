@@ -0,0 +1 @@
+#include "extensions.raster.hpp"
\ No newline at end of file
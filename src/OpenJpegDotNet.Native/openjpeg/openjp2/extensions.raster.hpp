@@ -0,0 +1,320 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_RASTER_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_RASTER_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.decode.hpp"
+#include "extensions.pixels.hpp"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <string>
+
+// Decodes straight into a raw raster, either a file mapped into memory or a buffer of the caller, instead of
+// into the int32 planes of an opj_image_t that is converted afterwards. Each codec holds one tile of samples
+// at a time, so the peak is the output itself plus a tile per codec.
+
+#ifdef _WIN32
+inline std::wstring extensions_raster_get_wide_path(const std::string& path)
+{
+    const auto path_len = ::MultiByteToWideChar(CP_UTF8, 0, path.c_str(), (int)path.size(), nullptr, 0);
+    std::wstring wide(path_len, L'\0');
+    ::MultiByteToWideChar(CP_UTF8, 0, path.c_str(), (int)path.size(), &wide[0], path_len);
+    return wide;
+}
+#endif
+
+inline void extensions_raster_remove_file(const std::string& path)
+{
+#ifdef _WIN32
+    ::DeleteFileW(extensions_raster_get_wide_path(path).c_str());
+#else
+    ::unlink(path.c_str());
+#endif
+}
+
+// Creates or truncates the file at path, allocates length bytes for it and maps it for writing.
+// The file is removed again when it cannot be sized or mapped.
+inline int32_t extensions_raster_map_file(const std::string& path, const uint64_t length, uint8_t** data)
+{
+    *data = nullptr;
+    if (length > (uint64_t)SIZE_MAX)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+#ifdef _WIN32
+    const auto file = ::CreateFileW(extensions_raster_get_wide_path(path).c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+                                    CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return ERR_GENERAL_FILE_IO;
+
+    // Mapping more than the file holds extends it; the view keeps the mapping and the file open on its own
+    const auto mapping = ::CreateFileMappingW(file, nullptr, PAGE_READWRITE, (DWORD)(length >> 32), (DWORD)length, nullptr);
+    ::CloseHandle(file);
+    if (mapping == nullptr)
+    {
+        extensions_raster_remove_file(path);
+        return ERR_GENERAL_FILE_IO;
+    }
+
+    const auto view = ::MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0);
+    ::CloseHandle(mapping);
+    if (view == nullptr)
+    {
+        extensions_raster_remove_file(path);
+        return ERR_GENERAL_FILE_IO;
+    }
+
+    *data = (uint8_t*)view;
+    return ERR_OK;
+#else
+    const auto fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return ERR_GENERAL_FILE_IO;
+
+    // The blocks are reserved up front, so a full disk fails here rather than as SIGBUS on a store into a sparse
+    // mapping in the middle of the decode
+#ifdef __APPLE__
+    fstore_t store = { F_ALLOCATEALL, F_PEOFPOSMODE, 0, (off_t)length, 0 };
+    const auto allocated = ::fcntl(fd, F_PREALLOCATE, &store) != -1 && ::ftruncate(fd, (off_t)length) == 0;
+#else
+    const auto allocated = ::posix_fallocate(fd, 0, (off_t)length) == 0;
+#endif
+    if (!allocated)
+    {
+        ::close(fd);
+        extensions_raster_remove_file(path);
+        return ERR_GENERAL_FILE_IO;
+    }
+
+    const auto view = ::mmap(nullptr, (size_t)length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED)
+    {
+        extensions_raster_remove_file(path);
+        return ERR_GENERAL_FILE_IO;
+    }
+
+    *data = (uint8_t*)view;
+    return ERR_OK;
+#endif
+}
+
+inline void extensions_raster_unmap_file(uint8_t* data, const uint64_t length)
+{
+#ifdef _WIN32
+    (void)length;
+    ::UnmapViewOfFile(data);
+#else
+    ::munmap(data, (size_t)length);
+#endif
+}
+
+// Decodes a JPEG 2000 codestream or JP2 file held in memory into a headerless raster file at path, given in
+// UTF-8, with the bands and layout of openjpeg_openjp2_extensions_export_bands. Zero area means the whole image
+// and token can be null. Tiles are decoded by up to num_decoders codecs at once, each handed num_threads.
+// The file is removed again when the decode fails.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_raster_decode_file(const uint8_t* data,
+                                                                 const uint64_t data_len,
+                                                                 const uint32_t reduce,
+                                                                 const uint32_t layers,
+                                                                 const int32_t x0,
+                                                                 const int32_t y0,
+                                                                 const int32_t x1,
+                                                                 const int32_t y1,
+                                                                 const uint32_t* bands,
+                                                                 const uint32_t num_bands,
+                                                                 const int32_t layout,
+                                                                 const int32_t sample_type,
+                                                                 const char* path,
+                                                                 const uint32_t path_len,
+                                                                 const uint32_t num_decoders,
+                                                                 const int32_t num_threads,
+                                                                 const extensions_cancel_token_t* token,
+                                                                 uint32_t* width,
+                                                                 uint32_t* height)
+{
+    *width = 0;
+    *height = 0;
+
+    extensions_decode_options_t options;
+    options.reduce = reduce;
+    options.layers = layers;
+    options.x0 = x0;
+    options.y0 = y0;
+    options.x1 = x1;
+    options.y1 = y1;
+    options.num_threads = num_threads;
+    options.token = token;
+
+    extensions_decoder_t decoder;
+    auto ret = extensions_decoder_open(&decoder, data, data_len, &options);
+    if (ret != ERR_OK)
+        return ret;
+
+    extensions_pixels_raster_t raster;
+    ret = extensions_pixels_raster_init(&raster, &decoder, bands, num_bands, layout, sample_type);
+    if (ret != ERR_OK)
+    {
+        extensions_decoder_close(&decoder);
+        return ret;
+    }
+
+    const std::string file_path(path, path_len);
+    ret = extensions_raster_map_file(file_path, raster.length, &raster.data);
+    if (ret != ERR_OK)
+    {
+        extensions_decoder_close(&decoder);
+        return ret;
+    }
+
+    const auto slots = std::max(num_decoders, 1u);
+    std::vector<std::vector<int32_t>> wide(slots);
+    std::vector<std::vector<uint8_t>> scaled(slots);
+    ret = extensions_decoder_decode_bands(&decoder, &options, num_decoders, [&](const extensions_tile_t& tile, const uint32_t slot)
+    {
+        extensions_pixels_raster_write_tile(&raster, &decoder, tile, wide[slot], scaled[slot]);
+        return ERR_OK;
+    });
+
+    extensions_raster_unmap_file(raster.data, raster.length);
+    extensions_decoder_close(&decoder);
+
+    if (ret != ERR_OK)
+    {
+        extensions_raster_remove_file(file_path);
+        return ret;
+    }
+
+    *width = raster.width;
+    *height = raster.height;
+    return ERR_OK;
+}
+
+// Size of the raster openjpeg_openjp2_extensions_raster_decode_memory writes for the same arguments
+DLLEXPORT int32_t openjpeg_openjp2_extensions_raster_get_info(const uint8_t* data,
+                                                              const uint64_t data_len,
+                                                              const uint32_t reduce,
+                                                              const int32_t x0,
+                                                              const int32_t y0,
+                                                              const int32_t x1,
+                                                              const int32_t y1,
+                                                              const uint32_t* bands,
+                                                              const uint32_t num_bands,
+                                                              const int32_t sample_type,
+                                                              uint32_t* width,
+                                                              uint32_t* height,
+                                                              uint64_t* length)
+{
+    *width = 0;
+    *height = 0;
+    *length = 0;
+
+    extensions_decode_options_t options;
+    options.reduce = reduce;
+    options.layers = 0;
+    options.x0 = x0;
+    options.y0 = y0;
+    options.x1 = x1;
+    options.y1 = y1;
+    options.num_threads = 0;
+    options.token = nullptr;
+
+    extensions_decoder_t decoder;
+    auto ret = extensions_decoder_open(&decoder, data, data_len, &options);
+    if (ret != ERR_OK)
+        return ret;
+
+    extensions_pixels_raster_t raster;
+    ret = extensions_pixels_raster_init(&raster, &decoder, bands, num_bands, EXTENSIONS_BAND_LAYOUT_BIP, sample_type);
+    extensions_decoder_close(&decoder);
+    if (ret != ERR_OK)
+        return ret;
+
+    *width = raster.width;
+    *height = raster.height;
+    *length = raster.length;
+    return ERR_OK;
+}
+
+// Same as openjpeg_openjp2_extensions_raster_decode_file, but into dst, which must be aligned to the sample
+// size and hold the whole raster. A single band of uint8 or uint16 is a plain grayscale bitmap and every
+// component in BIP is an interleaved one.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_raster_decode_memory(const uint8_t* data,
+                                                                   const uint64_t data_len,
+                                                                   const uint32_t reduce,
+                                                                   const uint32_t layers,
+                                                                   const int32_t x0,
+                                                                   const int32_t y0,
+                                                                   const int32_t x1,
+                                                                   const int32_t y1,
+                                                                   const uint32_t* bands,
+                                                                   const uint32_t num_bands,
+                                                                   const int32_t layout,
+                                                                   const int32_t sample_type,
+                                                                   uint8_t* dst,
+                                                                   const uint64_t dst_len,
+                                                                   const uint32_t num_decoders,
+                                                                   const int32_t num_threads,
+                                                                   const extensions_cancel_token_t* token,
+                                                                   uint32_t* width,
+                                                                   uint32_t* height)
+{
+    *width = 0;
+    *height = 0;
+
+    extensions_decode_options_t options;
+    options.reduce = reduce;
+    options.layers = layers;
+    options.x0 = x0;
+    options.y0 = y0;
+    options.x1 = x1;
+    options.y1 = y1;
+    options.num_threads = num_threads;
+    options.token = token;
+
+    extensions_decoder_t decoder;
+    auto ret = extensions_decoder_open(&decoder, data, data_len, &options);
+    if (ret != ERR_OK)
+        return ret;
+
+    extensions_pixels_raster_t raster;
+    ret = extensions_pixels_raster_init(&raster, &decoder, bands, num_bands, layout, sample_type);
+    if (ret == ERR_OK && (dst == nullptr || (uintptr_t)dst % raster.sample_bytes != 0 || dst_len < raster.length))
+        ret = ERR_GENERAL_OUT_OF_RANGE;
+    if (ret != ERR_OK)
+    {
+        extensions_decoder_close(&decoder);
+        return ret;
+    }
+
+    raster.data = dst;
+
+    const auto slots = std::max(num_decoders, 1u);
+    std::vector<std::vector<int32_t>> wide(slots);
+    std::vector<std::vector<uint8_t>> scaled(slots);
+    ret = extensions_decoder_decode_bands(&decoder, &options, num_decoders, [&](const extensions_tile_t& tile, const uint32_t slot)
+    {
+        extensions_pixels_raster_write_tile(&raster, &decoder, tile, wide[slot], scaled[slot]);
+        return ERR_OK;
+    });
+
+    extensions_decoder_close(&decoder);
+    if (ret != ERR_OK)
+        return ret;
+
+    *width = raster.width;
+    *height = raster.height;
+    return ERR_OK;
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_RASTER_H_
\ No newline at end of file
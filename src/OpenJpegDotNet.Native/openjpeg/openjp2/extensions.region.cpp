@@ -0,0 +1 @@
+#include "extensions.region.hpp"
\ No newline at end of file
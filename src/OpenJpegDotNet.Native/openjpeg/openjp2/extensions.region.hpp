@@ -0,0 +1,287 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_REGION_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_REGION_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.codestream.hpp"
+#include "extensions.decode.hpp"
+
+#include <mutex>
+#include <vector>
+
+// Serves repeated area and reduce decodes of one codestream. The header is parsed once when the region
+// decoder is created, so requests are checked without touching the codec.
+// OpenJPEG only allows opj_set_decode_area and opj_decode to be called again on the same codec when the
+// image is made of a single tile; such codecs keep the tile they have already read and are kept idle
+// between requests. Other codestreams get a new codec per request over the shared source bytes.
+
+// Codecs kept idle per region decoder, each holding the compressed tile it has read
+#define EXTENSIONS_REGION_MAX_IDLE 4
+
+typedef struct extensions_region_decoder
+{
+    std::mutex mutex;
+    extensions_source_t* source;
+    extensions_header_info_t info;
+    std::vector<extensions_header_comp_info_t> comps;
+    int32_t num_threads;
+    std::vector<extensions_decoder_t*> idle;
+    uint64_t decodes;
+    uint64_t reused;
+} extensions_region_decoder_t;
+
+inline void extensions_region_decoder_discard(extensions_decoder_t* decoder)
+{
+    extensions_decoder_close(decoder);
+    delete decoder;
+}
+
+// Takes an idle codec opened with the same reduce and layers, or opens a new one
+inline int32_t extensions_region_decoder_acquire(extensions_region_decoder_t* region,
+                                                 const extensions_decode_options_t* options,
+                                                 extensions_decoder_t** decoder)
+{
+    {
+        std::lock_guard<std::mutex> lock(region->mutex);
+        region->decodes++;
+        for (auto it = region->idle.begin(); it != region->idle.end(); ++it)
+        {
+            if ((*it)->reduce == options->reduce && (*it)->layers == options->layers)
+            {
+                *decoder = *it;
+                region->idle.erase(it);
+                region->reused++;
+                (*decoder)->source.token = options->token;
+                return ERR_OK;
+            }
+        }
+    }
+
+    // The whole image is opened; the area is set on every request
+    extensions_decode_options_t open_options = *options;
+    open_options.x0 = 0;
+    open_options.y0 = 0;
+    open_options.x1 = 0;
+    open_options.y1 = 0;
+
+    auto opened = new extensions_decoder_t();
+    const auto ret = extensions_decoder_open(opened, region->source->data, region->source->length, &open_options);
+    if (ret != ERR_OK)
+    {
+        delete opened;
+        return ret;
+    }
+
+    *decoder = opened;
+    return ERR_OK;
+}
+
+inline void extensions_region_decoder_recycle(extensions_region_decoder_t* region, extensions_decoder_t* decoder)
+{
+    decoder->source.token = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(region->mutex);
+        if (region->idle.size() < EXTENSIONS_REGION_MAX_IDLE)
+        {
+            region->idle.push_back(decoder);
+            return;
+        }
+    }
+
+    extensions_region_decoder_discard(decoder);
+}
+
+// Hands the planes decoded into the header of a single tile codec over to a new image in output order, leaving
+// the header empty for the next opj_decode
+inline opj_image_t* extensions_region_decoder_take_image(extensions_decoder_t* decoder)
+{
+    const auto header = decoder->header;
+    std::vector<opj_image_cmptparm_t> cmptparms(header->numcomps);
+    for (auto& cmptparm : cmptparms)
+    {
+        memset(&cmptparm, 0, sizeof(opj_image_cmptparm_t));
+        cmptparm.dx = 1;
+        cmptparm.dy = 1;
+        cmptparm.w = 1;
+        cmptparm.h = 1;
+    }
+
+    auto image = ::opj_image_create(header->numcomps, cmptparms.data(), header->color_space);
+    if (image == nullptr)
+        return nullptr;
+
+    image->x0 = header->x0;
+    image->y0 = header->y0;
+    image->x1 = header->x1;
+    image->y1 = header->y1;
+    for (uint32_t compno = 0; compno < header->numcomps; compno++)
+    {
+        auto& comp = header->comps[decoder->channels[compno].compno];
+        ::opj_image_data_free(image->comps[compno].data);
+        image->comps[compno] = comp;
+        image->comps[compno].alpha = decoder->channels[compno].alpha;
+        comp.data = nullptr;
+    }
+
+    if (!extensions_image_copy_icc_profile(image, header))
+    {
+        ::opj_image_destroy(image);
+        return nullptr;
+    }
+
+    return image;
+}
+
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/lib/openjp2/openjpeg.h (opj_set_decode_area)
+inline int32_t extensions_region_decoder_decode_single_tile(extensions_region_decoder_t* region,
+                                                            const extensions_decode_options_t* options,
+                                                            const uint32_t area[4],
+                                                            opj_image_t** image)
+{
+    extensions_decoder_t* decoder;
+    auto ret = extensions_region_decoder_acquire(region, options, &decoder);
+    if (ret != ERR_OK)
+        return ret;
+
+    ret = extensions_cancel_token_check(options->token);
+    if (ret == ERR_OK && !::opj_set_decode_area(decoder->codec, decoder->header, area[0], area[1], area[2], area[3]))
+        ret = ERR_GENERAL_OUT_OF_RANGE;
+    if (ret == ERR_OK && !::opj_decode(decoder->codec, decoder->stream, decoder->header))
+    {
+        ret = extensions_cancel_token_check(options->token);
+        if (ret == ERR_OK)
+            ret = ERR_IMAGE_DECODE_FAILED;
+    }
+    if (ret == ERR_OK)
+    {
+        *image = extensions_region_decoder_take_image(decoder);
+        if (*image == nullptr)
+            ret = ERR_GENERAL_MEMALLOC;
+    }
+
+    // A codec that failed part way cannot be trusted with another request
+    if (ret == ERR_OK)
+        extensions_region_decoder_recycle(region, decoder);
+    else
+        extensions_region_decoder_discard(decoder);
+
+    return ret;
+}
+
+// Parses the header of the source, which stays referenced until the region decoder is deleted.
+// Codestreams with a palette are refused like every other tile by tile decode.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_region_decoder_new(extensions_source_t* source,
+                                                                 const int32_t num_threads,
+                                                                 extensions_region_decoder_t** region)
+{
+    *region = nullptr;
+
+    extensions_header_info_t info;
+    auto ret = extensions_read_header_info(source->data, source->length, &info, nullptr, 0);
+    if (ret != ERR_OK)
+        return ret;
+
+    std::vector<extensions_header_comp_info_t> comps(info.numcomps);
+    ret = extensions_read_header_info(source->data, source->length, &info, comps.data(), info.numcomps);
+    if (ret != ERR_OK)
+        return ret;
+
+    if (info.format == OPJ_CODEC_JP2 && extensions_decoder_has_palette(source->data, source->length))
+        return ERR_IMAGE_FILE_INVALID;
+
+    auto decoder = new extensions_region_decoder_t();
+    extensions_source_retain(source);
+    decoder->source = source;
+    decoder->info = info;
+    decoder->comps = std::move(comps);
+    decoder->num_threads = num_threads;
+    decoder->decodes = 0;
+    decoder->reused = 0;
+    *region = decoder;
+    return ERR_OK;
+}
+
+DLLEXPORT void openjpeg_openjp2_extensions_region_decoder_delete(extensions_region_decoder_t* region)
+{
+    for (auto decoder : region->idle)
+        extensions_region_decoder_discard(decoder);
+    extensions_source_release(region->source);
+    delete region;
+}
+
+// Returns the header parsed when the region decoder was created. comps may be null.
+DLLEXPORT void openjpeg_openjp2_extensions_region_decoder_get_info(extensions_region_decoder_t* region,
+                                                                   extensions_header_info_t* info,
+                                                                   extensions_header_comp_info_t* comps,
+                                                                   const uint32_t comps_len)
+{
+    *info = region->info;
+    if (comps != nullptr)
+        memcpy(comps, region->comps.data(), std::min<uint32_t>(comps_len, region->info.numcomps) * sizeof(extensions_header_comp_info_t));
+}
+
+// Decodes an area of the reference grid at the given reduce into a new image to be released with
+// openjpeg_openjp2_opj_image_destroy. Zero area means the whole image and token can be null.
+// Requests may run at the same time from different threads.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_region_decoder_decode(extensions_region_decoder_t* region,
+                                                                    const uint32_t reduce,
+                                                                    const uint32_t layers,
+                                                                    const int32_t x0,
+                                                                    const int32_t y0,
+                                                                    const int32_t x1,
+                                                                    const int32_t y1,
+                                                                    const extensions_cancel_token_t* token,
+                                                                    opj_image_t** image)
+{
+    *image = nullptr;
+
+    const auto& info = region->info;
+    if (reduce >= info.numresolutions)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    uint32_t area[4] = { info.x0, info.y0, info.x1, info.y1 };
+    if (x0 != 0 || y0 != 0 || x1 != 0 || y1 != 0)
+    {
+        if (x0 < 0 || y0 < 0 || x1 <= x0 || y1 <= y0)
+            return ERR_GENERAL_OUT_OF_RANGE;
+
+        area[0] = std::max(area[0], (uint32_t)x0);
+        area[1] = std::max(area[1], (uint32_t)y0);
+        area[2] = std::min(area[2], (uint32_t)x1);
+        area[3] = std::min(area[3], (uint32_t)y1);
+        if (area[2] <= area[0] || area[3] <= area[1])
+            return ERR_GENERAL_OUT_OF_RANGE;
+    }
+
+    extensions_decode_options_t options;
+    options.reduce = reduce;
+    options.layers = layers;
+    options.x0 = (int32_t)area[0];
+    options.y0 = (int32_t)area[1];
+    options.x1 = (int32_t)area[2];
+    options.y1 = (int32_t)area[3];
+    options.num_threads = region->num_threads;
+    options.token = token;
+
+    if (info.tw == 1 && info.th == 1)
+        return extensions_region_decoder_decode_single_tile(region, &options, area, image);
+
+    {
+        std::lock_guard<std::mutex> lock(region->mutex);
+        region->decodes++;
+    }
+
+    return extensions_decode_image(region->source->data, region->source->length, &options, image);
+}
+
+// reused counts the requests served by a codec left idle by an earlier one
+DLLEXPORT void openjpeg_openjp2_extensions_region_decoder_get_stats(extensions_region_decoder_t* region,
+                                                                    uint64_t* decodes,
+                                                                    uint64_t* reused)
+{
+    std::lock_guard<std::mutex> lock(region->mutex);
+    *decodes = region->decodes;
+    *reused = region->reused;
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_REGION_H_
\ No newline at end of file
@@ -0,0 +1 @@
+#include "extensions.scheduler.hpp"
\ No newline at end of file
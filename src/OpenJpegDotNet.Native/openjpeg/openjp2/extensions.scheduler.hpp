@@ -0,0 +1,476 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_SCHEDULER_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_SCHEDULER_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.codestream.hpp"
+#include "extensions.decode.hpp"
+#include "extensions.pixels.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+// Decodes whole tiles of a shared source on worker threads in priority order, for viewers that pan and zoom.
+// Every request carries a generation; a request from a newer generation drops the queued work of the older
+// ones and cancels the tiles still decoding for them. Once the queue is empty, workers prefetch the
+// neighbours of the requested tiles at a coarser reduce.
+// Each worker keeps a codec per reduce open across tiles and reads them through opj_get_decoded_tile, which
+// seeks to the tile through the index the codec has built so far.
+
+// One decoded tile, or the failure to decode it when status is not ERR_OK. x and y place the tile in the
+// whole image decoded at the same reduce. Rows follow each other without padding; planar components follow
+// each other.
+typedef struct extensions_scheduler_tile
+{
+    uint32_t index;
+    uint32_t reduce;
+    uint64_t generation;
+    uint32_t prefetch;
+    int32_t status;
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+    uint32_t bits;
+    const uint8_t* data;
+    uint64_t length;
+} extensions_scheduler_tile_t;
+
+// Called on the worker threads, possibly at the same time. The pixels are only valid during the call.
+// Tiles cancelled by a newer generation are not delivered.
+typedef void (*extensions_scheduler_callback)(const extensions_scheduler_tile_t* tile, void* user_data);
+
+typedef struct extensions_scheduler_task
+{
+    uint32_t index;
+    uint32_t reduce;
+    uint64_t generation;
+    bool prefetch;
+} extensions_scheduler_task_t;
+
+typedef struct extensions_scheduler_worker
+{
+    extensions_cancel_token_t token;
+    bool busy;
+    uint64_t generation;
+    // Codecs opened over the source, one per reduce; a decoder must not move while it is open
+    std::vector<std::unique_ptr<extensions_decoder_t>> decoders;
+    std::vector<uint8_t> buffer;
+    std::vector<opj_image_comp_t> comps;
+    std::thread thread;
+} extensions_scheduler_worker_t;
+
+typedef struct extensions_scheduler
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    extensions_source_t* source;
+    extensions_header_info_t info;
+    std::vector<extensions_header_comp_info_t> comps;
+    int32_t format;
+    uint32_t flags;
+    int32_t num_threads;
+    uint32_t prefetch;
+    extensions_scheduler_callback callback;
+    void* user_data;
+    // Ordered by descending priority, then by submission
+    std::map<std::pair<int64_t, uint64_t>, extensions_scheduler_task_t> queue;
+    std::deque<extensions_scheduler_task_t> prefetch_queue;
+    // Tiles and reduces already queued or decoded in the current generation
+    std::set<uint64_t> seen;
+    std::vector<std::unique_ptr<extensions_scheduler_worker_t>> workers;
+    uint64_t generation;
+    uint64_t sequence;
+    uint32_t running;
+    bool closed;
+    uint64_t decoded;
+    uint64_t prefetched;
+    uint64_t dropped;
+    uint64_t cancelled;
+    uint64_t failed;
+} extensions_scheduler_t;
+
+inline uint64_t extensions_scheduler_get_key(const uint32_t index, const uint32_t reduce)
+{
+    return ((uint64_t)reduce << 32) | index;
+}
+
+inline void extensions_scheduler_close_decoders(extensions_scheduler_worker_t* worker)
+{
+    for (auto& decoder : worker->decoders)
+        extensions_decoder_close(decoder.get());
+    worker->decoders.clear();
+}
+
+// Must be called with the mutex held
+inline void extensions_scheduler_advance(extensions_scheduler_t* scheduler, const uint64_t generation)
+{
+    scheduler->generation = generation;
+    scheduler->dropped += scheduler->queue.size() + scheduler->prefetch_queue.size();
+    scheduler->queue.clear();
+    scheduler->prefetch_queue.clear();
+    scheduler->seen.clear();
+
+    for (auto& worker : scheduler->workers)
+        if (worker->busy && worker->generation < generation)
+            worker->token.cancelled = true;
+}
+
+// Must be called with the mutex held. Returns false when there is nothing left to do.
+inline bool extensions_scheduler_take(extensions_scheduler_t* scheduler, extensions_scheduler_task_t* task)
+{
+    if (!scheduler->queue.empty())
+    {
+        *task = scheduler->queue.begin()->second;
+        scheduler->queue.erase(scheduler->queue.begin());
+        return true;
+    }
+
+    while (!scheduler->prefetch_queue.empty())
+    {
+        *task = scheduler->prefetch_queue.front();
+        scheduler->prefetch_queue.pop_front();
+        if (scheduler->seen.insert(extensions_scheduler_get_key(task->index, task->reduce)).second)
+            return true;
+    }
+
+    return false;
+}
+
+// Must be called with the mutex held
+inline void extensions_scheduler_queue_neighbours(extensions_scheduler_t* scheduler, const extensions_scheduler_task_t& task)
+{
+    const auto& info = scheduler->info;
+    const auto reduce = std::min(task.reduce + scheduler->prefetch, info.numresolutions - 1);
+    const auto tx = (int64_t)(task.index % info.tw);
+    const auto ty = (int64_t)(task.index / info.tw);
+    for (int64_t y = ty - 1; y <= ty + 1; y++)
+    {
+        for (int64_t x = tx - 1; x <= tx + 1; x++)
+        {
+            if (x < 0 || y < 0 || x >= info.tw || y >= info.th || (x == tx && y == ty))
+                continue;
+
+            extensions_scheduler_task_t neighbour;
+            neighbour.index = (uint32_t)(y * info.tw + x);
+            neighbour.reduce = reduce;
+            neighbour.generation = task.generation;
+            neighbour.prefetch = true;
+            scheduler->prefetch_queue.push_back(neighbour);
+        }
+    }
+}
+
+inline extensions_decoder_t* extensions_scheduler_get_decoder(extensions_scheduler_t* scheduler,
+                                                              extensions_scheduler_worker_t* worker,
+                                                              const uint32_t reduce,
+                                                              int32_t* ret)
+{
+    *ret = ERR_OK;
+    for (auto& decoder : worker->decoders)
+        if (decoder->reduce == reduce)
+            return decoder.get();
+
+    extensions_decode_options_t options;
+    options.reduce = reduce;
+    options.layers = 0;
+    options.x0 = 0;
+    options.y0 = 0;
+    options.x1 = 0;
+    options.y1 = 0;
+    options.num_threads = scheduler->num_threads;
+    options.token = &worker->token;
+
+    std::unique_ptr<extensions_decoder_t> decoder(new extensions_decoder_t());
+    *ret = extensions_decoder_open(decoder.get(), scheduler->source->data, scheduler->source->length, &options);
+    if (*ret != ERR_OK)
+        return nullptr;
+
+    worker->decoders.push_back(std::move(decoder));
+    return worker->decoders.back().get();
+}
+
+inline int32_t extensions_scheduler_decode(extensions_scheduler_t* scheduler,
+                                           extensions_scheduler_worker_t* worker,
+                                           extensions_scheduler_tile_t* tile)
+{
+    int32_t ret;
+    const auto decoder = extensions_scheduler_get_decoder(scheduler, worker, tile->reduce, &ret);
+    if (decoder == nullptr)
+        return ret;
+
+    const auto header = decoder->header;
+    if (!::opj_get_decoded_tile(decoder->codec, decoder->stream, header, tile->index))
+    {
+        // The codec may have stopped part way through the tile and cannot be trusted any more
+        for (auto it = worker->decoders.begin(); it != worker->decoders.end(); ++it)
+        {
+            if (it->get() == decoder)
+            {
+                extensions_decoder_close(decoder);
+                worker->decoders.erase(it);
+                break;
+            }
+        }
+
+        ret = extensions_cancel_token_check(&worker->token);
+        return ret != ERR_OK ? ret : ERR_IMAGE_DECODE_FAILED;
+    }
+
+    // Convert a view of the header with the components in output order, placed by the tile bounds in reduced
+    // component coordinates like the tile decode does
+    const auto& info = scheduler->info;
+    const auto tx = tile->index % info.tw;
+    const auto ty = tile->index / info.tw;
+    const auto tile_x0 = std::max(info.tx0 + tx * info.tdx, info.x0);
+    const auto tile_y0 = std::max(info.ty0 + ty * info.tdy, info.y0);
+    worker->comps.resize(header->numcomps);
+    for (uint32_t compno = 0; compno < header->numcomps; compno++)
+    {
+        auto& comp = worker->comps[compno];
+        comp = extensions_decoder_get_comp(decoder, compno);
+        comp.x0 = extensions_ceildivpow2(extensions_ceildiv(tile_x0, comp.dx), tile->reduce);
+        comp.y0 = extensions_ceildivpow2(extensions_ceildiv(tile_y0, comp.dy), tile->reduce);
+        comp.alpha = decoder->channels[compno].alpha;
+    }
+
+    auto image = *header;
+    image.comps = worker->comps.data();
+
+    uint32_t refno = 0;
+    if (scheduler->format != EXTENSIONS_PIXEL_FORMAT_PLANAR)
+    {
+        const auto color = extensions_pixels_get_color(&image, scheduler->flags);
+        ret = extensions_pixels_get_grid(&image, extensions_pixels_get_color_comps(color), &refno);
+        if (ret != ERR_OK)
+            return ret;
+    }
+
+    extensions_pixels_t pixels;
+    ret = extensions_pixels_convert(&image, scheduler->format, scheduler->flags, worker->buffer, &pixels);
+    if (ret != ERR_OK)
+        return ret;
+
+    const auto& ref = image.comps[refno];
+    tile->x = ref.x0 - extensions_ceildivpow2(extensions_ceildiv(info.x0, ref.dx), tile->reduce);
+    tile->y = ref.y0 - extensions_ceildivpow2(extensions_ceildiv(info.y0, ref.dy), tile->reduce);
+    tile->width = pixels.width;
+    tile->height = pixels.height;
+    tile->channels = pixels.channels;
+    tile->bits = pixels.bits;
+    tile->data = pixels.data;
+    tile->length = pixels.length;
+    return ERR_OK;
+}
+
+inline void extensions_scheduler_work(extensions_scheduler_t* scheduler, extensions_scheduler_worker_t* worker)
+{
+    std::unique_lock<std::mutex> lock(scheduler->mutex);
+    while (true)
+    {
+        extensions_scheduler_task_t task;
+        scheduler->changed.wait(lock, [scheduler, &task]
+        {
+            return scheduler->closed || extensions_scheduler_take(scheduler, &task);
+        });
+        if (scheduler->closed)
+            break;
+
+        worker->busy = true;
+        worker->generation = task.generation;
+        worker->token.cancelled = false;
+        scheduler->running++;
+        lock.unlock();
+
+        extensions_scheduler_tile_t tile;
+        memset(&tile, 0, sizeof(extensions_scheduler_tile_t));
+        tile.index = task.index;
+        tile.reduce = task.reduce;
+        tile.generation = task.generation;
+        tile.prefetch = task.prefetch ? 1 : 0;
+        tile.status = extensions_scheduler_decode(scheduler, worker, &tile);
+
+        // A tile finished after its generation went stale is dropped as well
+        const auto cancelled = tile.status == ERR_GENERAL_CANCELLED || worker->token.cancelled;
+        if (!cancelled)
+            scheduler->callback(&tile, scheduler->user_data);
+
+        lock.lock();
+        worker->busy = false;
+        scheduler->running--;
+        if (cancelled)
+            scheduler->cancelled++;
+        else if (tile.status != ERR_OK)
+            scheduler->failed++;
+        else if (task.prefetch)
+            scheduler->prefetched++;
+        else
+            scheduler->decoded++;
+        scheduler->changed.notify_all();
+    }
+
+    lock.unlock();
+    extensions_scheduler_close_decoders(worker);
+}
+
+// Tiles are converted to format with flags as in openjpeg_openjp2_extensions_export_pixels.
+// num_threads is handed to each codec. prefetch is how many levels coarser neighbours are prefetched at;
+// zero disables prefetching. The source stays referenced until the scheduler is deleted.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_scheduler_new(extensions_source_t* source,
+                                                            const uint32_t num_workers,
+                                                            const int32_t num_threads,
+                                                            const int32_t format,
+                                                            const uint32_t flags,
+                                                            const uint32_t prefetch,
+                                                            const extensions_scheduler_callback callback,
+                                                            void* user_data,
+                                                            extensions_scheduler_t** scheduler)
+{
+    *scheduler = nullptr;
+    if (num_workers == 0 || callback == nullptr)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    extensions_header_info_t info;
+    auto ret = extensions_read_header_info(source->data, source->length, &info, nullptr, 0);
+    if (ret != ERR_OK)
+        return ret;
+
+    std::vector<extensions_header_comp_info_t> comps(info.numcomps);
+    ret = extensions_read_header_info(source->data, source->length, &info, comps.data(), info.numcomps);
+    if (ret != ERR_OK)
+        return ret;
+    if (info.numresolutions == 0 || info.tw == 0 || info.th == 0)
+        return ERR_IMAGE_FILE_INVALID;
+
+    auto created = new extensions_scheduler_t();
+    extensions_source_retain(source);
+    created->source = source;
+    created->info = info;
+    created->comps = std::move(comps);
+    created->format = format;
+    created->flags = flags;
+    created->num_threads = num_threads;
+    created->prefetch = prefetch;
+    created->callback = callback;
+    created->user_data = user_data;
+    created->generation = 0;
+    created->sequence = 0;
+    created->running = 0;
+    created->closed = false;
+    created->decoded = 0;
+    created->prefetched = 0;
+    created->dropped = 0;
+    created->cancelled = 0;
+    created->failed = 0;
+
+    for (uint32_t index = 0; index < num_workers; index++)
+    {
+        std::unique_ptr<extensions_scheduler_worker_t> worker(new extensions_scheduler_worker_t());
+        worker->token.cancelled = false;
+        worker->token.has_deadline = false;
+        worker->busy = false;
+        worker->generation = 0;
+        created->workers.push_back(std::move(worker));
+    }
+
+    // Workers are started once the list is complete, since advancing a generation walks it
+    for (auto& worker : created->workers)
+        worker->thread = std::thread(extensions_scheduler_work, created, worker.get());
+
+    *scheduler = created;
+    return ERR_OK;
+}
+
+// Cancels the tiles in progress, waits for the workers and releases the source
+DLLEXPORT void openjpeg_openjp2_extensions_scheduler_delete(extensions_scheduler_t* scheduler)
+{
+    {
+        std::lock_guard<std::mutex> lock(scheduler->mutex);
+        scheduler->closed = true;
+        for (auto& worker : scheduler->workers)
+            worker->token.cancelled = true;
+        scheduler->changed.notify_all();
+    }
+
+    for (auto& worker : scheduler->workers)
+        worker->thread.join();
+
+    extensions_source_release(scheduler->source);
+    delete scheduler;
+}
+
+// Queues a tile, higher priorities first. A generation newer than the current one drops everything queued
+// for the older ones first; an older one is refused with ERR_GENERAL_CANCELLED. A tile already queued or
+// decoded at the same reduce in the current generation is not queued again.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_scheduler_submit(extensions_scheduler_t* scheduler,
+                                                               const uint32_t tile_index,
+                                                               const uint32_t reduce,
+                                                               const int32_t priority,
+                                                               const uint64_t generation)
+{
+    const auto& info = scheduler->info;
+    if (tile_index >= info.tw * info.th || reduce >= info.numresolutions)
+        return ERR_GENERAL_OUT_OF_RANGE;
+
+    std::lock_guard<std::mutex> lock(scheduler->mutex);
+    if (generation < scheduler->generation)
+        return ERR_GENERAL_CANCELLED;
+    if (generation > scheduler->generation)
+        extensions_scheduler_advance(scheduler, generation);
+
+    extensions_scheduler_task_t task;
+    task.index = tile_index;
+    task.reduce = reduce;
+    task.generation = generation;
+    task.prefetch = false;
+    if (!scheduler->seen.insert(extensions_scheduler_get_key(tile_index, reduce)).second)
+        return ERR_OK;
+
+    scheduler->queue.emplace(std::make_pair(-(int64_t)priority, scheduler->sequence++), task);
+    if (scheduler->prefetch > 0)
+        extensions_scheduler_queue_neighbours(scheduler, task);
+
+    scheduler->changed.notify_all();
+    return ERR_OK;
+}
+
+// Drops the queued work of the generations before this one and cancels their tiles in progress
+DLLEXPORT void openjpeg_openjp2_extensions_scheduler_advance(extensions_scheduler_t* scheduler, const uint64_t generation)
+{
+    std::lock_guard<std::mutex> lock(scheduler->mutex);
+    if (generation > scheduler->generation)
+        extensions_scheduler_advance(scheduler, generation);
+}
+
+// Blocks until nothing is queued, prefetches included, and no tile is decoding
+DLLEXPORT void openjpeg_openjp2_extensions_scheduler_wait(extensions_scheduler_t* scheduler)
+{
+    std::unique_lock<std::mutex> lock(scheduler->mutex);
+    scheduler->changed.wait(lock, [scheduler]
+    {
+        return scheduler->queue.empty() && scheduler->prefetch_queue.empty() && scheduler->running == 0;
+    });
+}
+
+DLLEXPORT void openjpeg_openjp2_extensions_scheduler_get_stats(extensions_scheduler_t* scheduler,
+                                                               uint64_t* decoded,
+                                                               uint64_t* prefetched,
+                                                               uint64_t* dropped,
+                                                               uint64_t* cancelled,
+                                                               uint64_t* failed)
+{
+    std::lock_guard<std::mutex> lock(scheduler->mutex);
+    *decoded = scheduler->decoded;
+    *prefetched = scheduler->prefetched;
+    *dropped = scheduler->dropped;
+    *cancelled = scheduler->cancelled;
+    *failed = scheduler->failed;
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_SCHEDULER_H_
\ No newline at end of file
@@ -0,0 +1 @@
+#include "extensions.sequence.hpp"
\ No newline at end of file
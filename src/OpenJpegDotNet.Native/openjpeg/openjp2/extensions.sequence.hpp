@@ -0,0 +1,309 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_SEQUENCE_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_SEQUENCE_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.decode.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Decodes a sequence of codestreams, e.g. the frames of a Digital Cinema Package, through a pipeline.
+// A reader thread parses the main header of the next frames while decoder threads decode the current ones,
+// and frames come out in submission order. A fixed set of slots bounds the pipeline: each slot keeps its
+// input buffer and its decoded image across frames, so a steady stream of same-shaped frames does not allocate.
+typedef struct extensions_sequence_slot
+{
+    uint64_t index;
+    std::vector<uint8_t> data;
+    extensions_decoder_t decoder;
+    opj_image_t* image;
+    int32_t status;
+} extensions_sequence_slot_t;
+
+typedef struct extensions_sequence
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<std::unique_ptr<extensions_sequence_slot_t>> slots;
+    std::vector<extensions_sequence_slot_t*> free_slots;
+    std::deque<extensions_sequence_slot_t*> parse_queue;
+    std::deque<extensions_sequence_slot_t*> decode_queue;
+    std::map<uint64_t, extensions_sequence_slot_t*> done;
+    std::vector<extensions_sequence_slot_t*> delivered;
+    std::vector<std::thread> threads;
+    extensions_decode_options_t options;
+    extensions_image_pool_t* pool;
+    uint64_t next_push;
+    uint64_t next_pop;
+    uint32_t callers;
+    bool finished;
+    bool closed;
+} extensions_sequence_t;
+
+// Every API call counts itself in callers while it is inside the sequence, so delete can wake the ones blocked
+// in a wait through closed and free the sequence only once the last one has left. Both are called with the
+// mutex held; leave notifies before the mutex is released because delete may free the sequence right after.
+inline void extensions_sequence_enter(extensions_sequence_t* sequence)
+{
+    sequence->callers++;
+}
+
+inline void extensions_sequence_leave(extensions_sequence_t* sequence)
+{
+    sequence->callers--;
+    sequence->changed.notify_all();
+}
+
+inline void extensions_sequence_read(extensions_sequence_t* sequence)
+{
+    while (true)
+    {
+        extensions_sequence_slot_t* slot;
+        {
+            std::unique_lock<std::mutex> lock(sequence->mutex);
+            sequence->changed.wait(lock, [sequence] { return sequence->closed || !sequence->parse_queue.empty(); });
+            if (sequence->closed)
+                return;
+
+            slot = sequence->parse_queue.front();
+            sequence->parse_queue.pop_front();
+        }
+
+        slot->status = extensions_decoder_open(&slot->decoder, slot->data.data(), slot->data.size(), &sequence->options);
+
+        {
+            std::lock_guard<std::mutex> lock(sequence->mutex);
+            sequence->decode_queue.push_back(slot);
+        }
+        sequence->changed.notify_all();
+    }
+}
+
+inline void extensions_sequence_decode(extensions_sequence_t* sequence)
+{
+    // Each decoder thread keeps its own tile buffer for the lifetime of the sequence
+    std::vector<uint8_t> buffer;
+
+    while (true)
+    {
+        extensions_sequence_slot_t* slot;
+        {
+            std::unique_lock<std::mutex> lock(sequence->mutex);
+            sequence->changed.wait(lock, [sequence] { return sequence->closed || !sequence->decode_queue.empty(); });
+            if (sequence->closed)
+                return;
+
+            slot = sequence->decode_queue.front();
+            sequence->decode_queue.pop_front();
+        }
+
+        if (slot->status == ERR_OK)
+        {
+            if (!extensions_decoder_image_matches(&slot->decoder, slot->image))
+            {
+                extensions_image_pool_recycle(sequence->pool, slot->image);
+                slot->image = extensions_decoder_create_image(&slot->decoder, sequence->pool);
+            }
+
+            if (slot->image == nullptr)
+            {
+                slot->status = ERR_GENERAL_MEMALLOC;
+            }
+            else
+            {
+                const auto image = slot->image;
+                image->color_space = slot->decoder.header->color_space;
+                slot->status = extensions_decoder_decode_tiles(&slot->decoder, buffer, [image](const extensions_tile_t& tile)
+                {
+                    extensions_tile_copy_to_image(tile, image);
+                    return ERR_OK;
+                });
+            }
+        }
+
+        extensions_decoder_close(&slot->decoder);
+
+        {
+            std::lock_guard<std::mutex> lock(sequence->mutex);
+            sequence->done[slot->index] = slot;
+        }
+        sequence->changed.notify_all();
+    }
+}
+
+// The images of the slots are taken from pool and handed back to it when they change shape or the sequence
+// is deleted. pool can be null; otherwise the sequence keeps a reference on it.
+DLLEXPORT extensions_sequence_t* openjpeg_openjp2_extensions_sequence_new(const uint32_t reduce,
+                                                                           const uint32_t layers,
+                                                                           const uint32_t queue_depth,
+                                                                           const int32_t decode_threads,
+                                                                           const int32_t codec_threads,
+                                                                           extensions_image_pool_t* pool)
+{
+    auto sequence = new extensions_sequence_t();
+    memset(&sequence->options, 0, sizeof(extensions_decode_options_t));
+    sequence->options.reduce = reduce;
+    sequence->options.layers = layers;
+    sequence->options.num_threads = codec_threads;
+    sequence->pool = pool;
+    if (pool != nullptr)
+        extensions_image_pool_retain(pool);
+    sequence->next_push = 0;
+    sequence->next_pop = 0;
+    sequence->callers = 0;
+    sequence->finished = false;
+    sequence->closed = false;
+
+    const auto workers = std::max(1, decode_threads);
+    const auto depth = std::max<uint32_t>(queue_depth, (uint32_t)workers + 1);
+    for (uint32_t index = 0; index < depth; index++)
+    {
+        std::unique_ptr<extensions_sequence_slot_t> slot(new extensions_sequence_slot_t());
+        slot->image = nullptr;
+        slot->index = 0;
+        slot->status = ERR_OK;
+        sequence->free_slots.push_back(slot.get());
+        sequence->slots.push_back(std::move(slot));
+    }
+
+    sequence->threads.emplace_back(extensions_sequence_read, sequence);
+    for (int32_t index = 0; index < workers; index++)
+        sequence->threads.emplace_back(extensions_sequence_decode, sequence);
+
+    return sequence;
+}
+
+// Calls blocked in push or pop on other threads return once the sequence is closed; delete waits for them
+// to leave before freeing it. No call may be made after delete returns.
+DLLEXPORT void openjpeg_openjp2_extensions_sequence_delete(extensions_sequence_t* sequence)
+{
+    {
+        std::unique_lock<std::mutex> lock(sequence->mutex);
+        sequence->closed = true;
+        sequence->changed.notify_all();
+        sequence->changed.wait(lock, [sequence] { return sequence->callers == 0; });
+    }
+
+    for (auto& thread : sequence->threads)
+        thread.join();
+
+    for (auto& slot : sequence->slots)
+    {
+        extensions_decoder_close(&slot->decoder);
+        extensions_image_pool_recycle(sequence->pool, slot->image);
+    }
+
+    if (sequence->pool != nullptr)
+        extensions_image_pool_drop(sequence->pool);
+    delete sequence;
+}
+
+// Copies the codestream into a free slot. Blocks while every slot is in flight or held by the caller,
+// so frames must be popped and released from another thread than the one pushing them.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_sequence_push(extensions_sequence_t* sequence,
+                                                            const uint8_t* data,
+                                                            const uint64_t data_len)
+{
+    extensions_sequence_slot_t* slot;
+    {
+        std::unique_lock<std::mutex> lock(sequence->mutex);
+        if (sequence->finished || sequence->closed)
+            return ERR_GENERAL_OUT_OF_RANGE;
+
+        extensions_sequence_enter(sequence);
+        sequence->changed.wait(lock, [sequence] { return sequence->closed || !sequence->free_slots.empty(); });
+        if (sequence->closed)
+        {
+            extensions_sequence_leave(sequence);
+            return ERR_GENERAL_OUT_OF_RANGE;
+        }
+
+        slot = sequence->free_slots.back();
+        sequence->free_slots.pop_back();
+        slot->index = sequence->next_push++;
+    }
+
+    slot->data.assign(data, data + data_len);
+    slot->status = ERR_OK;
+
+    std::lock_guard<std::mutex> lock(sequence->mutex);
+    sequence->parse_queue.push_back(slot);
+    extensions_sequence_leave(sequence);
+    return ERR_OK;
+}
+
+// Tells the sequence that no more frames will be pushed, so pop reports the end once the last one is out
+DLLEXPORT void openjpeg_openjp2_extensions_sequence_finish(extensions_sequence_t* sequence)
+{
+    std::lock_guard<std::mutex> lock(sequence->mutex);
+    extensions_sequence_enter(sequence);
+    sequence->finished = true;
+    extensions_sequence_leave(sequence);
+}
+
+// Waits for the next frame in submission order. The image stays owned by the sequence and must be handed
+// back with openjpeg_openjp2_extensions_sequence_release. A frame that failed to decode returns its error
+// and no image; ERR_GENERAL_END_OF_DATA is returned once every pushed frame has been popped after finish,
+// or once the sequence is closed by delete.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_sequence_pop(extensions_sequence_t* sequence,
+                                                           opj_image_t** image,
+                                                           uint64_t* frame_index)
+{
+    *image = nullptr;
+    *frame_index = 0;
+
+    std::unique_lock<std::mutex> lock(sequence->mutex);
+    extensions_sequence_enter(sequence);
+    sequence->changed.wait(lock, [sequence]
+    {
+        return sequence->closed ||
+               sequence->done.count(sequence->next_pop) != 0 ||
+               (sequence->finished && sequence->next_pop == sequence->next_push);
+    });
+
+    const auto it = sequence->done.find(sequence->next_pop);
+    if (sequence->closed || it == sequence->done.end())
+    {
+        extensions_sequence_leave(sequence);
+        return ERR_GENERAL_END_OF_DATA;
+    }
+
+    const auto slot = it->second;
+    sequence->done.erase(it);
+    *frame_index = sequence->next_pop++;
+
+    const auto status = slot->status;
+    if (status == ERR_OK)
+    {
+        *image = slot->image;
+        sequence->delivered.push_back(slot);
+    }
+    else
+    {
+        sequence->free_slots.push_back(slot);
+    }
+
+    extensions_sequence_leave(sequence);
+    return status;
+}
+
+DLLEXPORT void openjpeg_openjp2_extensions_sequence_release(extensions_sequence_t* sequence, opj_image_t* image)
+{
+    std::lock_guard<std::mutex> lock(sequence->mutex);
+    extensions_sequence_enter(sequence);
+    const auto it = std::find_if(sequence->delivered.begin(), sequence->delivered.end(),
+                                 [image](const extensions_sequence_slot_t* slot) { return slot->image == image; });
+    if (it != sequence->delivered.end())
+    {
+        sequence->free_slots.push_back(*it);
+        sequence->delivered.erase(it);
+    }
+    extensions_sequence_leave(sequence);
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_SEQUENCE_H_
\ No newline at end of file
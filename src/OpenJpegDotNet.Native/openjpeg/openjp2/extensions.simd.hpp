@@ -0,0 +1,871 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_SIMD_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_SIMD_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// Row kernels used by the pixel export and import paths. Each kernel has an SSE2 or NEON body selected at
+// compile time and a scalar tail that produces bit-identical results, so the output does not depend on
+// the build. Color conversions are done in single precision and rounded half up after clamping.
+// Kernels that gain from AVX2 also carry an AVX2 body, chosen at run time on CPUs that support it.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EXTENSIONS_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(ENABLE_NEON) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define EXTENSIONS_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(EXTENSIONS_SIMD_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define EXTENSIONS_SIMD_AVX2
+#define EXTENSIONS_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(EXTENSIONS_SIMD_SSE2) && defined(_MSC_VER)
+#define EXTENSIONS_SIMD_AVX2
+#define EXTENSIONS_SIMD_TARGET_AVX2
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+#if defined(EXTENSIONS_SIMD_AVX2)
+inline bool extensions_simd_has_avx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    static const bool supported = []
+    {
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        // The OS must save the YMM registers as well
+        __cpuid(info, 1);
+        if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+    }();
+#else
+    static const bool supported = __builtin_cpu_supports("avx2") != 0;
+#endif
+    return supported;
+}
+#endif
+
+inline int32_t extensions_simd_round(const float value, const float max)
+{
+    return (int32_t)(std::min(max, std::max(0.0f, value)) + 0.5f);
+}
+
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/bin/common/color.c (sycc_to_rgb)
+// Converts one row of Y, Cb, Cr samples of the given precision to R, G, B in place.
+inline void extensions_simd_sycc_to_rgb(int32_t* y, int32_t* cb, int32_t* cr, const uint32_t count, const uint32_t prec)
+{
+    const auto offset = (float)(1 << (prec - 1));
+    const auto max = (float)((1u << prec) - 1);
+    uint32_t index = 0;
+
+#if defined(EXTENSIONS_SIMD_SSE2)
+    const auto v_offset = _mm_set1_ps(offset);
+    const auto v_max = _mm_set1_ps(max);
+    const auto v_zero = _mm_setzero_ps();
+    const auto v_half = _mm_set1_ps(0.5f);
+    for (; index + 4 <= count; index += 4)
+    {
+        const auto vy = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(y + index)));
+        const auto vcb = _mm_sub_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(cb + index))), v_offset);
+        const auto vcr = _mm_sub_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(cr + index))), v_offset);
+        auto r = _mm_add_ps(vy, _mm_mul_ps(_mm_set1_ps(1.402f), vcr));
+        auto g = _mm_sub_ps(_mm_sub_ps(vy, _mm_mul_ps(_mm_set1_ps(0.344f), vcb)), _mm_mul_ps(_mm_set1_ps(0.714f), vcr));
+        auto b = _mm_add_ps(vy, _mm_mul_ps(_mm_set1_ps(1.772f), vcb));
+        r = _mm_add_ps(_mm_min_ps(v_max, _mm_max_ps(v_zero, r)), v_half);
+        g = _mm_add_ps(_mm_min_ps(v_max, _mm_max_ps(v_zero, g)), v_half);
+        b = _mm_add_ps(_mm_min_ps(v_max, _mm_max_ps(v_zero, b)), v_half);
+        _mm_storeu_si128((__m128i*)(y + index), _mm_cvttps_epi32(r));
+        _mm_storeu_si128((__m128i*)(cb + index), _mm_cvttps_epi32(g));
+        _mm_storeu_si128((__m128i*)(cr + index), _mm_cvttps_epi32(b));
+    }
+#elif defined(EXTENSIONS_SIMD_NEON)
+    const auto v_offset = vdupq_n_f32(offset);
+    const auto v_max = vdupq_n_f32(max);
+    const auto v_zero = vdupq_n_f32(0.0f);
+    const auto v_half = vdupq_n_f32(0.5f);
+    for (; index + 4 <= count; index += 4)
+    {
+        const auto vy = vcvtq_f32_s32(vld1q_s32(y + index));
+        const auto vcb = vsubq_f32(vcvtq_f32_s32(vld1q_s32(cb + index)), v_offset);
+        const auto vcr = vsubq_f32(vcvtq_f32_s32(vld1q_s32(cr + index)), v_offset);
+        auto r = vaddq_f32(vy, vmulq_f32(vdupq_n_f32(1.402f), vcr));
+        auto g = vsubq_f32(vsubq_f32(vy, vmulq_f32(vdupq_n_f32(0.344f), vcb)), vmulq_f32(vdupq_n_f32(0.714f), vcr));
+        auto b = vaddq_f32(vy, vmulq_f32(vdupq_n_f32(1.772f), vcb));
+        r = vaddq_f32(vminq_f32(v_max, vmaxq_f32(v_zero, r)), v_half);
+        g = vaddq_f32(vminq_f32(v_max, vmaxq_f32(v_zero, g)), v_half);
+        b = vaddq_f32(vminq_f32(v_max, vmaxq_f32(v_zero, b)), v_half);
+        vst1q_s32(y + index, vcvtq_s32_f32(r));
+        vst1q_s32(cb + index, vcvtq_s32_f32(g));
+        vst1q_s32(cr + index, vcvtq_s32_f32(b));
+    }
+#endif
+
+    for (; index < count; index++)
+    {
+        const auto fy = (float)y[index];
+        const auto fcb = (float)cb[index] - offset;
+        const auto fcr = (float)cr[index] - offset;
+        y[index] = extensions_simd_round(fy + 1.402f * fcr, max);
+        cb[index] = extensions_simd_round(fy - 0.344f * fcb - 0.714f * fcr, max);
+        cr[index] = extensions_simd_round(fy + 1.772f * fcb, max);
+    }
+}
+
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/bin/common/color.c (opj_convert_eycc_to_rgb)
+// Chroma samples coded as unsigned are recentred first, as in opj_decompress.
+inline void extensions_simd_eycc_to_rgb(int32_t* y,
+                                        int32_t* cb,
+                                        int32_t* cr,
+                                        const uint32_t count,
+                                        const uint32_t prec,
+                                        const bool sgnd_y,
+                                        const bool sgnd_cb,
+                                        const bool sgnd_cr)
+{
+    const auto flip = (float)(1 << (prec - 1));
+    const auto offset_y = sgnd_y ? flip : 0.0f;
+    const auto offset_cb = sgnd_cb ? 0.0f : flip;
+    const auto offset_cr = sgnd_cr ? 0.0f : flip;
+    const auto max = (float)((1u << prec) - 1);
+    uint32_t index = 0;
+
+#if defined(EXTENSIONS_SIMD_SSE2)
+    const auto v_offset_y = _mm_set1_ps(offset_y);
+    const auto v_offset_cb = _mm_set1_ps(offset_cb);
+    const auto v_offset_cr = _mm_set1_ps(offset_cr);
+    const auto v_max = _mm_set1_ps(max);
+    const auto v_zero = _mm_setzero_ps();
+    const auto v_half = _mm_set1_ps(0.5f);
+    for (; index + 4 <= count; index += 4)
+    {
+        const auto vy = _mm_add_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(y + index))), v_offset_y);
+        const auto vcb = _mm_sub_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(cb + index))), v_offset_cb);
+        const auto vcr = _mm_sub_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(cr + index))), v_offset_cr);
+        auto r = _mm_add_ps(_mm_sub_ps(vy, _mm_mul_ps(_mm_set1_ps(0.0000368f), vcb)), _mm_mul_ps(_mm_set1_ps(1.40199f), vcr));
+        auto g = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(_mm_set1_ps(1.0003f), vy), _mm_mul_ps(_mm_set1_ps(0.344125f), vcb)), _mm_mul_ps(_mm_set1_ps(0.7141128f), vcr));
+        auto b = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(0.999823f), vy), _mm_mul_ps(_mm_set1_ps(1.77204f), vcb)), _mm_mul_ps(_mm_set1_ps(0.000008f), vcr));
+        r = _mm_add_ps(_mm_min_ps(v_max, _mm_max_ps(v_zero, r)), v_half);
+        g = _mm_add_ps(_mm_min_ps(v_max, _mm_max_ps(v_zero, g)), v_half);
+        b = _mm_add_ps(_mm_min_ps(v_max, _mm_max_ps(v_zero, b)), v_half);
+        _mm_storeu_si128((__m128i*)(y + index), _mm_cvttps_epi32(r));
+        _mm_storeu_si128((__m128i*)(cb + index), _mm_cvttps_epi32(g));
+        _mm_storeu_si128((__m128i*)(cr + index), _mm_cvttps_epi32(b));
+    }
+#elif defined(EXTENSIONS_SIMD_NEON)
+    const auto v_offset_y = vdupq_n_f32(offset_y);
+    const auto v_offset_cb = vdupq_n_f32(offset_cb);
+    const auto v_offset_cr = vdupq_n_f32(offset_cr);
+    const auto v_max = vdupq_n_f32(max);
+    const auto v_zero = vdupq_n_f32(0.0f);
+    const auto v_half = vdupq_n_f32(0.5f);
+    for (; index + 4 <= count; index += 4)
+    {
+        const auto vy = vaddq_f32(vcvtq_f32_s32(vld1q_s32(y + index)), v_offset_y);
+        const auto vcb = vsubq_f32(vcvtq_f32_s32(vld1q_s32(cb + index)), v_offset_cb);
+        const auto vcr = vsubq_f32(vcvtq_f32_s32(vld1q_s32(cr + index)), v_offset_cr);
+        auto r = vaddq_f32(vsubq_f32(vy, vmulq_f32(vdupq_n_f32(0.0000368f), vcb)), vmulq_f32(vdupq_n_f32(1.40199f), vcr));
+        auto g = vsubq_f32(vsubq_f32(vmulq_f32(vdupq_n_f32(1.0003f), vy), vmulq_f32(vdupq_n_f32(0.344125f), vcb)), vmulq_f32(vdupq_n_f32(0.7141128f), vcr));
+        auto b = vsubq_f32(vaddq_f32(vmulq_f32(vdupq_n_f32(0.999823f), vy), vmulq_f32(vdupq_n_f32(1.77204f), vcb)), vmulq_f32(vdupq_n_f32(0.000008f), vcr));
+        r = vaddq_f32(vminq_f32(v_max, vmaxq_f32(v_zero, r)), v_half);
+        g = vaddq_f32(vminq_f32(v_max, vmaxq_f32(v_zero, g)), v_half);
+        b = vaddq_f32(vminq_f32(v_max, vmaxq_f32(v_zero, b)), v_half);
+        vst1q_s32(y + index, vcvtq_s32_f32(r));
+        vst1q_s32(cb + index, vcvtq_s32_f32(g));
+        vst1q_s32(cr + index, vcvtq_s32_f32(b));
+    }
+#endif
+
+    for (; index < count; index++)
+    {
+        const auto fy = (float)y[index] + offset_y;
+        const auto fcb = (float)cb[index] - offset_cb;
+        const auto fcr = (float)cr[index] - offset_cr;
+        y[index] = extensions_simd_round(fy - 0.0000368f * fcb + 1.40199f * fcr, max);
+        cb[index] = extensions_simd_round(1.0003f * fy - 0.344125f * fcb - 0.7141128f * fcr, max);
+        cr[index] = extensions_simd_round(0.999823f * fy + 1.77204f * fcb - 0.000008f * fcr, max);
+    }
+}
+
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/bin/common/color.c (opj_convert_cmyk_to_rgb)
+// Writes R, G, B over C, M, Y in the precision of c; each input is normalized with its own precision.
+inline void extensions_simd_cmyk_to_rgb(int32_t* c,
+                                        int32_t* m,
+                                        int32_t* y,
+                                        const int32_t* k,
+                                        const uint32_t count,
+                                        const uint32_t prec_c,
+                                        const uint32_t prec_m,
+                                        const uint32_t prec_y,
+                                        const uint32_t prec_k)
+{
+    const auto max = (float)((1u << prec_c) - 1);
+    const auto sc = 1.0f / (float)((1u << prec_c) - 1);
+    const auto sm = 1.0f / (float)((1u << prec_m) - 1);
+    const auto sy = 1.0f / (float)((1u << prec_y) - 1);
+    const auto sk = 1.0f / (float)((1u << prec_k) - 1);
+    uint32_t index = 0;
+
+#if defined(EXTENSIONS_SIMD_SSE2)
+    const auto v_one = _mm_set1_ps(1.0f);
+    const auto v_max = _mm_set1_ps(max);
+    const auto v_zero = _mm_setzero_ps();
+    const auto v_half = _mm_set1_ps(0.5f);
+    for (; index + 4 <= count; index += 4)
+    {
+        const auto vc = _mm_sub_ps(v_one, _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(c + index))), _mm_set1_ps(sc)));
+        const auto vm = _mm_sub_ps(v_one, _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(m + index))), _mm_set1_ps(sm)));
+        const auto vy = _mm_sub_ps(v_one, _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(y + index))), _mm_set1_ps(sy)));
+        const auto vk = _mm_mul_ps(v_max, _mm_sub_ps(v_one, _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(k + index))), _mm_set1_ps(sk))));
+        const auto r = _mm_add_ps(_mm_min_ps(v_max, _mm_max_ps(v_zero, _mm_mul_ps(vk, vc))), v_half);
+        const auto g = _mm_add_ps(_mm_min_ps(v_max, _mm_max_ps(v_zero, _mm_mul_ps(vk, vm))), v_half);
+        const auto b = _mm_add_ps(_mm_min_ps(v_max, _mm_max_ps(v_zero, _mm_mul_ps(vk, vy))), v_half);
+        _mm_storeu_si128((__m128i*)(c + index), _mm_cvttps_epi32(r));
+        _mm_storeu_si128((__m128i*)(m + index), _mm_cvttps_epi32(g));
+        _mm_storeu_si128((__m128i*)(y + index), _mm_cvttps_epi32(b));
+    }
+#elif defined(EXTENSIONS_SIMD_NEON)
+    const auto v_one = vdupq_n_f32(1.0f);
+    const auto v_max = vdupq_n_f32(max);
+    const auto v_zero = vdupq_n_f32(0.0f);
+    const auto v_half = vdupq_n_f32(0.5f);
+    for (; index + 4 <= count; index += 4)
+    {
+        const auto vc = vsubq_f32(v_one, vmulq_f32(vcvtq_f32_s32(vld1q_s32(c + index)), vdupq_n_f32(sc)));
+        const auto vm = vsubq_f32(v_one, vmulq_f32(vcvtq_f32_s32(vld1q_s32(m + index)), vdupq_n_f32(sm)));
+        const auto vy = vsubq_f32(v_one, vmulq_f32(vcvtq_f32_s32(vld1q_s32(y + index)), vdupq_n_f32(sy)));
+        const auto vk = vmulq_f32(v_max, vsubq_f32(v_one, vmulq_f32(vcvtq_f32_s32(vld1q_s32(k + index)), vdupq_n_f32(sk))));
+        const auto r = vaddq_f32(vminq_f32(v_max, vmaxq_f32(v_zero, vmulq_f32(vk, vc))), v_half);
+        const auto g = vaddq_f32(vminq_f32(v_max, vmaxq_f32(v_zero, vmulq_f32(vk, vm))), v_half);
+        const auto b = vaddq_f32(vminq_f32(v_max, vmaxq_f32(v_zero, vmulq_f32(vk, vy))), v_half);
+        vst1q_s32(c + index, vcvtq_s32_f32(r));
+        vst1q_s32(m + index, vcvtq_s32_f32(g));
+        vst1q_s32(y + index, vcvtq_s32_f32(b));
+    }
+#endif
+
+    for (; index < count; index++)
+    {
+        const auto fc = 1.0f - (float)c[index] * sc;
+        const auto fm = 1.0f - (float)m[index] * sm;
+        const auto fy = 1.0f - (float)y[index] * sy;
+        const auto fk = max * (1.0f - (float)k[index] * sk);
+        c[index] = extensions_simd_round(fk * fc, max);
+        m[index] = extensions_simd_round(fk * fm, max);
+        y[index] = extensions_simd_round(fk * fy, max);
+    }
+}
+
+// Blends two rows as top + (bottom - top) * weight and rounds half to even
+inline void extensions_simd_lerp_rows(const float* top, const float* bottom, const float weight, int32_t* dst, const uint32_t count)
+{
+    uint32_t index = 0;
+
+#if defined(EXTENSIONS_SIMD_SSE2)
+    const auto v_weight = _mm_set1_ps(weight);
+    for (; index + 4 <= count; index += 4)
+    {
+        const auto t = _mm_loadu_ps(top + index);
+        const auto b = _mm_loadu_ps(bottom + index);
+        _mm_storeu_si128((__m128i*)(dst + index), _mm_cvtps_epi32(_mm_add_ps(t, _mm_mul_ps(_mm_sub_ps(b, t), v_weight))));
+    }
+#elif defined(EXTENSIONS_SIMD_NEON) && defined(__aarch64__)
+    const auto v_weight = vdupq_n_f32(weight);
+    for (; index + 4 <= count; index += 4)
+    {
+        const auto t = vld1q_f32(top + index);
+        const auto b = vld1q_f32(bottom + index);
+        vst1q_s32(dst + index, vcvtnq_s32_f32(vaddq_f32(t, vmulq_f32(vsubq_f32(b, t), v_weight))));
+    }
+#endif
+
+    for (; index < count; index++)
+        dst[index] = (int32_t)std::nearbyint(top[index] + (bottom[index] - top[index]) * weight);
+}
+
+// Averages 2x2 blocks of two rows into count samples, dst[i] from top and bottom at 2 * i and 2 * i + 1, rounding
+// half up. The vector bodies sum in 32 bits, so samples must stay within 29 bits of magnitude for them.
+inline void extensions_simd_reduce_rows(const int32_t* top, const int32_t* bottom, int32_t* dst, const uint32_t count, const bool narrow)
+{
+    uint32_t index = 0;
+
+    if (narrow)
+    {
+#if defined(EXTENSIONS_SIMD_SSE2)
+        const auto v_two = _mm_set1_epi32(2);
+        for (; index + 4 <= count; index += 4)
+        {
+            const auto lo = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(top + 2 * index)), _mm_loadu_si128((const __m128i*)(bottom + 2 * index)));
+            const auto hi = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(top + 2 * index + 4)), _mm_loadu_si128((const __m128i*)(bottom + 2 * index + 4)));
+            const auto even = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(2, 0, 2, 0)));
+            const auto odd = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(3, 1, 3, 1)));
+            _mm_storeu_si128((__m128i*)(dst + index), _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(even, odd), v_two), 2));
+        }
+#elif defined(EXTENSIONS_SIMD_NEON)
+        const auto v_two = vdupq_n_s32(2);
+        for (; index + 4 <= count; index += 4)
+        {
+            const auto t = vld2q_s32(top + 2 * index);
+            const auto b = vld2q_s32(bottom + 2 * index);
+            const auto sum = vaddq_s32(vaddq_s32(t.val[0], t.val[1]), vaddq_s32(b.val[0], b.val[1]));
+            vst1q_s32(dst + index, vshrq_n_s32(vaddq_s32(sum, v_two), 2));
+        }
+#endif
+    }
+
+    for (; index < count; index++)
+    {
+        const auto sum = (int64_t)top[2 * index] + top[2 * index + 1] + bottom[2 * index] + bottom[2 * index + 1];
+        dst[index] = (int32_t)((sum + 2) >> 2);
+    }
+}
+
+// Rescaling of samples of 1 to 31 bits, signed or unsigned, to the full range of 8 or 16 bits:
+// out = round(u * (2^bits - 1) / (2^prec - 1)) where u is the sample clamped and shifted to unsigned.
+// That quotient is never exactly halfway between two integers, so rounding half up is exact as long as the
+// arithmetic error stays below 1 / (2 * (2^prec - 1)). Single precision meets that for prec + bits <= 20,
+// double precision for every other case, and two cases need no division at all.
+typedef enum extensions_simd_scale_method
+{
+    // Same precision: clamp only
+    EXTENSIONS_SIMD_SCALE_COPY,
+    // bits is a multiple of prec: u * (2^bits - 1) / (2^prec - 1) is an integer, the bit pattern repeated
+    EXTENSIONS_SIMD_SCALE_REPLICATE,
+    EXTENSIONS_SIMD_SCALE_FLOAT,
+    EXTENSIONS_SIMD_SCALE_DOUBLE
+} extensions_simd_scale_method_t;
+
+typedef struct extensions_simd_scale
+{
+    extensions_simd_scale_method_t method;
+    int32_t low;
+    int32_t high;
+    uint32_t factor;
+    float scale;
+    double max;
+    double range;
+} extensions_simd_scale_t;
+
+inline void extensions_simd_scale_init(extensions_simd_scale_t* scale, const uint32_t prec, const bool sgnd, const uint32_t bits)
+{
+    scale->low = sgnd ? -(int32_t)(1u << (prec - 1)) : 0;
+    scale->high = sgnd ? (int32_t)((1u << (prec - 1)) - 1) : (int32_t)((1u << prec) - 1);
+    scale->max = (double)((1u << bits) - 1);
+    scale->range = (double)((1u << prec) - 1);
+    scale->scale = (float)(scale->max / scale->range);
+    scale->factor = 0;
+
+    if (prec == bits)
+    {
+        scale->method = EXTENSIONS_SIMD_SCALE_COPY;
+    }
+    else if (prec < bits && bits % prec == 0)
+    {
+        scale->method = EXTENSIONS_SIMD_SCALE_REPLICATE;
+        scale->factor = ((1u << bits) - 1) / ((1u << prec) - 1);
+    }
+    else
+    {
+        scale->method = prec + bits <= 20 ? EXTENSIONS_SIMD_SCALE_FLOAT : EXTENSIONS_SIMD_SCALE_DOUBLE;
+    }
+}
+
+inline uint32_t extensions_simd_scale_sample(const extensions_simd_scale_t* scale, const int32_t sample)
+{
+    const auto u = (uint32_t)(std::min(scale->high, std::max(scale->low, sample)) - scale->low);
+    switch (scale->method)
+    {
+        case EXTENSIONS_SIMD_SCALE_COPY:
+            return u;
+        case EXTENSIONS_SIMD_SCALE_REPLICATE:
+            return u * scale->factor;
+        case EXTENSIONS_SIMD_SCALE_FLOAT:
+            return (uint32_t)((float)u * scale->scale + 0.5f);
+        default:
+            return (uint32_t)((double)u * scale->max / scale->range + 0.5);
+    }
+}
+
+#if defined(EXTENSIONS_SIMD_SSE2)
+// Returns four samples scaled to [0, 2^bits - 1]
+inline __m128i extensions_simd_scale4(const extensions_simd_scale_t* scale, const __m128i sample)
+{
+    // SSE2 has no 32-bit min and max, so clamp with compares
+    const auto low = _mm_set1_epi32(scale->low);
+    const auto high = _mm_set1_epi32(scale->high);
+    auto value = sample;
+    auto mask = _mm_cmplt_epi32(value, low);
+    value = _mm_or_si128(_mm_andnot_si128(mask, value), _mm_and_si128(mask, low));
+    mask = _mm_cmpgt_epi32(value, high);
+    value = _mm_or_si128(_mm_andnot_si128(mask, value), _mm_and_si128(mask, high));
+    const auto u = _mm_sub_epi32(value, low);
+
+    switch (scale->method)
+    {
+        case EXTENSIONS_SIMD_SCALE_COPY:
+            return u;
+        case EXTENSIONS_SIMD_SCALE_REPLICATE:
+            // Products stay below 2^16, which single precision holds exactly
+            return _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(u), _mm_set1_ps((float)scale->factor)));
+        case EXTENSIONS_SIMD_SCALE_FLOAT:
+            return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(u), _mm_set1_ps(scale->scale)), _mm_set1_ps(0.5f)));
+        default:
+        {
+            // u is at most 2^31 - 1, so it converts as signed
+            const auto max = _mm_set1_pd(scale->max);
+            const auto range = _mm_set1_pd(scale->range);
+            const auto half = _mm_set1_pd(0.5);
+            const auto lo = _mm_add_pd(_mm_div_pd(_mm_mul_pd(_mm_cvtepi32_pd(u), max), range), half);
+            const auto hi = _mm_add_pd(_mm_div_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(u, 8)), max), range), half);
+            return _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+        }
+    }
+}
+#elif defined(EXTENSIONS_SIMD_NEON)
+// Returns four samples scaled to [0, 2^bits - 1]; the double path stays scalar
+inline int32x4_t extensions_simd_scale4(const extensions_simd_scale_t* scale, const int32x4_t sample)
+{
+    const auto u = vsubq_s32(vminq_s32(vdupq_n_s32(scale->high), vmaxq_s32(vdupq_n_s32(scale->low), sample)), vdupq_n_s32(scale->low));
+    switch (scale->method)
+    {
+        case EXTENSIONS_SIMD_SCALE_COPY:
+            return u;
+        case EXTENSIONS_SIMD_SCALE_REPLICATE:
+            return vmulq_s32(u, vdupq_n_s32((int32_t)scale->factor));
+        default:
+            return vcvtq_s32_f32(vaddq_f32(vmulq_f32(vcvtq_f32_s32(u), vdupq_n_f32(scale->scale)), vdupq_n_f32(0.5f)));
+    }
+}
+#endif
+
+inline void extensions_simd_scale_to_uint8(const int32_t* src, uint8_t* dst, const uint32_t count, const uint32_t prec, const bool sgnd)
+{
+    extensions_simd_scale_t scale;
+    extensions_simd_scale_init(&scale, prec, sgnd, 8);
+    uint32_t index = 0;
+
+#if defined(EXTENSIONS_SIMD_SSE2)
+    for (; index + 8 <= count; index += 8)
+    {
+        const auto lo = extensions_simd_scale4(&scale, _mm_loadu_si128((const __m128i*)(src + index)));
+        const auto hi = extensions_simd_scale4(&scale, _mm_loadu_si128((const __m128i*)(src + index + 4)));
+        const auto words = _mm_packs_epi32(lo, hi);
+        _mm_storel_epi64((__m128i*)(dst + index), _mm_packus_epi16(words, words));
+    }
+#elif defined(EXTENSIONS_SIMD_NEON)
+    if (scale.method != EXTENSIONS_SIMD_SCALE_DOUBLE)
+    {
+        for (; index + 8 <= count; index += 8)
+        {
+            const auto lo = extensions_simd_scale4(&scale, vld1q_s32(src + index));
+            const auto hi = extensions_simd_scale4(&scale, vld1q_s32(src + index + 4));
+            vst1_u8(dst + index, vqmovun_s16(vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi))));
+        }
+    }
+#endif
+
+    for (; index < count; index++)
+        dst[index] = (uint8_t)extensions_simd_scale_sample(&scale, src[index]);
+}
+
+inline void extensions_simd_scale_to_uint16(const int32_t* src, uint16_t* dst, const uint32_t count, const uint32_t prec, const bool sgnd)
+{
+    extensions_simd_scale_t scale;
+    extensions_simd_scale_init(&scale, prec, sgnd, 16);
+    uint32_t index = 0;
+
+#if defined(EXTENSIONS_SIMD_SSE2)
+    // SSE2 only packs with signed saturation, so bias the values into the signed range and back
+    const auto bias32 = _mm_set1_epi32(32768);
+    const auto bias16 = _mm_set1_epi16((int16_t)-32768);
+    for (; index + 8 <= count; index += 8)
+    {
+        const auto lo = _mm_sub_epi32(extensions_simd_scale4(&scale, _mm_loadu_si128((const __m128i*)(src + index))), bias32);
+        const auto hi = _mm_sub_epi32(extensions_simd_scale4(&scale, _mm_loadu_si128((const __m128i*)(src + index + 4))), bias32);
+        _mm_storeu_si128((__m128i*)(dst + index), _mm_xor_si128(_mm_packs_epi32(lo, hi), bias16));
+    }
+#elif defined(EXTENSIONS_SIMD_NEON)
+    if (scale.method != EXTENSIONS_SIMD_SCALE_DOUBLE)
+    {
+        for (; index + 8 <= count; index += 8)
+        {
+            const auto lo = extensions_simd_scale4(&scale, vld1q_s32(src + index));
+            const auto hi = extensions_simd_scale4(&scale, vld1q_s32(src + index + 4));
+            vst1q_u16(dst + index, vcombine_u16(vqmovun_s32(lo), vqmovun_s32(hi)));
+        }
+    }
+#endif
+
+    for (; index < count; index++)
+        dst[index] = (uint16_t)extensions_simd_scale_sample(&scale, src[index]);
+}
+
+// Normalizes samples to [0, 1]. Up to 24 bits the quotient is correctly rounded; wider samples are divided
+// in double precision and rounded once more to single precision.
+inline void extensions_simd_scale_to_float32(const int32_t* src, float* dst, const uint32_t count, const uint32_t prec, const bool sgnd)
+{
+    extensions_simd_scale_t scale;
+    extensions_simd_scale_init(&scale, prec, sgnd, prec);
+    const auto range = (float)scale.range;
+    uint32_t index = 0;
+
+    if (prec <= 24)
+    {
+#if defined(EXTENSIONS_SIMD_SSE2)
+        const auto v_range = _mm_set1_ps(range);
+        for (; index + 4 <= count; index += 4)
+        {
+            const auto u = extensions_simd_scale4(&scale, _mm_loadu_si128((const __m128i*)(src + index)));
+            _mm_storeu_ps(dst + index, _mm_div_ps(_mm_cvtepi32_ps(u), v_range));
+        }
+#elif defined(EXTENSIONS_SIMD_NEON) && defined(__aarch64__)
+        const auto v_range = vdupq_n_f32(range);
+        for (; index + 4 <= count; index += 4)
+        {
+            const auto u = extensions_simd_scale4(&scale, vld1q_s32(src + index));
+            vst1q_f32(dst + index, vdivq_f32(vcvtq_f32_s32(u), v_range));
+        }
+#endif
+
+        for (; index < count; index++)
+            dst[index] = (float)extensions_simd_scale_sample(&scale, src[index]) / range;
+        return;
+    }
+
+    for (; index < count; index++)
+        dst[index] = (float)((double)extensions_simd_scale_sample(&scale, src[index]) / scale.range);
+}
+
+inline void extensions_simd_interleave3(const uint8_t* c0, const uint8_t* c1, const uint8_t* c2, uint8_t* dst, const uint32_t count)
+{
+    uint32_t index = 0;
+
+#if defined(EXTENSIONS_SIMD_NEON)
+    for (; index + 16 <= count; index += 16)
+    {
+        uint8x16x3_t pixels;
+        pixels.val[0] = vld1q_u8(c0 + index);
+        pixels.val[1] = vld1q_u8(c1 + index);
+        pixels.val[2] = vld1q_u8(c2 + index);
+        vst3q_u8(dst + index * 3, pixels);
+    }
+#endif
+
+    for (; index < count; index++)
+    {
+        dst[index * 3 + 0] = c0[index];
+        dst[index * 3 + 1] = c1[index];
+        dst[index * 3 + 2] = c2[index];
+    }
+}
+
+// round(c * a / 255) without a division, exact for every pair of 8-bit values
+inline uint8_t extensions_simd_premultiply(const uint8_t c, const uint8_t a)
+{
+    const auto t = (uint32_t)c * a + 128;
+    return (uint8_t)((t + (t >> 8)) >> 8);
+}
+
+#if defined(EXTENSIONS_SIMD_SSE2)
+inline __m128i extensions_simd_premultiply16(const __m128i c, const __m128i a)
+{
+    const auto zero = _mm_setzero_si128();
+    const auto half = _mm_set1_epi16(128);
+    auto lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(c, zero), _mm_unpacklo_epi8(a, zero)), half);
+    auto hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(c, zero), _mm_unpackhi_epi8(a, zero)), half);
+    lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+    hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+    return _mm_packus_epi16(lo, hi);
+}
+#elif defined(EXTENSIONS_SIMD_NEON)
+inline uint8x16_t extensions_simd_premultiply16(const uint8x16_t c, const uint8x16_t a)
+{
+    const auto lo = vmull_u8(vget_low_u8(c), vget_low_u8(a));
+    const auto hi = vmull_u8(vget_high_u8(c), vget_high_u8(a));
+    return vcombine_u8(vraddhn_u16(lo, vrshrq_n_u16(lo, 8)), vraddhn_u16(hi, vrshrq_n_u16(hi, 8)));
+}
+#endif
+
+// Interleaves three color rows and an alpha row into 4-byte pixels, premultiplying the colors when asked
+inline void extensions_simd_interleave4(const uint8_t* c0,
+                                        const uint8_t* c1,
+                                        const uint8_t* c2,
+                                        const uint8_t* alpha,
+                                        uint8_t* dst,
+                                        const uint32_t count,
+                                        const bool premultiply)
+{
+    uint32_t index = 0;
+
+#if defined(EXTENSIONS_SIMD_SSE2)
+    for (; index + 16 <= count; index += 16)
+    {
+        auto v0 = _mm_loadu_si128((const __m128i*)(c0 + index));
+        auto v1 = _mm_loadu_si128((const __m128i*)(c1 + index));
+        auto v2 = _mm_loadu_si128((const __m128i*)(c2 + index));
+        const auto va = _mm_loadu_si128((const __m128i*)(alpha + index));
+        if (premultiply)
+        {
+            v0 = extensions_simd_premultiply16(v0, va);
+            v1 = extensions_simd_premultiply16(v1, va);
+            v2 = extensions_simd_premultiply16(v2, va);
+        }
+
+        const auto lo01 = _mm_unpacklo_epi8(v0, v1);
+        const auto hi01 = _mm_unpackhi_epi8(v0, v1);
+        const auto lo2a = _mm_unpacklo_epi8(v2, va);
+        const auto hi2a = _mm_unpackhi_epi8(v2, va);
+        auto out = (__m128i*)(dst + index * 4);
+        _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(lo01, lo2a));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo01, lo2a));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi01, hi2a));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi01, hi2a));
+    }
+#elif defined(EXTENSIONS_SIMD_NEON)
+    for (; index + 16 <= count; index += 16)
+    {
+        uint8x16x4_t pixels;
+        pixels.val[0] = vld1q_u8(c0 + index);
+        pixels.val[1] = vld1q_u8(c1 + index);
+        pixels.val[2] = vld1q_u8(c2 + index);
+        pixels.val[3] = vld1q_u8(alpha + index);
+        if (premultiply)
+        {
+            pixels.val[0] = extensions_simd_premultiply16(pixels.val[0], pixels.val[3]);
+            pixels.val[1] = extensions_simd_premultiply16(pixels.val[1], pixels.val[3]);
+            pixels.val[2] = extensions_simd_premultiply16(pixels.val[2], pixels.val[3]);
+        }
+        vst4q_u8(dst + index * 4, pixels);
+    }
+#endif
+
+    for (; index < count; index++)
+    {
+        const auto a = alpha[index];
+        auto out = dst + index * 4;
+        out[0] = premultiply ? extensions_simd_premultiply(c0[index], a) : c0[index];
+        out[1] = premultiply ? extensions_simd_premultiply(c1[index], a) : c1[index];
+        out[2] = premultiply ? extensions_simd_premultiply(c2[index], a) : c2[index];
+        out[3] = a;
+    }
+}
+
+// Undoes premultiplication in place for sources whose colors are already premultiplied
+inline void extensions_simd_unpremultiply(uint8_t* c, const uint8_t* alpha, const uint32_t count)
+{
+    for (uint32_t index = 0; index < count; index++)
+    {
+        const auto a = (uint32_t)alpha[index];
+        c[index] = a == 0 ? 0 : (uint8_t)std::min(255u, (c[index] * 255u + a / 2) / a);
+    }
+}
+
+// Reads one sample of 1 or 2 bytes. Two-byte samples are little endian unless big_endian is set.
+inline int32_t extensions_simd_read_sample(const uint8_t* src, const uint32_t sample_bytes, const bool sgnd, const bool big_endian)
+{
+    if (sample_bytes == 1)
+        return sgnd ? (int32_t)(int8_t)src[0] : (int32_t)src[0];
+
+    const auto value = (uint16_t)(big_endian ? (src[0] << 8) | src[1] : src[0] | (src[1] << 8));
+    return sgnd ? (int32_t)(int16_t)value : (int32_t)value;
+}
+
+// The vector bodies of extensions_simd_widen return how many samples they converted. Loads never reach past
+// the last byte of the last sample, which is why a few samples are always left to the scalar tail.
+
+#if defined(EXTENSIONS_SIMD_AVX2)
+EXTENSIONS_SIMD_TARGET_AVX2
+inline uint32_t extensions_simd_widen_avx2(const uint8_t* src, const uint64_t step, const uint32_t sample_bytes, const bool sgnd, int32_t* dst, const uint32_t count)
+{
+    uint32_t index = 0;
+    if (step == sample_bytes)
+    {
+        if (sample_bytes == 1)
+        {
+            for (; index + 8 <= count; index += 8)
+            {
+                const auto v = _mm_loadl_epi64((const __m128i*)(src + index));
+                _mm256_storeu_si256((__m256i*)(dst + index), sgnd ? _mm256_cvtepi8_epi32(v) : _mm256_cvtepu8_epi32(v));
+            }
+        }
+        else
+        {
+            for (; index + 8 <= count; index += 8)
+            {
+                const auto v = _mm_loadu_si128((const __m128i*)(src + index * 2));
+                _mm256_storeu_si256((__m256i*)(dst + index), sgnd ? _mm256_cvtepi16_epi32(v) : _mm256_cvtepu16_epi32(v));
+            }
+        }
+        return index;
+    }
+
+    // Interleaved or strided: gather the 32 bits starting at each sample and keep the low sample_bytes
+    if (step > 0x0FFFFFFF || count < 8)
+        return 0;
+
+    const auto offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32((int32_t)step));
+    const auto shift = _mm_cvtsi32_si128((int32_t)(32 - 8 * sample_bytes));
+    const auto end = (count - 1) * step + sample_bytes;
+    for (; (index + 7) * step + 4 <= end; index += 8)
+    {
+        auto v = _mm256_i32gather_epi32((const int*)(src + index * step), offsets, 1);
+        v = _mm256_sll_epi32(v, shift);
+        _mm256_storeu_si256((__m256i*)(dst + index), sgnd ? _mm256_sra_epi32(v, shift) : _mm256_srl_epi32(v, shift));
+    }
+    return index;
+}
+#endif
+
+#if defined(EXTENSIONS_SIMD_SSE2)
+inline uint32_t extensions_simd_widen_sse2(const uint8_t* src, const uint64_t step, const uint32_t sample_bytes, const bool sgnd, int32_t* dst, const uint32_t count)
+{
+    const auto zero = _mm_setzero_si128();
+    uint32_t index = 0;
+    if (step == 1)
+    {
+        for (; index + 16 <= count; index += 16)
+        {
+            const auto v = _mm_loadu_si128((const __m128i*)(src + index));
+            // Pairing a byte with itself and shifting right sign-extends it
+            const auto lo = sgnd ? _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8) : _mm_unpacklo_epi8(v, zero);
+            const auto hi = sgnd ? _mm_srai_epi16(_mm_unpackhi_epi8(v, v), 8) : _mm_unpackhi_epi8(v, zero);
+            const auto out = (__m128i*)(dst + index);
+            _mm_storeu_si128(out + 0, sgnd ? _mm_srai_epi32(_mm_unpacklo_epi16(lo, lo), 16) : _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128(out + 1, sgnd ? _mm_srai_epi32(_mm_unpackhi_epi16(lo, lo), 16) : _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128(out + 2, sgnd ? _mm_srai_epi32(_mm_unpacklo_epi16(hi, hi), 16) : _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128(out + 3, sgnd ? _mm_srai_epi32(_mm_unpackhi_epi16(hi, hi), 16) : _mm_unpackhi_epi16(hi, zero));
+        }
+    }
+    else if (step == 2 && sample_bytes == 2)
+    {
+        for (; index + 8 <= count; index += 8)
+        {
+            const auto v = _mm_loadu_si128((const __m128i*)(src + index * 2));
+            const auto out = (__m128i*)(dst + index);
+            _mm_storeu_si128(out + 0, sgnd ? _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16) : _mm_unpacklo_epi16(v, zero));
+            _mm_storeu_si128(out + 1, sgnd ? _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16) : _mm_unpackhi_epi16(v, zero));
+        }
+    }
+    else if (step == 4)
+    {
+        // Four-byte pixels such as RGBA: each 32-bit lane starts with the wanted sample
+        const auto shift = 32 - 8 * sample_bytes;
+        if (count >= 4)
+        {
+            const auto end = (uint64_t)(count - 1) * 4 + sample_bytes;
+            for (; (uint64_t)index * 4 + 16 <= end; index += 4)
+            {
+                const auto v = _mm_slli_epi32(_mm_loadu_si128((const __m128i*)(src + index * 4)), (int)shift);
+                _mm_storeu_si128((__m128i*)(dst + index), sgnd ? _mm_srai_epi32(v, (int)shift) : _mm_srli_epi32(v, (int)shift));
+            }
+        }
+    }
+    return index;
+}
+#elif defined(EXTENSIONS_SIMD_NEON)
+inline uint32_t extensions_simd_widen_neon(const uint8_t* src, const uint64_t step, const uint32_t sample_bytes, const bool sgnd, int32_t* dst, const uint32_t count)
+{
+    uint32_t index = 0;
+    if (sample_bytes == 1 && step >= 1 && step <= 4)
+    {
+        // vld3 and vld4 deinterleave the pixel group, so only the first lane set is kept
+        const auto end = count > 0 ? (uint64_t)(count - 1) * step + 1 : 0;
+        for (; (uint64_t)(index + 16) * step <= end; index += 16)
+        {
+            uint8x16_t v;
+            switch (step)
+            {
+                case 1: v = vld1q_u8(src + index); break;
+                case 2: v = vld2q_u8(src + index * 2).val[0]; break;
+                case 3: v = vld3q_u8(src + index * 3).val[0]; break;
+                default: v = vld4q_u8(src + index * 4).val[0]; break;
+            }
+
+            int32x4_t out[4];
+            if (sgnd)
+            {
+                const auto lo = vmovl_s8(vget_low_s8(vreinterpretq_s8_u8(v)));
+                const auto hi = vmovl_s8(vget_high_s8(vreinterpretq_s8_u8(v)));
+                out[0] = vmovl_s16(vget_low_s16(lo));
+                out[1] = vmovl_s16(vget_high_s16(lo));
+                out[2] = vmovl_s16(vget_low_s16(hi));
+                out[3] = vmovl_s16(vget_high_s16(hi));
+            }
+            else
+            {
+                const auto lo = vmovl_u8(vget_low_u8(v));
+                const auto hi = vmovl_u8(vget_high_u8(v));
+                out[0] = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(lo)));
+                out[1] = vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(lo)));
+                out[2] = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(hi)));
+                out[3] = vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(hi)));
+            }
+            for (auto part = 0; part < 4; part++)
+                vst1q_s32(dst + index + part * 4, out[part]);
+        }
+    }
+    else if (sample_bytes == 2 && step == 2)
+    {
+        for (; index + 8 <= count; index += 8)
+        {
+            const auto v = vld1q_u16((const uint16_t*)(src + index * 2));
+            if (sgnd)
+            {
+                const auto s = vreinterpretq_s16_u16(v);
+                vst1q_s32(dst + index, vmovl_s16(vget_low_s16(s)));
+                vst1q_s32(dst + index + 4, vmovl_s16(vget_high_s16(s)));
+            }
+            else
+            {
+                vst1q_s32(dst + index, vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(v))));
+                vst1q_s32(dst + index + 4, vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(v))));
+            }
+        }
+    }
+    return index;
+}
+#endif
+
+// Widens count samples of 1 or 2 bytes, step bytes apart, into int32. step equal to sample_bytes is a planar
+// row, a multiple of it an interleaved row, anything else a strided one.
+inline void extensions_simd_widen(const uint8_t* src,
+                                  const uint64_t step,
+                                  const uint32_t sample_bytes,
+                                  const bool sgnd,
+                                  const bool big_endian,
+                                  int32_t* dst,
+                                  const uint32_t count)
+{
+    uint32_t index = 0;
+
+    // The vector bodies assume little-endian samples, as are all the hosts they are built for
+    if (sample_bytes == 1 || !big_endian)
+    {
+#if defined(EXTENSIONS_SIMD_AVX2)
+        if (extensions_simd_has_avx2())
+            index = extensions_simd_widen_avx2(src, step, sample_bytes, sgnd, dst, count);
+        else
+            index = extensions_simd_widen_sse2(src, step, sample_bytes, sgnd, dst, count);
+#elif defined(EXTENSIONS_SIMD_SSE2)
+        index = extensions_simd_widen_sse2(src, step, sample_bytes, sgnd, dst, count);
+#elif defined(EXTENSIONS_SIMD_NEON)
+        index = extensions_simd_widen_neon(src, step, sample_bytes, sgnd, dst, count);
+#endif
+    }
+
+    for (; index < count; index++)
+        dst[index] = extensions_simd_read_sample(src + step * index, sample_bytes, sgnd, big_endian);
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_SIMD_H_
\ No newline at end of file
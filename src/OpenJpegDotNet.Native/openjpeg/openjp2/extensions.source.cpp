@@ -0,0 +1 @@
+#include "extensions.source.hpp"
\ No newline at end of file
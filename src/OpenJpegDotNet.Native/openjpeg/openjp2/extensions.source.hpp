@@ -0,0 +1,207 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_SOURCE_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_SOURCE_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.decode.hpp"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <string>
+
+// A source is created with one reference, owned by the caller. Every stream created over it holds another
+// one, so the bytes stay valid until the caller and all the streams are done with them.
+
+inline void extensions_source_dispose_copy(extensions_source_t* source)
+{
+    free((void*)source->data);
+}
+
+inline void extensions_source_dispose_mapping(extensions_source_t* source)
+{
+#ifdef _WIN32
+    ::UnmapViewOfFile(source->data);
+#else
+    ::munmap((void*)source->data, (size_t)source->length);
+#endif
+}
+
+inline extensions_source_t* extensions_source_create(const uint8_t* data,
+                                                     const uint64_t length,
+                                                     void (*dispose)(extensions_source_t* source))
+{
+    auto source = new extensions_source_t();
+    source->references = 1;
+    source->data = data;
+    source->length = length;
+    source->dispose = dispose;
+    return source;
+}
+
+// Maps the whole file read only. The file may be closed or renamed once it is mapped, but it must not be
+// truncated or written while the source is alive.
+inline int32_t extensions_source_map_file(const std::string& path, const uint8_t** data, uint64_t* length)
+{
+#ifdef _WIN32
+    const auto path_len = ::MultiByteToWideChar(CP_UTF8, 0, path.c_str(), (int)path.size(), nullptr, 0);
+    std::wstring wide(path_len, L'\0');
+    ::MultiByteToWideChar(CP_UTF8, 0, path.c_str(), (int)path.size(), &wide[0], path_len);
+
+    const auto file = ::CreateFileW(wide.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return ERR_GENERAL_FILE_IO;
+
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size))
+    {
+        ::CloseHandle(file);
+        return ERR_GENERAL_FILE_IO;
+    }
+    if (size.QuadPart == 0)
+    {
+        ::CloseHandle(file);
+        return ERR_IMAGE_FILE_INVALID;
+    }
+
+    // The view keeps the mapping and the file open on its own
+    const auto mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(file);
+    if (mapping == nullptr)
+        return ERR_GENERAL_FILE_IO;
+
+    const auto view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(mapping);
+    if (view == nullptr)
+        return ERR_GENERAL_FILE_IO;
+
+    *data = (const uint8_t*)view;
+    *length = (uint64_t)size.QuadPart;
+    return ERR_OK;
+#else
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return ERR_GENERAL_FILE_IO;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        return ERR_GENERAL_FILE_IO;
+    }
+    if (st.st_size == 0)
+    {
+        ::close(fd);
+        return ERR_IMAGE_FILE_INVALID;
+    }
+
+    // The mapping keeps the file open on its own
+    const auto view = ::mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED)
+        return ERR_GENERAL_FILE_IO;
+
+    *data = (const uint8_t*)view;
+    *length = (uint64_t)st.st_size;
+    return ERR_OK;
+#endif
+}
+
+// Copies data, which the caller may free as soon as this returns
+DLLEXPORT int32_t openjpeg_openjp2_extensions_source_new(const uint8_t* data,
+                                                         const uint64_t data_len,
+                                                         extensions_source_t** source)
+{
+    *source = nullptr;
+    if (data_len == 0)
+        return ERR_IMAGE_FILE_INVALID;
+
+    auto copy = (uint8_t*)malloc((size_t)data_len);
+    if (copy == nullptr)
+        return ERR_GENERAL_MEMALLOC;
+
+    memcpy(copy, data, (size_t)data_len);
+    *source = extensions_source_create(copy, data_len, extensions_source_dispose_copy);
+    return ERR_OK;
+}
+
+// Maps the file at path, given in UTF-8, instead of reading it into memory
+DLLEXPORT int32_t openjpeg_openjp2_extensions_source_new_file(const char* path,
+                                                              const uint32_t path_len,
+                                                              extensions_source_t** source)
+{
+    *source = nullptr;
+
+    const uint8_t* data;
+    uint64_t length;
+    const auto ret = extensions_source_map_file(std::string(path, path_len), &data, &length);
+    if (ret != ERR_OK)
+        return ret;
+
+    *source = extensions_source_create(data, length, extensions_source_dispose_mapping);
+    return ERR_OK;
+}
+
+DLLEXPORT void openjpeg_openjp2_extensions_source_retain(extensions_source_t* source)
+{
+    extensions_source_retain(source);
+}
+
+DLLEXPORT void openjpeg_openjp2_extensions_source_release(extensions_source_t* source)
+{
+    extensions_source_release(source);
+}
+
+DLLEXPORT void openjpeg_openjp2_extensions_source_get_data(extensions_source_t* source,
+                                                           const uint8_t** data,
+                                                           uint64_t* data_len)
+{
+    *data = source->data;
+    *data_len = source->length;
+}
+
+// Creates a stream positioned at the start of the source, to be used with a codec of its own and released
+// with openjpeg_openjp2_opj_stream_destroy. Streams over the same source can be read from different threads.
+DLLEXPORT opj_stream_t* openjpeg_openjp2_extensions_source_create_stream(extensions_source_t* source,
+                                                                         const extensions_cancel_token_t* token)
+{
+    return extensions_source_create_stream(source, token);
+}
+
+// Same as openjpeg_openjp2_extensions_decode_memory over the bytes of the source, without copying them.
+// Any number of these can run at the same time on the same source.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_source_decode(extensions_source_t* source,
+                                                            const uint32_t reduce,
+                                                            const uint32_t layers,
+                                                            const int32_t x0,
+                                                            const int32_t y0,
+                                                            const int32_t x1,
+                                                            const int32_t y1,
+                                                            const int32_t num_threads,
+                                                            const extensions_cancel_token_t* token,
+                                                            opj_image_t** image)
+{
+    extensions_decode_options_t options;
+    options.reduce = reduce;
+    options.layers = layers;
+    options.x0 = x0;
+    options.y0 = y0;
+    options.x1 = x1;
+    options.y1 = y1;
+    options.num_threads = num_threads;
+    options.token = token;
+
+    return extensions_decode_image(source->data, source->length, &options, image);
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_SOURCE_H_
\ No newline at end of file
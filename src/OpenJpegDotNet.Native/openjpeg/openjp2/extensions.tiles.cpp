@@ -0,0 +1 @@
+#include "extensions.tiles.hpp"
\ No newline at end of file
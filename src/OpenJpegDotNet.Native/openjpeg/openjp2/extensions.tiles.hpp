@@ -0,0 +1,251 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_EXTENSIONS_TILES_H_
+#define _CPP_OPENJPEG_OPENJP2_EXTENSIONS_TILES_H_
+
+#include "../export.hpp"
+#include "../shared.hpp"
+#include "extensions.decode.hpp"
+#include "extensions.pixels.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Hands each tile to the caller as soon as it is decoded and converted, instead of once the whole image is.
+// With max_pending above zero, tiles are delivered on a thread of their own while the next ones decode, and
+// up to max_pending converted tiles wait for the callback before decoding pauses.
+
+// One converted tile. x and y place it in the output, whose size is that of the image decoded with the same
+// area and reduce. Rows follow each other without padding; planar components follow each other.
+typedef struct extensions_tiles_pixels
+{
+    uint32_t index;
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+    uint32_t bits;
+    const uint8_t* data;
+    uint64_t length;
+} extensions_tiles_pixels_t;
+
+// The pixels are only valid during the call. Returning anything but ERR_OK stops decoding and that value is
+// returned by the decode.
+typedef int32_t (*extensions_tiles_callback)(const extensions_tiles_pixels_t* tile, void* user_data);
+
+typedef struct extensions_tiles_item
+{
+    extensions_tiles_pixels_t pixels;
+    std::vector<uint8_t> buffer;
+} extensions_tiles_item_t;
+
+typedef struct extensions_tiles_pipeline
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<std::unique_ptr<extensions_tiles_item_t>> items;
+    std::vector<extensions_tiles_item_t*> free_items;
+    std::deque<extensions_tiles_item_t*> ready;
+    extensions_tiles_callback callback;
+    void* user_data;
+    uint32_t max_pending;
+    int32_t status;
+    bool finished;
+} extensions_tiles_pipeline_t;
+
+inline void extensions_tiles_deliver(extensions_tiles_pipeline_t* pipeline)
+{
+    std::unique_lock<std::mutex> lock(pipeline->mutex);
+    while (true)
+    {
+        pipeline->changed.wait(lock, [pipeline] { return pipeline->finished || !pipeline->ready.empty(); });
+        if (pipeline->ready.empty())
+            return;
+
+        auto item = pipeline->ready.front();
+        pipeline->ready.pop_front();
+
+        // Tiles left over once the callback has failed are dropped
+        if (pipeline->status == ERR_OK)
+        {
+            lock.unlock();
+            const auto ret = pipeline->callback(&item->pixels, pipeline->user_data);
+            lock.lock();
+            if (ret != ERR_OK && pipeline->status == ERR_OK)
+                pipeline->status = ret;
+        }
+
+        pipeline->free_items.push_back(item);
+        pipeline->changed.notify_all();
+    }
+}
+
+// Waits for room in the pipeline. Returns nullptr once the callback has failed.
+inline extensions_tiles_item_t* extensions_tiles_acquire(extensions_tiles_pipeline_t* pipeline)
+{
+    std::unique_lock<std::mutex> lock(pipeline->mutex);
+    if (pipeline->free_items.empty() && pipeline->items.size() < pipeline->max_pending)
+    {
+        pipeline->items.emplace_back(new extensions_tiles_item_t());
+        return pipeline->items.back().get();
+    }
+
+    pipeline->changed.wait(lock, [pipeline] { return pipeline->status != ERR_OK || !pipeline->free_items.empty(); });
+    if (pipeline->status != ERR_OK)
+        return nullptr;
+
+    auto item = pipeline->free_items.back();
+    pipeline->free_items.pop_back();
+    return item;
+}
+
+inline bool extensions_tiles_is_empty(const extensions_tile_t& tile)
+{
+    for (const auto& comp : tile.comps)
+        if (comp.w == 0 || comp.h == 0)
+            return true;
+    return false;
+}
+
+inline int32_t extensions_tiles_convert(const extensions_decoder_t* decoder,
+                                        const extensions_tile_t& tile,
+                                        const int32_t format,
+                                        const uint32_t flags,
+                                        extensions_pixels_tile_image_t* tile_image,
+                                        std::vector<uint8_t>& buffer,
+                                        extensions_tiles_pixels_t* pixels)
+{
+    extensions_pixels_tile_image_set(tile_image, decoder, tile);
+    const auto image = &tile_image->image;
+
+    // The tile is placed by the component that sets the output grid
+    uint32_t refno = 0;
+    if (format != EXTENSIONS_PIXEL_FORMAT_PLANAR)
+    {
+        const auto color = extensions_pixels_get_color(image, flags);
+        const auto ret = extensions_pixels_get_grid(image, extensions_pixels_get_color_comps(color), &refno);
+        if (ret != ERR_OK)
+            return ret;
+    }
+
+    extensions_pixels_t converted;
+    const auto ret = extensions_pixels_convert(image, format, flags, buffer, &converted);
+    if (ret != ERR_OK)
+        return ret;
+
+    pixels->index = tile.index;
+    pixels->x = tile.comps[refno].x0;
+    pixels->y = tile.comps[refno].y0;
+    pixels->width = converted.width;
+    pixels->height = converted.height;
+    pixels->channels = converted.channels;
+    pixels->bits = converted.bits;
+    pixels->data = converted.data;
+    pixels->length = converted.length;
+    return ERR_OK;
+}
+
+// Decodes a JPEG 2000 codestream or JP2 file held in memory tile by tile and calls callback with each tile
+// converted to format, in codestream order. Zero area means the whole image and token can be null.
+// num_threads is handed to the codec, which decodes the code-blocks of each tile in parallel.
+// Tiles that lie outside the area, or whose components are empty at this reduce, are skipped.
+DLLEXPORT int32_t openjpeg_openjp2_extensions_tiles_decode(const uint8_t* data,
+                                                           const uint64_t data_len,
+                                                           const uint32_t reduce,
+                                                           const uint32_t layers,
+                                                           const int32_t x0,
+                                                           const int32_t y0,
+                                                           const int32_t x1,
+                                                           const int32_t y1,
+                                                           const int32_t format,
+                                                           const uint32_t flags,
+                                                           const int32_t num_threads,
+                                                           const uint32_t max_pending,
+                                                           const extensions_cancel_token_t* token,
+                                                           const extensions_tiles_callback callback,
+                                                           void* user_data)
+{
+    extensions_decode_options_t options;
+    options.reduce = reduce;
+    options.layers = layers;
+    options.x0 = x0;
+    options.y0 = y0;
+    options.x1 = x1;
+    options.y1 = y1;
+    options.num_threads = num_threads;
+    options.token = token;
+
+    extensions_decoder_t decoder;
+    auto ret = extensions_decoder_open(&decoder, data, data_len, &options);
+    if (ret != ERR_OK)
+        return ret;
+
+    extensions_pixels_tile_image_t tile_image;
+    std::vector<uint8_t> buffer;
+
+    if (max_pending == 0)
+    {
+        std::vector<uint8_t> converted;
+        ret = extensions_decoder_decode_tiles(&decoder, buffer, [&](const extensions_tile_t& tile)
+        {
+            if (extensions_tiles_is_empty(tile))
+                return ERR_OK;
+
+            extensions_tiles_pixels_t pixels;
+            const auto converted_ret = extensions_tiles_convert(&decoder, tile, format, flags, &tile_image, converted, &pixels);
+            if (converted_ret != ERR_OK)
+                return converted_ret;
+            return callback(&pixels, user_data);
+        });
+
+        extensions_decoder_close(&decoder);
+        return ret;
+    }
+
+    extensions_tiles_pipeline_t pipeline;
+    pipeline.callback = callback;
+    pipeline.user_data = user_data;
+    pipeline.max_pending = max_pending;
+    pipeline.status = ERR_OK;
+    pipeline.finished = false;
+
+    std::thread delivery(extensions_tiles_deliver, &pipeline);
+
+    ret = extensions_decoder_decode_tiles(&decoder, buffer, [&](const extensions_tile_t& tile)
+    {
+        if (extensions_tiles_is_empty(tile))
+            return ERR_OK;
+
+        auto item = extensions_tiles_acquire(&pipeline);
+        if (item == nullptr)
+            return pipeline.status;
+
+        const auto converted_ret = extensions_tiles_convert(&decoder, tile, format, flags, &tile_image, item->buffer, &item->pixels);
+
+        std::lock_guard<std::mutex> lock(pipeline.mutex);
+        if (converted_ret != ERR_OK)
+        {
+            pipeline.free_items.push_back(item);
+            return converted_ret;
+        }
+
+        pipeline.ready.push_back(item);
+        pipeline.changed.notify_all();
+        return ERR_OK;
+    });
+
+    {
+        std::lock_guard<std::mutex> lock(pipeline.mutex);
+        pipeline.finished = true;
+        pipeline.changed.notify_all();
+    }
+    delivery.join();
+    extensions_decoder_close(&decoder);
+
+    // The callback may have failed after the last tile was decoded
+    return ret != ERR_OK ? ret : pipeline.status;
+}
+
+#endif // _CPP_OPENJPEG_OPENJP2_EXTENSIONS_TILES_H_
\ No newline at end of file
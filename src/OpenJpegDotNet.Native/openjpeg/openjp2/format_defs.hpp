@@ -0,0 +1,28 @@
+#ifndef _CPP_OPENJPEG_OPENJP2_FORMAT_DEFS_H_
+#define _CPP_OPENJPEG_OPENJP2_FORMAT_DEFS_H_
+
+// https://github.com/uclouvain/openjpeg/blob/version.2.1/src/bin/common/format_defs.h
+#ifndef _OPJ_FORMAT_DEFS_H_
+#define _OPJ_FORMAT_DEFS_H_
+
+#define J2K_CFMT 0
+#define JP2_CFMT 1
+#define JPT_CFMT 2
+
+#define PXM_DFMT 10
+#define PGX_DFMT 11
+#define BMP_DFMT 12
+#define YUV_DFMT 13
+#define TIF_DFMT 14
+#define RAW_DFMT 15 /* MSB / Big Endian */
+#define TGA_DFMT 16
+#define PNG_DFMT 17
+#define RAWL_DFMT 18 /* LSB / Little Endian */
+
+#endif /* _OPJ_FORMAT_DEFS_H_ */
+
+// https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/bin/jp2/opj_decompress.c#L427
+// defined in opj_decompress.cpp
+int get_file_format(const char *filename);
+
+#endif // _CPP_OPENJPEG_OPENJP2_FORMAT_DEFS_H_
\ No newline at end of file
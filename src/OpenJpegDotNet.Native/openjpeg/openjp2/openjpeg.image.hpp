@@ -196,6 +196,11 @@ DLLEXPORT const uint16_t openjpeg_openjp2_opj_image_comp_t_get_alpha(opj_image_c
     return comp->alpha;
 }
 
+DLLEXPORT void openjpeg_openjp2_opj_image_comp_t_set_alpha(opj_image_comp_t* comp, const uint16_t value)
+{
+    comp->alpha = value;
+}
+
 DLLEXPORT const uint32_t openjpeg_openjp2_opj_image_comp_t_get_bpp(opj_image_comp_t* comp)
 {
     return comp->bpp;
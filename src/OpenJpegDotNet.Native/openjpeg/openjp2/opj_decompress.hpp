@@ -15,25 +15,7 @@
 #include <sys/times.h>
 #endif /* _WIN32 */
 
-// https://github.com/uclouvain/openjpeg/blob/version.2.1/src/bin/common/format_defs.h
-#ifndef _OPJ_FORMAT_DEFS_H_
-#define _OPJ_FORMAT_DEFS_H_
-
-#define J2K_CFMT 0
-#define JP2_CFMT 1
-#define JPT_CFMT 2
-
-#define PXM_DFMT 10
-#define PGX_DFMT 11
-#define BMP_DFMT 12
-#define YUV_DFMT 13
-#define TIF_DFMT 14
-#define RAW_DFMT 15 /* MSB / Big Endian */
-#define TGA_DFMT 16
-#define PNG_DFMT 17
-#define RAWL_DFMT 18 /* LSB / Little Endian */
-
-#endif /* _OPJ_FORMAT_DEFS_H_ */
+#include "format_defs.hpp"
 
 // https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/bin/jp2/opj_decompress.c#L427
 int get_file_format(const char *filename)
@@ -16,10 +16,16 @@
 #define ERR_GENERAL_FILE_IO                         -(ERR_GENERAL_ERROR | 0x00000001)
 #define ERR_GENERAL_OUT_OF_RANGE                    -(ERR_GENERAL_ERROR | 0x00000002)
 #define ERR_GENERAL_MEMALLOC                        -(ERR_GENERAL_ERROR | 0x00000003)
+#define ERR_GENERAL_END_OF_DATA                     -(ERR_GENERAL_ERROR | 0x00000004)
+#define ERR_GENERAL_CANCELLED                       -(ERR_GENERAL_ERROR | 0x00000005)
+#define ERR_GENERAL_DEADLINE_EXCEEDED               -(ERR_GENERAL_ERROR | 0x00000006)
+#define ERR_GENERAL_OVER_BUDGET                     -(ERR_GENERAL_ERROR | 0x00000007)
 
 // Image
 #define ERR_IMAGE_ERROR                                                   0x77000000
 #define ERR_IMAGE_FILE_INVALID                        -(ERR_IMAGE_ERROR | 0x00000001)
 #define ERR_IMAGE_FILE_WRONG_EXTENSION                -(ERR_IMAGE_ERROR | 0x00000002)
+#define ERR_IMAGE_DECODE_FAILED                       -(ERR_IMAGE_ERROR | 0x00000003)
+#define ERR_IMAGE_ENCODE_FAILED                       -(ERR_IMAGE_ERROR | 0x00000004)
 
 #endif
\ No newline at end of file
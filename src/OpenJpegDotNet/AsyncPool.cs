@@ -0,0 +1,191 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using System.Threading.Tasks;
+
+namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Runs decodes and encodes on native threads and reports their completion through a <see cref="Task"/>. This class cannot be inherited.
+    /// </summary>
+    public sealed class AsyncPool : OpenJpegObject
+    {
+
+        #region Fields
+
+        // Shared by every job and never collected, so the native threads can always call back
+        private static readonly DelegateHandler<AsyncCompletionCallback> Handler = new DelegateHandler<AsyncCompletionCallback>(OnCompleted);
+
+        #endregion
+
+        #region Constructors
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="AsyncPool"/> class with the specified number of threads.
+        /// </summary>
+        /// <param name="numberOfThreads">The number of native threads. 0 means one per CPU.</param>
+        public AsyncPool(int numberOfThreads = 0)
+        {
+            this.NativePtr = NativeMethods.openjpeg_openjp2_extensions_async_pool_new(numberOfThreads);
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Decodes an image as <see cref="OpenJpeg.Decode"/> followed by <see cref="OpenJpeg.EndDecompress"/> do, on a native thread.
+        /// </summary>
+        /// <param name="codec">The Jpeg 2000 codec to read, set up and with its header read.</param>
+        /// <param name="stream">The Jpeg 2000 stream.</param>
+        /// <param name="image">The image that receives decoded datum.</param>
+        /// <returns>A <see cref="Task"/> which completes once the image is decoded. <paramref name="codec"/>, <paramref name="stream"/> and <paramref name="image"/> must not be used or disposed until then.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="codec"/>, <paramref name="stream"/> or <paramref name="image"/> is null.</exception>
+        /// <exception cref="ObjectDisposedException">This object, <paramref name="codec"/>, <paramref name="stream"/> or <paramref name="image"/> is disposed.</exception>
+        public Task DecodeAsync(Codec codec, Stream stream, Image image)
+        {
+            if (codec == null)
+                throw new ArgumentNullException(nameof(codec));
+            if (stream == null)
+                throw new ArgumentNullException(nameof(stream));
+            if (image == null)
+                throw new ArgumentNullException(nameof(image));
+
+            this.ThrowIfDisposed();
+            codec.ThrowIfDisposed();
+            stream.ThrowIfDisposed();
+            image.ThrowIfDisposed();
+
+            var job = new Job(codec, stream, image);
+            var handle = GCHandle.Alloc(job);
+            var ret = NativeMethods.openjpeg_openjp2_extensions_async_decode(this.NativePtr,
+                                                                            codec.NativePtr,
+                                                                            stream.NativePtr,
+                                                                            image.NativePtr,
+                                                                            Handler.Handle,
+                                                                            GCHandle.ToIntPtr(handle));
+
+            // The pool holds the job on its own until the callback has returned
+            NativeMethods.openjpeg_openjp2_extensions_async_job_delete(ret);
+            return job.Completion.Task;
+        }
+
+        /// <summary>
+        /// Encodes an image as <see cref="OpenJpeg.StartCompress"/>, <see cref="OpenJpeg.Encode"/> and <see cref="OpenJpeg.EndCompress"/> do in a row, on a native thread.
+        /// </summary>
+        /// <param name="codec">The Jpeg 2000 codec to write, set up with <see cref="OpenJpeg.SetupEncoder"/>.</param>
+        /// <param name="image">The image to encode.</param>
+        /// <param name="stream">The Jpeg 2000 stream.</param>
+        /// <returns>A <see cref="Task"/> which completes once the image is encoded. <paramref name="codec"/>, <paramref name="image"/> and <paramref name="stream"/> must not be used or disposed until then.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="codec"/>, <paramref name="image"/> or <paramref name="stream"/> is null.</exception>
+        /// <exception cref="ObjectDisposedException">This object, <paramref name="codec"/>, <paramref name="image"/> or <paramref name="stream"/> is disposed.</exception>
+        public Task EncodeAsync(Codec codec, Image image, Stream stream)
+        {
+            if (codec == null)
+                throw new ArgumentNullException(nameof(codec));
+            if (image == null)
+                throw new ArgumentNullException(nameof(image));
+            if (stream == null)
+                throw new ArgumentNullException(nameof(stream));
+
+            this.ThrowIfDisposed();
+            codec.ThrowIfDisposed();
+            image.ThrowIfDisposed();
+            stream.ThrowIfDisposed();
+
+            var job = new Job(codec, stream, image);
+            var handle = GCHandle.Alloc(job);
+            var ret = NativeMethods.openjpeg_openjp2_extensions_async_encode(this.NativePtr,
+                                                                            codec.NativePtr,
+                                                                            image.NativePtr,
+                                                                            stream.NativePtr,
+                                                                            Handler.Handle,
+                                                                            GCHandle.ToIntPtr(handle));
+
+            // The pool holds the job on its own until the callback has returned
+            NativeMethods.openjpeg_openjp2_extensions_async_job_delete(ret);
+            return job.Completion.Task;
+        }
+
+        #region Overrides
+
+        /// <summary>
+        /// Releases all unmanaged resources. Jobs already submitted still run and complete their tasks first.
+        /// </summary>
+        protected override void DisposeUnmanaged()
+        {
+            base.DisposeUnmanaged();
+
+            if (this.NativePtr == IntPtr.Zero)
+                return;
+
+            NativeMethods.openjpeg_openjp2_extensions_async_pool_delete(this.NativePtr);
+        }
+
+        #endregion
+
+        #region Helpers
+
+        private static void OnCompleted(IntPtr job, int status, IntPtr userData)
+        {
+            var handle = GCHandle.FromIntPtr(userData);
+            var target = (Job)handle.Target;
+            handle.Free();
+
+            var error = (NativeMethods.ErrorType)status;
+            if (error == NativeMethods.ErrorType.OK)
+                target.Completion.SetResult(true);
+            else
+                target.Completion.SetException(ErrorHelper.ToException(error));
+        }
+
+        #endregion
+
+        #endregion
+
+        private sealed class Job
+        {
+
+            #region Constructors
+
+            public Job(Codec codec, Stream stream, Image image)
+            {
+                // Continuations must not run on the native thread
+                this.Completion = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
+                this.Codec = codec;
+                this.Stream = stream;
+                this.Image = image;
+            }
+
+            #endregion
+
+            #region Properties
+
+            public TaskCompletionSource<bool> Completion
+            {
+                get;
+            }
+
+            // Keep the objects the native thread works on reachable until the job completes
+            public Codec Codec
+            {
+                get;
+            }
+
+            public Stream Stream
+            {
+                get;
+            }
+
+            public Image Image
+            {
+                get;
+            }
+
+            #endregion
+
+        }
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+﻿namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Specifies the arrangement of bands in a raster.
+    /// </summary>
+    public enum BandLayout
+    {
+
+        /// <summary>
+        /// Specifies that band sequential: every row of a band, then the next band.
+        /// </summary>
+        Bsq = 0,
+
+        /// <summary>
+        /// Specifies that band interleaved by line: a row of every band, then the next row.
+        /// </summary>
+        Bil = 1,
+
+        /// <summary>
+        /// Specifies that band interleaved by pixel: every band of a pixel, then the next pixel.
+        /// </summary>
+        Bip = 2,
+
+    }
+
+}
\ No newline at end of file
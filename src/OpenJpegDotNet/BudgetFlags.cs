@@ -0,0 +1,30 @@
+﻿using System;
+
+namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Specifies the fallbacks allowed when a decode does not fit within a memory budget.
+    /// </summary>
+    [Flags]
+    public enum BudgetFlags
+    {
+
+        /// <summary>
+        /// Specifies that no fallback.
+        /// </summary>
+        None = 0,
+
+        /// <summary>
+        /// Specifies that the resolution may be reduced until the decode fits.
+        /// </summary>
+        AllowReduce = 1,
+
+        /// <summary>
+        /// Specifies that the image may be decoded tile by tile.
+        /// </summary>
+        AllowTiled = 2,
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+﻿namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Specifies how an admitted decode runs.
+    /// </summary>
+    public enum BudgetMode
+    {
+
+        /// <summary>
+        /// Specifies that the whole image is decoded at once.
+        /// </summary>
+        Full = 0,
+
+        /// <summary>
+        /// Specifies that the image is decoded tile by tile.
+        /// </summary>
+        Tiled = 1,
+
+    }
+
+}
\ No newline at end of file
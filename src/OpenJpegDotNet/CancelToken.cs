@@ -0,0 +1,91 @@
+﻿using System;
+
+namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Cancels a decode from another thread or once a deadline passes. This class cannot be inherited.
+    /// </summary>
+    public sealed class CancelToken : OpenJpegObject
+    {
+
+        #region Constructors
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="CancelToken"/> class with the specified deadline.
+        /// </summary>
+        /// <param name="timeout">The number of milliseconds after which decodes using this token stop. A negative value means no deadline.</param>
+        /// <exception cref="OutOfMemoryException">Failed to allocate the token.</exception>
+        public CancelToken(int timeout = -1)
+        {
+            this.NativePtr = NativeMethods.openjpeg_openjp2_extensions_cancel_token_new(timeout);
+            if (this.NativePtr == IntPtr.Zero)
+                throw new OutOfMemoryException();
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Gets a value indicating whether the token has been cancelled.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public bool IsCancellationRequested
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                return NativeMethods.openjpeg_openjp2_extensions_cancel_token_check(this.NativePtr) == NativeMethods.ErrorType.GeneralCancelled;
+            }
+        }
+
+        /// <summary>
+        /// Gets a value indicating whether the deadline of the token has passed.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public bool IsDeadlineExceeded
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                return NativeMethods.openjpeg_openjp2_extensions_cancel_token_check(this.NativePtr) == NativeMethods.ErrorType.GeneralDeadlineExceeded;
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Requests the decodes using this token to stop. This can be called from any thread.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public void Cancel()
+        {
+            this.ThrowIfDisposed();
+            NativeMethods.openjpeg_openjp2_extensions_cancel_token_cancel(this.NativePtr);
+        }
+
+        #region Overrides 
+
+        /// <summary>
+        /// Releases all unmanaged resources.
+        /// </summary>
+        protected override void DisposeUnmanaged()
+        {
+            base.DisposeUnmanaged();
+
+            if (this.NativePtr == IntPtr.Zero)
+                return;
+
+            NativeMethods.openjpeg_openjp2_extensions_cancel_token_delete(this.NativePtr);
+        }
+
+        #endregion
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
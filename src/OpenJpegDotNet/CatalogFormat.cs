@@ -0,0 +1,22 @@
+﻿namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Specifies the output format of a catalog.
+    /// </summary>
+    public enum CatalogFormat
+    {
+
+        /// <summary>
+        /// Specifies that comma separated values with a header row.
+        /// </summary>
+        Csv = 0,
+
+        /// <summary>
+        /// Specifies that one binary record per file in native byte order.
+        /// </summary>
+        Binary = 1,
+
+    }
+
+}
\ No newline at end of file
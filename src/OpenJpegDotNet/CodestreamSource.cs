@@ -0,0 +1,131 @@
+﻿using System;
+using System.Text;
+
+namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Holds a JPEG 2000 codestream or JP2 file which any number of decodes can read at the same time without copying it. This class cannot be inherited.
+    /// </summary>
+    public sealed class CodestreamSource : OpenJpegObject
+    {
+
+        #region Constructors
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="CodestreamSource"/> class with a copy of the specified data.
+        /// </summary>
+        /// <param name="data">The codestream or JP2 file.</param>
+        /// <exception cref="ArgumentNullException"><paramref name="data"/> is null.</exception>
+        /// <exception cref="OutOfMemoryException">Failed to allocate the source.</exception>
+        public CodestreamSource(byte[] data)
+        {
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+
+            unsafe
+            {
+                fixed (byte* ptr = data)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_source_new((IntPtr)ptr, (ulong)data.Length, out var source);
+                    ErrorHelper.ThrowIfError(ret);
+                    this.NativePtr = source;
+                }
+            }
+        }
+
+        private CodestreamSource(IntPtr ptr)
+        {
+            this.NativePtr = ptr;
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Creates a <see cref="CodestreamSource"/> which maps the specified file instead of reading it into memory.
+        /// </summary>
+        /// <param name="path">The path of the codestream or JP2 file.</param>
+        /// <returns>A new <see cref="CodestreamSource"/>.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="path"/> is null.</exception>
+        /// <exception cref="System.IO.IOException"><paramref name="path"/> can not be mapped.</exception>
+        public static CodestreamSource FromFile(string path)
+        {
+            if (path == null)
+                throw new ArgumentNullException(nameof(path));
+
+            var bytes = Encoding.UTF8.GetBytes(path);
+            var ret = NativeMethods.openjpeg_openjp2_extensions_source_new_file(bytes, (uint)bytes.Length, out var source);
+            ErrorHelper.ThrowIfError(ret);
+            return new CodestreamSource(source);
+        }
+
+        /// <summary>
+        /// Creates a read <see cref="Stream"/> positioned at the start of the source, to be used with a codec of its own.
+        /// </summary>
+        /// <param name="token">The token whose cancellation makes the stream fail, or null.</param>
+        /// <returns>A new <see cref="Stream"/>.</returns>
+        /// <exception cref="ObjectDisposedException">This object or <paramref name="token"/> is disposed.</exception>
+        public Stream CreateStream(CancelToken token = null)
+        {
+            this.ThrowIfDisposed();
+            token?.ThrowIfDisposed();
+
+            var ret = NativeMethods.openjpeg_openjp2_extensions_source_create_stream(this.NativePtr, token?.NativePtr ?? IntPtr.Zero);
+            return ret != IntPtr.Zero ? new Stream(ret) : null;
+        }
+
+        /// <summary>
+        /// Decodes the source tile by tile, as <see cref="OpenJpeg.DecodeMemory"/> does, without copying it.
+        /// </summary>
+        /// <param name="options">The options of the decode, or null for the whole image at full resolution.</param>
+        /// <returns>The decoded <see cref="Image"/>.</returns>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        /// <exception cref="System.IO.InvalidDataException">The source is not a valid codestream or JP2 file.</exception>
+        /// <exception cref="OperationCanceledException">The decode was cancelled through <see cref="DecodeOptions.Token"/>.</exception>
+        /// <exception cref="TimeoutException">The deadline of <see cref="DecodeOptions.Token"/> passed.</exception>
+        public Image Decode(DecodeOptions options = null)
+        {
+            this.ThrowIfDisposed();
+
+            options = options ?? new DecodeOptions();
+            var token = options.GetTokenPtr();
+            var area = options.Area;
+
+            var ret = NativeMethods.openjpeg_openjp2_extensions_source_decode(this.NativePtr,
+                                                                              options.Reduce,
+                                                                              options.Layers,
+                                                                              area.Left,
+                                                                              area.Top,
+                                                                              area.Right,
+                                                                              area.Bottom,
+                                                                              options.NumberOfThreads,
+                                                                              token,
+                                                                              out var image);
+            ErrorHelper.ThrowIfError(ret);
+            return new Image(image);
+        }
+
+        #region Overrides 
+
+        /// <summary>
+        /// Releases all unmanaged resources.
+        /// </summary>
+        protected override void DisposeUnmanaged()
+        {
+            base.DisposeUnmanaged();
+
+            if (this.NativePtr == IntPtr.Zero)
+                return;
+
+            NativeMethods.openjpeg_openjp2_extensions_source_release(this.NativePtr);
+        }
+
+        #endregion
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,194 @@
+﻿using System;
+
+namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Keeps converted pixels of recent decodes so that repeated requests for the same data and options skip the decode. This class cannot be inherited.
+    /// </summary>
+    public sealed class DecodeCache : OpenJpegObject
+    {
+
+        #region Constructors
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="DecodeCache"/> class with the specified capacity.
+        /// </summary>
+        /// <param name="maxBytes">The number of bytes of pixels and input data kept before the least recently used entries are evicted.</param>
+        /// <exception cref="OutOfMemoryException">Failed to allocate the cache.</exception>
+        public DecodeCache(ulong maxBytes)
+        {
+            this.NativePtr = NativeMethods.openjpeg_openjp2_extensions_cache_new(maxBytes);
+            if (this.NativePtr == IntPtr.Zero)
+                throw new OutOfMemoryException();
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the number of bytes of pixels and input data held by the cache.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public ulong Bytes
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                NativeMethods.openjpeg_openjp2_extensions_cache_get_stats(this.NativePtr, out _, out _, out _, out _, out var bytes);
+                return bytes;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of entries held by the cache.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public ulong Entries
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                NativeMethods.openjpeg_openjp2_extensions_cache_get_stats(this.NativePtr, out _, out _, out _, out var entries, out _);
+                return entries;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of entries evicted to stay within the capacity.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public ulong Evictions
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                NativeMethods.openjpeg_openjp2_extensions_cache_get_stats(this.NativePtr, out _, out _, out var evictions, out _, out _);
+                return evictions;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of requests served from the cache.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public ulong Hits
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                NativeMethods.openjpeg_openjp2_extensions_cache_get_stats(this.NativePtr, out var hits, out _, out _, out _, out _);
+                return hits;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of requests which had to decode.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public ulong Misses
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                NativeMethods.openjpeg_openjp2_extensions_cache_get_stats(this.NativePtr, out _, out var misses, out _, out _, out _);
+                return misses;
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Removes every entry.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public void Clear()
+        {
+            this.ThrowIfDisposed();
+            NativeMethods.openjpeg_openjp2_extensions_cache_clear(this.NativePtr);
+        }
+
+        /// <summary>
+        /// Returns the pixels of a JPEG 2000 codestream or JP2 file held in memory, decoding only when they are not cached.
+        /// </summary>
+        /// <param name="data">The codestream or JP2 file.</param>
+        /// <param name="format">The pixel format.</param>
+        /// <param name="options">The options of the decode, or null for the whole image at full resolution. <see cref="DecodeOptions.Token"/> is not used.</param>
+        /// <param name="flags">The options of the conversion.</param>
+        /// <returns>The converted pixels.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="data"/> is null.</exception>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="data"/> is not a valid codestream or JP2 file.</exception>
+        public Pixels Decode(byte[] data, ExportFormat format, DecodeOptions options = null, ExportFlags flags = ExportFlags.None)
+        {
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+
+            this.ThrowIfDisposed();
+
+            options = options ?? new DecodeOptions();
+            var area = options.Area;
+
+            unsafe
+            {
+                fixed (byte* ptr = data)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_cache_decode(this.NativePtr,
+                                                                                     (IntPtr)ptr,
+                                                                                     (ulong)data.Length,
+                                                                                     options.Reduce,
+                                                                                     options.Layers,
+                                                                                     area.Left,
+                                                                                     area.Top,
+                                                                                     area.Right,
+                                                                                     area.Bottom,
+                                                                                     (int)format,
+                                                                                     (uint)flags,
+                                                                                     options.NumberOfThreads,
+                                                                                     out var entry);
+                    ErrorHelper.ThrowIfError(ret);
+
+                    try
+                    {
+                        NativeMethods.openjpeg_openjp2_extensions_cache_entry_get_pixels(entry,
+                                                                                         out var pixels,
+                                                                                         out var length,
+                                                                                         out var width,
+                                                                                         out var height,
+                                                                                         out var channels,
+                                                                                         out var bits);
+                        return Pixels.Copy(pixels, length, width, height, channels, bits);
+                    }
+                    finally
+                    {
+                        NativeMethods.openjpeg_openjp2_extensions_cache_entry_release(entry);
+                    }
+                }
+            }
+        }
+
+        #region Overrides 
+
+        /// <summary>
+        /// Releases all unmanaged resources.
+        /// </summary>
+        protected override void DisposeUnmanaged()
+        {
+            base.DisposeUnmanaged();
+
+            if (this.NativePtr == IntPtr.Zero)
+                return;
+
+            NativeMethods.openjpeg_openjp2_extensions_cache_delete(this.NativePtr);
+        }
+
+        #endregion
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+﻿using System;
+using System.Drawing;
+
+namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Defines the options shared by the decode functions of the extensions. This class cannot be inherited.
+    /// </summary>
+    public sealed class DecodeOptions
+    {
+
+        #region Properties
+
+        /// <summary>
+        /// Gets or sets the area to decode on the reference grid. <see cref="Rectangle.Empty"/> means the whole image.
+        /// </summary>
+        public Rectangle Area
+        {
+            get;
+            set;
+        }
+
+        /// <summary>
+        /// Gets or sets the number of quality layers to decode. 0 means every layer.
+        /// </summary>
+        public uint Layers
+        {
+            get;
+            set;
+        }
+
+        /// <summary>
+        /// Gets or sets the number of threads handed to each codec.
+        /// </summary>
+        public int NumberOfThreads
+        {
+            get;
+            set;
+        }
+
+        /// <summary>
+        /// Gets or sets the number of highest resolution levels to discard.
+        /// </summary>
+        public uint Reduce
+        {
+            get;
+            set;
+        }
+
+        /// <summary>
+        /// Gets or sets the token to cancel the decode with, or null.
+        /// </summary>
+        public CancelToken Token
+        {
+            get;
+            set;
+        }
+
+        #endregion
+
+        #region Methods
+
+        internal IntPtr GetTokenPtr()
+        {
+            if (this.Token == null)
+                return IntPtr.Zero;
+
+            this.Token.ThrowIfDisposed();
+            return this.Token.NativePtr;
+        }
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
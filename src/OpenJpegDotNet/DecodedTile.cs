@@ -0,0 +1,60 @@
+﻿namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Defines a tile handed over by a tile by tile decode. This class cannot be inherited.
+    /// </summary>
+    public sealed class DecodedTile
+    {
+
+        #region Constructors
+
+        internal DecodedTile(uint index, uint x, uint y, Pixels pixels)
+        {
+            this.Index = index;
+            this.X = x;
+            this.Y = y;
+            this.Pixels = pixels;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the tile index in the codestream.
+        /// </summary>
+        public uint Index
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the horizontal position of the tile in the decoded image.
+        /// </summary>
+        public uint X
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the vertical position of the tile in the decoded image.
+        /// </summary>
+        public uint Y
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the pixels of the tile.
+        /// </summary>
+        public Pixels Pixels
+        {
+            get;
+        }
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -53,4 +53,13 @@ namespace OpenJpegDotNet
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
     public delegate void StreamFreeUserData(IntPtr userData);
 
+    /// <summary>
+    /// Callback function prototype for completion of an asynchronous operation.
+    /// </summary>
+    /// <param name="job">The job handle which has completed.</param>
+    /// <param name="status">The error code of the operation.</param>
+    /// <param name="userData">The data pointer to have been passed when the operation was submitted.</param>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    public delegate void AsyncCompletionCallback(IntPtr job, int status, IntPtr userData);
+
 }
\ No newline at end of file
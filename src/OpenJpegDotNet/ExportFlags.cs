@@ -0,0 +1,35 @@
+﻿using System;
+
+namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Specifies the options of the pixel conversion.
+    /// </summary>
+    [Flags]
+    public enum ExportFlags
+    {
+
+        /// <summary>
+        /// Specifies that no option.
+        /// </summary>
+        None = 0,
+
+        /// <summary>
+        /// Specifies that sYCC, e-YCC and CMYK components are exported as they are instead of being converted to RGB.
+        /// </summary>
+        NoColorConversion = 1,
+
+        /// <summary>
+        /// Specifies that subsampled components are upsampled bilinearly instead of by replication.
+        /// </summary>
+        UpsampleBilinear = 2,
+
+        /// <summary>
+        /// Specifies that colors of <see cref="ExportFormat.Rgba32"/> and <see cref="ExportFormat.Bgra32"/> are multiplied by their alpha.
+        /// </summary>
+        PremultiplyAlpha = 4,
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+﻿namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Specifies the pixel layout of exported pixels.
+    /// </summary>
+    public enum ExportFormat
+    {
+
+        /// <summary>
+        /// Specifies that up to four planes one after another, with 8 bit samples when the precision fits and 16 bit ones otherwise.
+        /// </summary>
+        Planar = 0,
+
+        /// <summary>
+        /// Specifies that interleaved 8 bit red, green and blue samples.
+        /// </summary>
+        Rgb24 = 1,
+
+        /// <summary>
+        /// Specifies that interleaved 8 bit blue, green and red samples.
+        /// </summary>
+        Bgr24 = 2,
+
+        /// <summary>
+        /// Specifies that interleaved 8 bit red, green, blue and alpha samples. The alpha is opaque when no component is flagged as alpha.
+        /// </summary>
+        Rgba32 = 3,
+
+        /// <summary>
+        /// Specifies that interleaved 8 bit blue, green, red and alpha samples.
+        /// </summary>
+        Bgra32 = 4,
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+﻿namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Defines the header information of a component. This class cannot be inherited.
+    /// </summary>
+    public sealed class HeaderComponentInfo
+    {
+
+        #region Constructors
+
+        internal HeaderComponentInfo(uint dx, uint dy, uint precision, bool signed)
+        {
+            this.Dx = dx;
+            this.Dy = dy;
+            this.Precision = precision;
+            this.Signed = signed;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the horizontal separation of a sample of this component with respect to the reference grid.
+        /// </summary>
+        public uint Dx
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the vertical separation of a sample of this component with respect to the reference grid.
+        /// </summary>
+        public uint Dy
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the precision in bits.
+        /// </summary>
+        public uint Precision
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets a value indicating whether the samples are signed.
+        /// </summary>
+        public bool Signed
+        {
+            get;
+        }
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
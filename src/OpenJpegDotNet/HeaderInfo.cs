@@ -0,0 +1,258 @@
+﻿namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Defines the header information of a JPEG 2000 codestream or JP2 file. This class cannot be inherited.
+    /// </summary>
+    public sealed class HeaderInfo
+    {
+
+        #region Constructors
+
+        internal HeaderInfo(NativeMethods.extensions_header_info_t info, HeaderComponentInfo[] components)
+        {
+            this.Format = info.format;
+            this.X0 = info.x0;
+            this.Y0 = info.y0;
+            this.X1 = info.x1;
+            this.Y1 = info.y1;
+            this.TileX0 = info.tx0;
+            this.TileY0 = info.ty0;
+            this.TileWidth = info.tdx;
+            this.TileHeight = info.tdy;
+            this.TilesX = info.tw;
+            this.TilesY = info.th;
+            this.NumberOfComponents = info.numcomps;
+            this.NumberOfResolutions = info.numresolutions;
+            this.NumberOfLayers = info.numlayers;
+            this.ProgressionOrder = info.prog_order;
+            this.Mct = info.mct;
+            this.CodeBlockWidth = info.cblkw;
+            this.CodeBlockHeight = info.cblkh;
+            this.Irreversible = info.irreversible != 0;
+            this.Rsiz = info.rsiz;
+            this.ColorSpace = info.color_space;
+            this.HasIccProfile = info.has_icc_profile != 0;
+            this.HasXml = info.has_xml != 0;
+            this.CodestreamOffset = info.codestream_offset;
+            this.CodestreamLength = info.codestream_length;
+            this.Components = components;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the height of a code-block.
+        /// </summary>
+        public uint CodeBlockHeight
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the width of a code-block.
+        /// </summary>
+        public uint CodeBlockWidth
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the length of the codestream.
+        /// </summary>
+        public ulong CodestreamLength
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the offset of the codestream in the data.
+        /// </summary>
+        public ulong CodestreamOffset
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the color space.
+        /// </summary>
+        public ColorSpace ColorSpace
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the header information of the components.
+        /// </summary>
+        public HeaderComponentInfo[] Components
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the format of the data, <see cref="CodecFormat.J2k"/> or <see cref="CodecFormat.Jp2"/>.
+        /// </summary>
+        public CodecFormat Format
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets a value indicating whether the file carries an ICC profile.
+        /// </summary>
+        public bool HasIccProfile
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets a value indicating whether the file carries an XML box.
+        /// </summary>
+        public bool HasXml
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets a value indicating whether the irreversible wavelet transform is used.
+        /// </summary>
+        public bool Irreversible
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the multiple component transform.
+        /// </summary>
+        public uint Mct
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the number of components.
+        /// </summary>
+        public uint NumberOfComponents
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the number of quality layers.
+        /// </summary>
+        public uint NumberOfLayers
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the number of resolutions of the first tile-component.
+        /// </summary>
+        public uint NumberOfResolutions
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the progression order.
+        /// </summary>
+        public ProgressionOrder ProgressionOrder
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the capabilities of the codestream.
+        /// </summary>
+        public uint Rsiz
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the height of a tile.
+        /// </summary>
+        public uint TileHeight
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the width of a tile.
+        /// </summary>
+        public uint TileWidth
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the horizontal offset of the first tile.
+        /// </summary>
+        public uint TileX0
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the vertical offset of the first tile.
+        /// </summary>
+        public uint TileY0
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the number of tiles in a row.
+        /// </summary>
+        public uint TilesX
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the number of tiles in a column.
+        /// </summary>
+        public uint TilesY
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the horizontal offset from the origin of the reference grid to the left side of the image area.
+        /// </summary>
+        public uint X0
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the width of the reference grid.
+        /// </summary>
+        public uint X1
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the vertical offset from the origin of the reference grid to the top side of the image area.
+        /// </summary>
+        public uint Y0
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the height of the reference grid.
+        /// </summary>
+        public uint Y1
+        {
+            get;
+        }
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+﻿using System;
+using System.Runtime.InteropServices;
+
+namespace OpenJpegDotNet.IO
+{
+
+    /// <summary>
+    /// A write <see cref="OpenJpegDotNet.Stream"/> which collects what the codec writes in memory.
+    /// </summary>
+    internal sealed class MemoryOutput : IDisposable
+    {
+
+        #region Fields
+
+        private readonly System.IO.MemoryStream _Buffer;
+
+        private readonly DelegateHandler<StreamWrite> _WriteCallback;
+
+        private readonly DelegateHandler<StreamSeek> _SeekCallback;
+
+        private readonly DelegateHandler<StreamSkip> _SkipCallback;
+
+        #endregion
+
+        #region Constructors
+
+        public MemoryOutput()
+        {
+            this._Buffer = new System.IO.MemoryStream();
+
+            this._WriteCallback = new DelegateHandler<StreamWrite>(this.Write);
+            this._SeekCallback = new DelegateHandler<StreamSeek>(this.Seek);
+            this._SkipCallback = new DelegateHandler<StreamSkip>(this.Skip);
+
+            this.Stream = OpenJpeg.StreamDefaultCreate(false);
+            OpenJpeg.StreamSetWriteFunction(this.Stream, this._WriteCallback);
+            OpenJpeg.StreamSetSeekFunction(this.Stream, this._SeekCallback);
+            OpenJpeg.StreamSetSkipFunction(this.Stream, this._SkipCallback);
+        }
+
+        #endregion
+
+        #region Properties
+
+        public Stream Stream
+        {
+            get;
+        }
+
+        #endregion
+
+        #region Methods
+
+        public byte[] ToArray()
+        {
+            return this._Buffer.ToArray();
+        }
+
+        #region Event Handlers
+
+        private ulong Write(IntPtr buffer, ulong bytes, IntPtr userData)
+        {
+            var data = new byte[bytes];
+            Marshal.Copy(buffer, data, 0, data.Length);
+            this._Buffer.Write(data, 0, data.Length);
+            return bytes;
+        }
+
+        private int Seek(ulong bytes, IntPtr userData)
+        {
+            this._Buffer.Position = (long)bytes;
+            return 1;
+        }
+
+        private long Skip(ulong bytes, IntPtr userData)
+        {
+            this._Buffer.Position += (long)bytes;
+            return (long)bytes;
+        }
+
+        #endregion
+
+        #endregion
+
+        #region IDisposable Members
+
+        /// <summary>
+        /// Releases all resources used by this <see cref="MemoryOutput"/>.
+        /// </summary>
+        public void Dispose()
+        {
+            this.Stream.Dispose();
+            this._Buffer.Dispose();
+        }
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
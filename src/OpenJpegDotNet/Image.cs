@@ -20,6 +20,12 @@ namespace OpenJpegDotNet
             this.NativePtr = ptr;
         }
 
+        internal Image(IntPtr ptr, bool isEnabledDispose) :
+            base(isEnabledDispose)
+        {
+            this.NativePtr = ptr;
+        }
+
         #endregion
 
         #region Properties
@@ -398,6 +404,227 @@ namespace OpenJpegDotNet
             return new RawBitmap(raw, (int) width, (int) height, (int) channel);
         }
 
+        /// <summary>
+        /// Converts this <see cref="Image"/> to pixels of the specified format.
+        /// </summary>
+        /// <param name="format">The pixel format.</param>
+        /// <param name="flags">The options of the conversion.</param>
+        /// <returns>The converted pixels.</returns>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        /// <exception cref="NotSupportedException">This object can not be converted to <paramref name="format"/>.</exception>
+        public Pixels ExportPixels(ExportFormat format, ExportFlags flags = ExportFlags.None)
+        {
+            this.ThrowIfDisposed();
+
+            if (format == ExportFormat.Planar)
+            {
+                var err = NativeMethods.openjpeg_openjp2_extensions_imagetobmp(this.NativePtr,
+                                                                               false,
+                                                                               out var planes,
+                                                                               out var planesWidth,
+                                                                               out var planesHeight,
+                                                                               out var planesChannel,
+                                                                               out var planesPixel);
+                try
+                {
+                    if (err != NativeMethods.ErrorType.OK)
+                        throw new NotSupportedException("This object is not supported.");
+
+                    var length = (ulong)planesWidth * planesHeight * planesChannel * (planesPixel / 8);
+                    return Pixels.Copy(planes, length, planesWidth, planesHeight, planesChannel, planesPixel);
+                }
+                finally
+                {
+                    if (planes != IntPtr.Zero)
+                        NativeMethods.stdlib_free(planes);
+                }
+            }
+
+            var ret = NativeMethods.openjpeg_openjp2_extensions_export_get_info(this.NativePtr,
+                                                                                (int)format,
+                                                                                (uint)flags,
+                                                                                out var width,
+                                                                                out var height,
+                                                                                out var channels,
+                                                                                out var bits);
+            if (ret != NativeMethods.ErrorType.OK)
+                throw new NotSupportedException("This object is not supported.");
+
+            var stride = (ulong)width * channels * (bits / 8);
+            var data = new byte[stride * height];
+
+            unsafe
+            {
+                fixed (byte* dst = data)
+                {
+                    ret = NativeMethods.openjpeg_openjp2_extensions_export_pixels(this.NativePtr, (int)format, (uint)flags, (IntPtr)dst, stride, (ulong)data.Length);
+                    if (ret != NativeMethods.ErrorType.OK)
+                        throw new NotSupportedException("This object is not supported.");
+                }
+            }
+
+            return new Pixels(data, width, height, channels, bits);
+        }
+
+        /// <summary>
+        /// Copies a component of this <see cref="Image"/> on its own grid, rescaled from its precision to the specified sample type.
+        /// </summary>
+        /// <param name="component">The zero-based index of the component.</param>
+        /// <param name="sampleType">The sample type.</param>
+        /// <returns>The samples of the component, rows following each other without padding.</returns>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="component"/> is out of range.</exception>
+        public byte[] ExportComponent(uint component, SampleType sampleType)
+        {
+            this.ThrowIfDisposed();
+
+            var components = this.Components;
+            if (component >= components.Length)
+                throw new ArgumentOutOfRangeException(nameof(component));
+
+            var stride = (ulong)components[component].Width * GetSampleSize(sampleType);
+            var data = new byte[stride * components[component].Height];
+
+            unsafe
+            {
+                fixed (byte* dst = data)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_export_component(this.NativePtr, component, (int)sampleType, (IntPtr)dst, stride, (ulong)data.Length);
+                    ErrorHelper.ThrowIfError(ret);
+                }
+            }
+
+            return data;
+        }
+
+        /// <summary>
+        /// Copies components of this <see cref="Image"/> as one tightly packed block of bands, rescaled to the specified sample type.
+        /// </summary>
+        /// <param name="bands">The zero-based indices of the components, or null for every component in order. They must share the same grid.</param>
+        /// <param name="layout">The arrangement of the bands.</param>
+        /// <param name="sampleType">The sample type.</param>
+        /// <param name="threads">The number of threads to copy with.</param>
+        /// <returns>The samples of the bands.</returns>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="bands"/> is empty or out of range, or the bands do not share the same grid.</exception>
+        public byte[] ExportBands(uint[] bands, BandLayout layout, SampleType sampleType, int threads = 0)
+        {
+            this.ThrowIfDisposed();
+
+            var components = this.Components;
+            var first = bands == null ? 0 : bands.Length > 0 ? bands[0] : uint.MaxValue;
+            if (first >= components.Length)
+                throw new ArgumentOutOfRangeException(nameof(bands));
+
+            var count = (ulong)(bands?.Length ?? components.Length);
+            var data = new byte[(ulong)components[first].Width * components[first].Height * count * GetSampleSize(sampleType)];
+
+            unsafe
+            {
+                fixed (byte* dst = data)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_export_bands(this.NativePtr,
+                                                                                     bands,
+                                                                                     (uint)count,
+                                                                                     (int)layout,
+                                                                                     (int)sampleType,
+                                                                                     threads,
+                                                                                     (IntPtr)dst,
+                                                                                     (ulong)data.Length);
+                    ErrorHelper.ThrowIfError(ret);
+                }
+            }
+
+            return data;
+        }
+
+        /// <summary>
+        /// Fills the components of this <see cref="Image"/> from interleaved pixels whose rows follow each other without padding.
+        /// </summary>
+        /// <param name="source">The pixels.</param>
+        /// <param name="channels">The number of channels, each of which goes to the component of the same index.</param>
+        /// <param name="sampleBytes">The size of a sample in bytes, 1, 2 or 4.</param>
+        /// <exception cref="ArgumentNullException"><paramref name="source"/> is null.</exception>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="source"/> is too short or <paramref name="channels"/> exceeds the number of components.</exception>
+        public void ImportPixels(byte[] source, uint channels, uint sampleBytes)
+        {
+            this.ThrowIfDisposed();
+
+            var components = this.Components;
+            if (components.Length == 0)
+                throw new ArgumentOutOfRangeException(nameof(channels));
+
+            var pixelStride = (ulong)channels * sampleBytes;
+            this.ImportPixels(source, channels, sampleBytes, pixelStride, pixelStride * components[0].Width, sampleBytes);
+        }
+
+        /// <summary>
+        /// Fills the components of this <see cref="Image"/> from pixels of any layout.
+        /// </summary>
+        /// <param name="source">The pixels. Sample c of pixel (x, y) is read at c * <paramref name="channelStride"/> + y * <paramref name="rowStride"/> + x * <paramref name="pixelStride"/>.</param>
+        /// <param name="channels">The number of channels, each of which goes to the component of the same index.</param>
+        /// <param name="sampleBytes">The size of a sample in bytes, 1, 2 or 4.</param>
+        /// <param name="pixelStride">The number of bytes between two pixels of a row.</param>
+        /// <param name="rowStride">The number of bytes between two rows.</param>
+        /// <param name="channelStride">The number of bytes between two channels of a pixel.</param>
+        /// <param name="bigEndian">true if samples wider than a byte are big endian; otherwise, false.</param>
+        /// <param name="threads">The number of threads to copy with. 0 or less means one per CPU.</param>
+        /// <exception cref="ArgumentNullException"><paramref name="source"/> is null.</exception>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="source"/> is too short or <paramref name="channels"/> exceeds the number of components.</exception>
+        public void ImportPixels(byte[] source,
+                                 uint channels,
+                                 uint sampleBytes,
+                                 ulong pixelStride,
+                                 ulong rowStride,
+                                 ulong channelStride,
+                                 bool bigEndian = false,
+                                 int threads = 0)
+        {
+            if (source == null)
+                throw new ArgumentNullException(nameof(source));
+
+            this.ThrowIfDisposed();
+
+            unsafe
+            {
+                fixed (byte* src = source)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_import_pixels(this.NativePtr,
+                                                                                      (IntPtr)src,
+                                                                                      (ulong)source.Length,
+                                                                                      channels,
+                                                                                      sampleBytes,
+                                                                                      pixelStride,
+                                                                                      rowStride,
+                                                                                      channelStride,
+                                                                                      bigEndian ? NativeMethods.EXTENSIONS_IMPORT_BIG_ENDIAN : 0,
+                                                                                      threads);
+                    ErrorHelper.ThrowIfError(ret);
+                }
+            }
+        }
+
+        #region Helpers
+
+        internal static uint GetSampleSize(SampleType sampleType)
+        {
+            switch (sampleType)
+            {
+                case SampleType.UInt8:
+                    return 1;
+                case SampleType.UInt16:
+                    return 2;
+                case SampleType.Float32:
+                    return 4;
+                default:
+                    throw new ArgumentOutOfRangeException(nameof(sampleType));
+            }
+        }
+
+        #endregion
+
         #endregion
 
         #region Overrides 
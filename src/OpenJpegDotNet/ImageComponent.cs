@@ -23,7 +23,7 @@ namespace OpenJpegDotNet
         //data(opj_image_comp_t* comp)
 
         /// <summary>
-        /// Get the alpha channel.
+        /// Get or set the alpha channel. 0 is a color channel, 1 a straight alpha channel and 2 a premultiplied one.
         /// </summary>
         /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
         public ushort Alpha
@@ -33,6 +33,11 @@ namespace OpenJpegDotNet
                 this.ThrowIfDisposed();
                 return NativeMethods.openjpeg_openjp2_opj_image_comp_t_get_alpha(this.NativePtr);
             }
+            set
+            {
+                this.ThrowIfDisposed();
+                NativeMethods.openjpeg_openjp2_opj_image_comp_t_set_alpha(this.NativePtr, value);
+            }
         }
 
         /// <summary>
@@ -0,0 +1,212 @@
+﻿using System;
+using System.Linq;
+
+namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Recycles the planes of released images for later images of the same shape, whether they are created, decoded or frames of a <see cref="SequenceDecoder"/>. This class cannot be inherited.
+    /// </summary>
+    public sealed class ImagePool : OpenJpegObject
+    {
+
+        #region Constructors
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="ImagePool"/> class with the specified capacity.
+        /// </summary>
+        /// <param name="maxBytes">The number of bytes of planes kept for reuse.</param>
+        /// <exception cref="OutOfMemoryException">Failed to allocate the pool.</exception>
+        public ImagePool(ulong maxBytes)
+        {
+            this.NativePtr = NativeMethods.openjpeg_openjp2_extensions_image_pool_new(maxBytes);
+            if (this.NativePtr == IntPtr.Zero)
+                throw new OutOfMemoryException();
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the number of requests served by a pooled image.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public ulong Hits
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                NativeMethods.openjpeg_openjp2_extensions_image_pool_get_stats(this.NativePtr, out var hits, out _, out _, out _);
+                return hits;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of requests which had to allocate a new image.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public ulong Misses
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                NativeMethods.openjpeg_openjp2_extensions_image_pool_get_stats(this.NativePtr, out _, out var misses, out _, out _);
+                return misses;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of bytes held by the pooled images.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public ulong PooledBytes
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                NativeMethods.openjpeg_openjp2_extensions_image_pool_get_stats(this.NativePtr, out _, out _, out _, out var bytes);
+                return bytes;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of images waiting for reuse.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public ulong PooledImages
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                NativeMethods.openjpeg_openjp2_extensions_image_pool_get_stats(this.NativePtr, out _, out _, out var images, out _);
+                return images;
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Creates an image as <see cref="OpenJpeg.ImageCreate"/> does, reusing a pooled image of the same shape when available. The planes of a reused image are not cleared.
+        /// </summary>
+        /// <param name="componentsParameters">The components parameters.</param>
+        /// <param name="colorSpace">The image color space.</param>
+        /// <returns>A new <see cref="Image"/>, or null if it can not be created.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="componentsParameters"/> is null.</exception>
+        /// <exception cref="ObjectDisposedException">This object or an element of <paramref name="componentsParameters"/> is disposed.</exception>
+        public Image Acquire(ImageComponentParameters[] componentsParameters, ColorSpace colorSpace)
+        {
+            if (componentsParameters == null)
+                throw new ArgumentNullException(nameof(componentsParameters));
+
+            this.ThrowIfDisposed();
+            foreach (var componentsParameter in componentsParameters)
+                componentsParameter.ThrowIfDisposed();
+
+            var pointers = componentsParameters.Select(parameters => parameters.NativePtr).ToArray();
+            var ret = NativeMethods.openjpeg_openjp2_extensions_image_pool_acquire(this.NativePtr, (uint)pointers.Length, pointers, (uint)pointers.Length, colorSpace);
+            return ret != IntPtr.Zero ? new Image(ret) : null;
+        }
+
+        /// <summary>
+        /// Decodes a JPEG 2000 codestream or JP2 file held in memory as <see cref="OpenJpeg.DecodeMemory"/> does, into a pooled image of the same shape when available.
+        /// </summary>
+        /// <param name="data">The codestream or JP2 file.</param>
+        /// <param name="options">The options of the decode, or null for the whole image at full resolution.</param>
+        /// <returns>The decoded <see cref="Image"/>, to be handed back with <see cref="Release"/>.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="data"/> is null.</exception>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="data"/> is not a valid codestream or JP2 file.</exception>
+        /// <exception cref="OperationCanceledException">The decode was cancelled through <see cref="DecodeOptions.Token"/>.</exception>
+        /// <exception cref="TimeoutException">The deadline of <see cref="DecodeOptions.Token"/> passed.</exception>
+        public Image Decode(byte[] data, DecodeOptions options = null)
+        {
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+
+            this.ThrowIfDisposed();
+
+            options = options ?? new DecodeOptions();
+            var token = options.GetTokenPtr();
+            var area = options.Area;
+
+            unsafe
+            {
+                fixed (byte* ptr = data)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_image_pool_decode_memory(this.NativePtr,
+                                                                                                 (IntPtr)ptr,
+                                                                                                 (ulong)data.Length,
+                                                                                                 options.Reduce,
+                                                                                                 options.Layers,
+                                                                                                 area.Left,
+                                                                                                 area.Top,
+                                                                                                 area.Right,
+                                                                                                 area.Bottom,
+                                                                                                 options.NumberOfThreads,
+                                                                                                 token,
+                                                                                                 out var image);
+                    ErrorHelper.ThrowIfError(ret);
+                    return new Image(image);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Hands an image over to the pool, which recycles its planes or destroys it. The image is disposed.
+        /// </summary>
+        /// <param name="image">The image to release. Any image may be released, including decoded ones.</param>
+        /// <exception cref="ArgumentNullException"><paramref name="image"/> is null.</exception>
+        /// <exception cref="ObjectDisposedException">This object or <paramref name="image"/> is disposed.</exception>
+        /// <exception cref="ArgumentException"><paramref name="image"/> does not own its native image.</exception>
+        public void Release(Image image)
+        {
+            if (image == null)
+                throw new ArgumentNullException(nameof(image));
+
+            this.ThrowIfDisposed();
+            image.ThrowIfDisposed();
+            if (!image.IsEnableDispose)
+                throw new ArgumentException($"{nameof(image)} does not own its native image.", nameof(image));
+
+            NativeMethods.openjpeg_openjp2_extensions_image_pool_release(this.NativePtr, image.NativePtr);
+
+            // The pool owns the native image from now on
+            image.NativePtr = IntPtr.Zero;
+            image.Dispose();
+        }
+
+        /// <summary>
+        /// Destroys every pooled image.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public void Trim()
+        {
+            this.ThrowIfDisposed();
+            NativeMethods.openjpeg_openjp2_extensions_image_pool_trim(this.NativePtr);
+        }
+
+        #region Overrides 
+
+        /// <summary>
+        /// Releases all unmanaged resources.
+        /// </summary>
+        protected override void DisposeUnmanaged()
+        {
+            base.DisposeUnmanaged();
+
+            if (this.NativePtr == IntPtr.Zero)
+                return;
+
+            NativeMethods.openjpeg_openjp2_extensions_image_pool_delete(this.NativePtr);
+        }
+
+        #endregion
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
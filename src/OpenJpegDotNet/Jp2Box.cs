@@ -0,0 +1,69 @@
+﻿namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Defines the position of a box in a JP2 file. This class cannot be inherited.
+    /// </summary>
+    public sealed class Jp2Box
+    {
+
+        #region Constructors
+
+        internal Jp2Box(uint type, uint depth, ulong offset, ulong headerLength, ulong length)
+        {
+            this.Type = type;
+            this.Depth = depth;
+            this.Offset = offset;
+            this.HeaderLength = headerLength;
+            this.Length = length;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the box type, such as 0x6A703268 for 'jp2h'.
+        /// </summary>
+        public uint Type
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the nesting depth; top level boxes are 0.
+        /// </summary>
+        public uint Depth
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the offset of the box from the start of the file.
+        /// </summary>
+        public ulong Offset
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the length of the box header in bytes.
+        /// </summary>
+        public ulong HeaderLength
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the length of the whole box in bytes, header included.
+        /// </summary>
+        public ulong Length
+        {
+            get;
+        }
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+﻿using System;
+using System.Text;
+
+namespace OpenJpegDotNet
+{
+
+    public static partial class OpenJpeg
+    {
+
+        #region Methods
+
+        /// <summary>
+        /// Indexes every JPEG 2000 file under a directory into a catalog, reading only the head of each file.
+        /// </summary>
+        /// <param name="directory">The directory to scan.</param>
+        /// <param name="output">The path of the catalog to write.</param>
+        /// <param name="format">The format of the catalog.</param>
+        /// <param name="scanned">When this method returns, contains the number of files indexed.</param>
+        /// <param name="failed">When this method returns, contains the number of files which could not be parsed.</param>
+        /// <param name="recursive">true to descend into subdirectories; otherwise, false.</param>
+        /// <param name="headSize">The number of bytes read from the head of each file. 0 means the default size.</param>
+        /// <param name="tileSizes">true to record the compressed size of every tile; otherwise, false.</param>
+        /// <param name="threads">The number of concurrent readers. 0 or less means one per CPU.</param>
+        /// <exception cref="ArgumentNullException"><paramref name="directory"/> or <paramref name="output"/> is null.</exception>
+        /// <exception cref="System.IO.IOException"><paramref name="directory"/> can not be read or <paramref name="output"/> can not be written.</exception>
+        public static void CatalogScan(string directory,
+                                       string output,
+                                       CatalogFormat format,
+                                       out ulong scanned,
+                                       out ulong failed,
+                                       bool recursive = true,
+                                       uint headSize = 0,
+                                       bool tileSizes = false,
+                                       int threads = 0)
+        {
+            if (directory == null)
+                throw new ArgumentNullException(nameof(directory));
+            if (output == null)
+                throw new ArgumentNullException(nameof(output));
+
+            var directoryBytes = Encoding.UTF8.GetBytes(directory);
+            var outputBytes = Encoding.UTF8.GetBytes(output);
+            var ret = NativeMethods.openjpeg_openjp2_extensions_catalog_scan(directoryBytes,
+                                                                             (uint)directoryBytes.Length,
+                                                                             recursive,
+                                                                             outputBytes,
+                                                                             (uint)outputBytes.Length,
+                                                                             (int)format,
+                                                                             headSize,
+                                                                             tileSizes,
+                                                                             threads,
+                                                                             out scanned,
+                                                                             out failed);
+            ErrorHelper.ThrowIfError(ret);
+        }
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,220 @@
+﻿using System;
+using System.Drawing;
+
+namespace OpenJpegDotNet
+{
+
+    public static partial class OpenJpeg
+    {
+
+        #region Methods
+
+        /// <summary>
+        /// Decodes a JPEG 2000 codestream or JP2 file held in memory tile by tile.
+        /// </summary>
+        /// <param name="data">The codestream or JP2 file.</param>
+        /// <param name="options">The options of the decode, or null for the whole image at full resolution.</param>
+        /// <returns>The decoded <see cref="Image"/>.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="data"/> is null.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="data"/> is not a valid codestream or JP2 file.</exception>
+        /// <exception cref="OperationCanceledException">The decode was cancelled through <see cref="DecodeOptions.Token"/>.</exception>
+        /// <exception cref="TimeoutException">The deadline of <see cref="DecodeOptions.Token"/> passed.</exception>
+        public static Image DecodeMemory(byte[] data, DecodeOptions options = null)
+        {
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+
+            options = options ?? new DecodeOptions();
+            var token = options.GetTokenPtr();
+            var area = options.Area;
+
+            unsafe
+            {
+                fixed (byte* ptr = data)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_decode_memory((IntPtr)ptr,
+                                                                                      (ulong)data.Length,
+                                                                                      options.Reduce,
+                                                                                      options.Layers,
+                                                                                      area.Left,
+                                                                                      area.Top,
+                                                                                      area.Right,
+                                                                                      area.Bottom,
+                                                                                      options.NumberOfThreads,
+                                                                                      token,
+                                                                                      out var image);
+                    ErrorHelper.ThrowIfError(ret);
+                    return new Image(image);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Decodes a JPEG 2000 codestream or JP2 file held in memory on several codecs at once, each decoding its own tiles.
+        /// </summary>
+        /// <param name="data">The codestream or JP2 file.</param>
+        /// <param name="decoders">The maximum number of codecs decoding at once.</param>
+        /// <param name="options">The options of the decode, or null for the whole image at full resolution.</param>
+        /// <returns>The decoded <see cref="Image"/>.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="data"/> is null.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="data"/> is not a valid codestream or JP2 file.</exception>
+        /// <exception cref="OperationCanceledException">The decode was cancelled through <see cref="DecodeOptions.Token"/>.</exception>
+        /// <exception cref="TimeoutException">The deadline of <see cref="DecodeOptions.Token"/> passed.</exception>
+        public static Image ParallelDecodeMemory(byte[] data, uint decoders, DecodeOptions options = null)
+        {
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+
+            options = options ?? new DecodeOptions();
+            var token = options.GetTokenPtr();
+            var area = options.Area;
+
+            unsafe
+            {
+                fixed (byte* ptr = data)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_parallel_decode_memory((IntPtr)ptr,
+                                                                                               (ulong)data.Length,
+                                                                                               options.Reduce,
+                                                                                               options.Layers,
+                                                                                               area.Left,
+                                                                                               area.Top,
+                                                                                               area.Right,
+                                                                                               area.Bottom,
+                                                                                               decoders,
+                                                                                               options.NumberOfThreads,
+                                                                                               token,
+                                                                                               out var image);
+                    ErrorHelper.ThrowIfError(ret);
+                    return new Image(image);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Estimates the memory a decode of a JPEG 2000 codestream or JP2 file needs, from its header alone.
+        /// </summary>
+        /// <param name="data">The codestream or JP2 file, of which the main header is enough.</param>
+        /// <param name="reduce">The number of highest resolution levels to discard.</param>
+        /// <param name="area">The area to decode on the reference grid. <see cref="Rectangle.Empty"/> means the whole image.</param>
+        /// <param name="imageBytes">When this method returns, contains the bytes of the decoded image.</param>
+        /// <param name="tileBytes">When this method returns, contains the bytes the codec holds while decoding, for the parameters of every tile and the tile being decoded.</param>
+        /// <exception cref="ArgumentNullException"><paramref name="data"/> is null.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="data"/> is not a valid codestream or JP2 file.</exception>
+        public static void EstimateBudget(byte[] data, uint reduce, Rectangle area, out ulong imageBytes, out ulong tileBytes)
+        {
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+
+            unsafe
+            {
+                fixed (byte* ptr = data)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_budget_estimate((IntPtr)ptr,
+                                                                                        (ulong)data.Length,
+                                                                                        reduce,
+                                                                                        area.Left,
+                                                                                        area.Top,
+                                                                                        area.Right,
+                                                                                        area.Bottom,
+                                                                                        out imageBytes,
+                                                                                        out tileBytes);
+                    ErrorHelper.ThrowIfError(ret);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Decides how a decode of a JPEG 2000 codestream or JP2 file can run within a memory budget, from its header alone.
+        /// </summary>
+        /// <param name="data">The codestream or JP2 file, of which the main header is enough.</param>
+        /// <param name="budget">The memory budget in bytes.</param>
+        /// <param name="flags">The fallbacks allowed when the request does not fit.</param>
+        /// <param name="reduce">The number of highest resolution levels to discard.</param>
+        /// <param name="area">The area to decode on the reference grid. <see cref="Rectangle.Empty"/> means the whole image.</param>
+        /// <param name="admittedReduce">When this method returns, contains the reduce the decode fits at.</param>
+        /// <returns>How the decode runs within <paramref name="budget"/>.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="data"/> is null.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="data"/> is not a valid codestream or JP2 file.</exception>
+        /// <exception cref="InsufficientMemoryException">None of the allowed fallbacks fit within <paramref name="budget"/>.</exception>
+        public static BudgetMode AdmitBudget(byte[] data, ulong budget, BudgetFlags flags, uint reduce, Rectangle area, out uint admittedReduce)
+        {
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+
+            unsafe
+            {
+                fixed (byte* ptr = data)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_budget_admit((IntPtr)ptr,
+                                                                                     (ulong)data.Length,
+                                                                                     budget,
+                                                                                     (uint)flags,
+                                                                                     reduce,
+                                                                                     area.Left,
+                                                                                     area.Top,
+                                                                                     area.Right,
+                                                                                     area.Bottom,
+                                                                                     out admittedReduce,
+                                                                                     out var mode);
+                    ErrorHelper.ThrowIfError(ret);
+                    return (BudgetMode)mode;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Decodes a JPEG 2000 codestream or JP2 file held in memory after admitting the request against a memory budget.
+        /// </summary>
+        /// <param name="data">The codestream or JP2 file.</param>
+        /// <param name="budget">The memory budget in bytes.</param>
+        /// <param name="flags">The fallbacks allowed when the request does not fit. <see cref="BudgetFlags.AllowTiled"/> is not allowed because the whole image is returned.</param>
+        /// <param name="admittedReduce">When this method returns, contains the reduce the image was decoded at.</param>
+        /// <param name="options">The options of the decode, or null for the whole image at full resolution.</param>
+        /// <returns>The decoded <see cref="Image"/>.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="data"/> is null.</exception>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="flags"/> contains <see cref="BudgetFlags.AllowTiled"/>.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="data"/> is not a valid codestream or JP2 file.</exception>
+        /// <exception cref="InsufficientMemoryException">None of the allowed fallbacks fit within <paramref name="budget"/>.</exception>
+        /// <exception cref="OperationCanceledException">The decode was cancelled through <see cref="DecodeOptions.Token"/>.</exception>
+        /// <exception cref="TimeoutException">The deadline of <see cref="DecodeOptions.Token"/> passed.</exception>
+        public static Image DecodeMemoryWithBudget(byte[] data, ulong budget, BudgetFlags flags, out uint admittedReduce, DecodeOptions options = null)
+        {
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+            if ((flags & BudgetFlags.AllowTiled) != 0)
+                throw new ArgumentOutOfRangeException(nameof(flags));
+
+            options = options ?? new DecodeOptions();
+            var token = options.GetTokenPtr();
+            var area = options.Area;
+
+            unsafe
+            {
+                fixed (byte* ptr = data)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_budget_decode_memory((IntPtr)ptr,
+                                                                                             (ulong)data.Length,
+                                                                                             budget,
+                                                                                             (uint)flags,
+                                                                                             options.Reduce,
+                                                                                             options.Layers,
+                                                                                             area.Left,
+                                                                                             area.Top,
+                                                                                             area.Right,
+                                                                                             area.Bottom,
+                                                                                             options.NumberOfThreads,
+                                                                                             token,
+                                                                                             out var image,
+                                                                                             out admittedReduce);
+                    ErrorHelper.ThrowIfError(ret);
+                    return new Image(image);
+                }
+            }
+        }
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+﻿using System;
+using OpenJpegDotNet.IO;
+
+namespace OpenJpegDotNet
+{
+
+    public static partial class OpenJpeg
+    {
+
+        #region Methods
+
+        /// <summary>
+        /// Encodes an image into a JPEG 2000 codestream or JP2 file in memory.
+        /// </summary>
+        /// <param name="format">The format to encode to, <see cref="CodecFormat.J2k"/> or <see cref="CodecFormat.Jp2"/>.</param>
+        /// <param name="parameters">The compression parameters.</param>
+        /// <param name="image">The image to encode.</param>
+        /// <returns>The encoded codestream or JP2 file.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="parameters"/> or <paramref name="image"/> is null.</exception>
+        /// <exception cref="ObjectDisposedException"><paramref name="parameters"/> or <paramref name="image"/> is disposed.</exception>
+        /// <exception cref="InvalidOperationException">Failed to encode the image.</exception>
+        public static byte[] EncodeImage(CodecFormat format, CompressionParameters parameters, Image image)
+        {
+            if (parameters == null)
+                throw new ArgumentNullException(nameof(parameters));
+            if (image == null)
+                throw new ArgumentNullException(nameof(image));
+
+            parameters.ThrowIfDisposed();
+            image.ThrowIfDisposed();
+
+            using (var codec = CreateCompress(format))
+            using (var output = new MemoryOutput())
+            {
+                if (!SetupEncoder(codec, parameters, image) ||
+                    !StartCompress(codec, image, output.Stream) ||
+                    !Encode(codec, output.Stream) ||
+                    !EndCompress(codec, output.Stream))
+                    throw new InvalidOperationException("Failed to encode the image.");
+
+                return output.ToArray();
+            }
+        }
+
+        /// <summary>
+        /// Encodes interleaved pixels whose rows follow each other without padding into a JPEG 2000 codestream or JP2 file in memory.
+        /// </summary>
+        /// <param name="format">The format to encode to, <see cref="CodecFormat.J2k"/> or <see cref="CodecFormat.Jp2"/>.</param>
+        /// <param name="parameters">The compression parameters.</param>
+        /// <param name="source">The pixels.</param>
+        /// <param name="width">The width in pixels.</param>
+        /// <param name="height">The height in pixels.</param>
+        /// <param name="channels">The number of channels, each of which becomes a component.</param>
+        /// <param name="sampleBytes">The size of a sample in bytes, 1, 2 or 4.</param>
+        /// <param name="precision">The precision of the components in bits.</param>
+        /// <param name="colorSpace">The color space of the image.</param>
+        /// <returns>The encoded codestream or JP2 file.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="parameters"/> or <paramref name="source"/> is null.</exception>
+        /// <exception cref="ObjectDisposedException"><paramref name="parameters"/> is disposed.</exception>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="source"/> is too short or the description of the pixels is invalid.</exception>
+        /// <exception cref="InvalidOperationException">Failed to encode the pixels.</exception>
+        public static byte[] EncodePixels(CodecFormat format,
+                                          CompressionParameters parameters,
+                                          byte[] source,
+                                          uint width,
+                                          uint height,
+                                          uint channels,
+                                          uint sampleBytes,
+                                          uint precision,
+                                          ColorSpace colorSpace)
+        {
+            var pixelStride = (ulong)channels * sampleBytes;
+            return EncodePixels(format, parameters, source, width, height, channels, sampleBytes, pixelStride, pixelStride * width, sampleBytes, precision, false, colorSpace);
+        }
+
+        /// <summary>
+        /// Encodes pixels of any layout into a JPEG 2000 codestream or JP2 file in memory, one tile at a time, without building the whole <see cref="Image"/>.
+        /// </summary>
+        /// <param name="format">The format to encode to, <see cref="CodecFormat.J2k"/> or <see cref="CodecFormat.Jp2"/>.</param>
+        /// <param name="parameters">The compression parameters. A tile size of 1024 is applied when <see cref="CompressionParameters.TileSizeOn"/> is false.</param>
+        /// <param name="source">The pixels. Sample c of pixel (x, y) is read at c * <paramref name="channelStride"/> + y * <paramref name="rowStride"/> + x * <paramref name="pixelStride"/>.</param>
+        /// <param name="width">The width in pixels.</param>
+        /// <param name="height">The height in pixels.</param>
+        /// <param name="channels">The number of channels, each of which becomes a component.</param>
+        /// <param name="sampleBytes">The size of a sample in bytes, 1, 2 or 4.</param>
+        /// <param name="pixelStride">The number of bytes between two pixels of a row.</param>
+        /// <param name="rowStride">The number of bytes between two rows.</param>
+        /// <param name="channelStride">The number of bytes between two channels of a pixel.</param>
+        /// <param name="precision">The precision of the components in bits.</param>
+        /// <param name="signed">true if the samples are signed; otherwise, false.</param>
+        /// <param name="colorSpace">The color space of the image.</param>
+        /// <param name="bigEndian">true if samples wider than a byte are big endian; otherwise, false.</param>
+        /// <returns>The encoded codestream or JP2 file.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="parameters"/> or <paramref name="source"/> is null.</exception>
+        /// <exception cref="ObjectDisposedException"><paramref name="parameters"/> is disposed.</exception>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="source"/> is too short or the description of the pixels is invalid.</exception>
+        /// <exception cref="InvalidOperationException">Failed to encode the pixels.</exception>
+        public static byte[] EncodePixels(CodecFormat format,
+                                          CompressionParameters parameters,
+                                          byte[] source,
+                                          uint width,
+                                          uint height,
+                                          uint channels,
+                                          uint sampleBytes,
+                                          ulong pixelStride,
+                                          ulong rowStride,
+                                          ulong channelStride,
+                                          uint precision,
+                                          bool signed,
+                                          ColorSpace colorSpace,
+                                          bool bigEndian = false)
+        {
+            if (parameters == null)
+                throw new ArgumentNullException(nameof(parameters));
+            if (source == null)
+                throw new ArgumentNullException(nameof(source));
+
+            parameters.ThrowIfDisposed();
+
+            using (var codec = CreateCompress(format))
+            using (var output = new MemoryOutput())
+            {
+                unsafe
+                {
+                    fixed (byte* src = source)
+                    {
+                        var ret = NativeMethods.openjpeg_openjp2_extensions_encode_pixels(codec.NativePtr,
+                                                                                          parameters.NativePtr,
+                                                                                          (IntPtr)src,
+                                                                                          (ulong)source.Length,
+                                                                                          width,
+                                                                                          height,
+                                                                                          channels,
+                                                                                          sampleBytes,
+                                                                                          pixelStride,
+                                                                                          rowStride,
+                                                                                          channelStride,
+                                                                                          precision,
+                                                                                          signed,
+                                                                                          (int)colorSpace,
+                                                                                          bigEndian ? NativeMethods.EXTENSIONS_IMPORT_BIG_ENDIAN : 0,
+                                                                                          output.Stream.NativePtr);
+                        ErrorHelper.ThrowIfError(ret);
+                    }
+                }
+
+                return output.ToArray();
+            }
+        }
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
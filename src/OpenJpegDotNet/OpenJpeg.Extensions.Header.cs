@@ -0,0 +1,54 @@
+﻿using System;
+using System.Linq;
+
+namespace OpenJpegDotNet
+{
+
+    public static partial class OpenJpeg
+    {
+
+        #region Methods
+
+        /// <summary>
+        /// Reads the header of a JPEG 2000 codestream or JP2 file held in memory without decoding it.
+        /// </summary>
+        /// <param name="data">The codestream or JP2 file, of which the main header is enough.</param>
+        /// <returns>The header information of <paramref name="data"/>.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="data"/> is null.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="data"/> is not a valid codestream or JP2 file.</exception>
+        public static HeaderInfo ReadHeaderInfo(byte[] data)
+        {
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+
+            unsafe
+            {
+                fixed (byte* ptr = data)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_read_header_info((IntPtr)ptr, (ulong)data.Length, out var info, null, 0);
+                    ErrorHelper.ThrowIfError(ret);
+
+                    var comps = new NativeMethods.extensions_header_comp_info_t[info.numcomps];
+                    ret = NativeMethods.openjpeg_openjp2_extensions_read_header_info((IntPtr)ptr, (ulong)data.Length, out info, comps, (uint)comps.Length);
+                    ErrorHelper.ThrowIfError(ret);
+
+                    return ToHeaderInfo(info, comps);
+                }
+            }
+        }
+
+        #region Helpers
+
+        internal static HeaderInfo ToHeaderInfo(NativeMethods.extensions_header_info_t info, NativeMethods.extensions_header_comp_info_t[] comps)
+        {
+            var components = comps.Select(comp => new HeaderComponentInfo(comp.dx, comp.dy, comp.prec, comp.sgnd != 0)).ToArray();
+            return new HeaderInfo(info, components);
+        }
+
+        #endregion
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
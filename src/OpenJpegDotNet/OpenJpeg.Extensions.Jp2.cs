@@ -0,0 +1,271 @@
+﻿using System;
+using System.Linq;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace OpenJpegDotNet
+{
+
+    public static partial class OpenJpeg
+    {
+
+        #region Methods
+
+        /// <summary>
+        /// Wraps a JPEG 2000 codestream into a JP2 file without decoding it.
+        /// </summary>
+        /// <param name="codestream">The JPEG 2000 codestream.</param>
+        /// <param name="colorSpace">The color space written to the colr box.</param>
+        /// <param name="iccProfile">The ICC profile written to the colr box instead of <paramref name="colorSpace"/>, or null.</param>
+        /// <param name="resolutionX">The horizontal capture resolution in pixels per metre, or 0 for none.</param>
+        /// <param name="resolutionY">The vertical capture resolution in pixels per metre, or 0 for none.</param>
+        /// <returns>The JP2 file.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="codestream"/> is null.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="codestream"/> is not a valid codestream.</exception>
+        public static byte[] J2kToJp2(byte[] codestream,
+                                      ColorSpace colorSpace,
+                                      byte[] iccProfile = null,
+                                      double resolutionX = 0,
+                                      double resolutionY = 0)
+        {
+            if (codestream == null)
+                throw new ArgumentNullException(nameof(codestream));
+
+            unsafe
+            {
+                fixed (byte* ptr = codestream)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_j2k_to_jp2((IntPtr)ptr,
+                                                                                   (ulong)codestream.Length,
+                                                                                   colorSpace,
+                                                                                   iccProfile,
+                                                                                   (uint)(iccProfile?.Length ?? 0),
+                                                                                   resolutionX,
+                                                                                   resolutionY,
+                                                                                   out var jp2,
+                                                                                   out var jp2Length);
+                    ErrorHelper.ThrowIfError(ret);
+
+                    try
+                    {
+                        var buffer = new byte[jp2Length];
+                        Marshal.Copy(jp2, buffer, 0, buffer.Length);
+                        return buffer;
+                    }
+                    finally
+                    {
+                        NativeMethods.stdlib_free(jp2);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Extracts the JPEG 2000 codestream of a JP2 file without decoding it.
+        /// </summary>
+        /// <param name="jp2">The JP2 file.</param>
+        /// <returns>The JPEG 2000 codestream.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="jp2"/> is null.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="jp2"/> is not a valid JP2 file.</exception>
+        public static byte[] Jp2ToJ2k(byte[] jp2)
+        {
+            if (jp2 == null)
+                throw new ArgumentNullException(nameof(jp2));
+
+            unsafe
+            {
+                fixed (byte* ptr = jp2)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_jp2_to_j2k((IntPtr)ptr, (ulong)jp2.Length, out var offset, out var length);
+                    ErrorHelper.ThrowIfError(ret);
+                    return Slice(jp2, offset, length);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Lists every box of a JP2 file, superboxes included, in file order.
+        /// </summary>
+        /// <param name="jp2">The JP2 file.</param>
+        /// <returns>The boxes of <paramref name="jp2"/>.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="jp2"/> is null.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="jp2"/> is not a valid JP2 file.</exception>
+        public static Jp2Box[] GetJp2Boxes(byte[] jp2)
+        {
+            if (jp2 == null)
+                throw new ArgumentNullException(nameof(jp2));
+
+            unsafe
+            {
+                fixed (byte* ptr = jp2)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_jp2_get_boxes((IntPtr)ptr, (ulong)jp2.Length, null, 0, out var count);
+                    ErrorHelper.ThrowIfError(ret);
+
+                    var boxes = new NativeMethods.extensions_box_info_t[count];
+                    ret = NativeMethods.openjpeg_openjp2_extensions_jp2_get_boxes((IntPtr)ptr, (ulong)jp2.Length, boxes, count, out count);
+                    ErrorHelper.ThrowIfError(ret);
+
+                    return boxes.Select(box => new Jp2Box(box.type, box.depth, box.offset, box.header_length, box.length)).ToArray();
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the payload of a box of a JP2 file.
+        /// </summary>
+        /// <param name="jp2">The JP2 file.</param>
+        /// <param name="type">The box type, such as 0x786D6C20 for 'xml '.</param>
+        /// <param name="index">The zero-based index among the boxes of <paramref name="type"/>.</param>
+        /// <returns>The payload of the box, or null if there is no such box.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="jp2"/> is null.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="jp2"/> is not a valid JP2 file.</exception>
+        public static byte[] FindJp2Box(byte[] jp2, uint type, uint index = 0)
+        {
+            if (jp2 == null)
+                throw new ArgumentNullException(nameof(jp2));
+
+            unsafe
+            {
+                fixed (byte* ptr = jp2)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_jp2_find_box((IntPtr)ptr, (ulong)jp2.Length, type, index, out var offset, out var length);
+                    if (ret == NativeMethods.ErrorType.GeneralOutOfRange)
+                        return null;
+
+                    ErrorHelper.ThrowIfError(ret);
+                    return Slice(jp2, offset, length);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the ICC profile of a JP2 file without decoding it.
+        /// </summary>
+        /// <param name="jp2">The JP2 file.</param>
+        /// <returns>The ICC profile, or null if <paramref name="jp2"/> does not carry one.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="jp2"/> is null.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="jp2"/> is not a valid JP2 file.</exception>
+        public static byte[] GetJp2IccProfile(byte[] jp2)
+        {
+            if (jp2 == null)
+                throw new ArgumentNullException(nameof(jp2));
+
+            unsafe
+            {
+                fixed (byte* ptr = jp2)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_jp2_get_icc_profile((IntPtr)ptr, (ulong)jp2.Length, out var offset, out var length);
+                    if (ret == NativeMethods.ErrorType.GeneralOutOfRange)
+                        return null;
+
+                    ErrorHelper.ThrowIfError(ret);
+                    return Slice(jp2, offset, length);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the text of an XML box of a JP2 file.
+        /// </summary>
+        /// <param name="jp2">The JP2 file.</param>
+        /// <param name="index">The zero-based index among the XML boxes.</param>
+        /// <returns>The XML text, or null if there is no such box.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="jp2"/> is null.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="jp2"/> is not a valid JP2 file.</exception>
+        public static string GetJp2Xml(byte[] jp2, uint index = 0)
+        {
+            if (jp2 == null)
+                throw new ArgumentNullException(nameof(jp2));
+
+            unsafe
+            {
+                fixed (byte* ptr = jp2)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_jp2_get_xml((IntPtr)ptr, (ulong)jp2.Length, index, out var offset, out var length);
+                    if (ret == NativeMethods.ErrorType.GeneralOutOfRange)
+                        return null;
+
+                    ErrorHelper.ThrowIfError(ret);
+                    return Encoding.UTF8.GetString(jp2, (int)offset, (int)length);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the UUID and the data of a UUID box of a JP2 file.
+        /// </summary>
+        /// <param name="jp2">The JP2 file.</param>
+        /// <param name="index">The zero-based index among the UUID boxes.</param>
+        /// <param name="uuid">When this method returns, contains the 16 byte UUID of the box.</param>
+        /// <returns>The data that follows the UUID, or null if there is no such box.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="jp2"/> is null.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="jp2"/> is not a valid JP2 file.</exception>
+        public static byte[] GetJp2Uuid(byte[] jp2, uint index, out byte[] uuid)
+        {
+            if (jp2 == null)
+                throw new ArgumentNullException(nameof(jp2));
+
+            uuid = null;
+
+            unsafe
+            {
+                fixed (byte* ptr = jp2)
+                {
+                    var id = new byte[16];
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_jp2_get_uuid((IntPtr)ptr, (ulong)jp2.Length, index, id, out var offset, out var length);
+                    if (ret == NativeMethods.ErrorType.GeneralOutOfRange)
+                        return null;
+
+                    ErrorHelper.ThrowIfError(ret);
+                    uuid = id;
+                    return Slice(jp2, offset, length);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the resolution of a JP2 file.
+        /// </summary>
+        /// <param name="jp2">The JP2 file.</param>
+        /// <param name="capture">true to read the capture resolution; false to read the default display resolution.</param>
+        /// <param name="resolutionX">When this method returns, contains the horizontal resolution in pixels per metre.</param>
+        /// <param name="resolutionY">When this method returns, contains the vertical resolution in pixels per metre.</param>
+        /// <returns>true if <paramref name="jp2"/> carries the resolution; otherwise, false.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="jp2"/> is null.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="jp2"/> is not a valid JP2 file.</exception>
+        public static bool GetJp2Resolution(byte[] jp2, bool capture, out double resolutionX, out double resolutionY)
+        {
+            if (jp2 == null)
+                throw new ArgumentNullException(nameof(jp2));
+
+            unsafe
+            {
+                fixed (byte* ptr = jp2)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_jp2_get_resolution((IntPtr)ptr, (ulong)jp2.Length, capture, out resolutionX, out resolutionY);
+                    if (ret == NativeMethods.ErrorType.GeneralOutOfRange)
+                        return false;
+
+                    ErrorHelper.ThrowIfError(ret);
+                    return true;
+                }
+            }
+        }
+
+        #region Helpers
+
+        private static byte[] Slice(byte[] data, ulong offset, ulong length)
+        {
+            var ret = new byte[length];
+            Array.Copy(data, (long)offset, ret, 0, (long)length);
+            return ret;
+        }
+
+        #endregion
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
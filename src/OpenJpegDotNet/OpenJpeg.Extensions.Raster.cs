@@ -0,0 +1,163 @@
+﻿using System;
+using System.Text;
+
+namespace OpenJpegDotNet
+{
+
+    public static partial class OpenJpeg
+    {
+
+        #region Methods
+
+        /// <summary>
+        /// Decodes a JPEG 2000 codestream or JP2 file held in memory into a headerless raster file, tile by tile, without building the whole <see cref="Image"/>.
+        /// </summary>
+        /// <param name="data">The codestream or JP2 file.</param>
+        /// <param name="path">The path of the raster file to write. It is removed again when the decode fails.</param>
+        /// <param name="bands">The zero-based indices of the components, or null for every component in order. They must share the same grid.</param>
+        /// <param name="layout">The arrangement of the bands.</param>
+        /// <param name="sampleType">The sample type.</param>
+        /// <param name="width">When this method returns, contains the width of the raster.</param>
+        /// <param name="height">When this method returns, contains the height of the raster.</param>
+        /// <param name="decoders">The maximum number of codecs decoding at once.</param>
+        /// <param name="options">The options of the decode, or null for the whole image at full resolution.</param>
+        /// <exception cref="ArgumentNullException"><paramref name="data"/> or <paramref name="path"/> is null.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="data"/> is not a valid codestream or JP2 file.</exception>
+        /// <exception cref="System.IO.IOException"><paramref name="path"/> can not be written.</exception>
+        /// <exception cref="OperationCanceledException">The decode was cancelled through <see cref="DecodeOptions.Token"/>.</exception>
+        /// <exception cref="TimeoutException">The deadline of <see cref="DecodeOptions.Token"/> passed.</exception>
+        public static void RasterDecodeFile(byte[] data,
+                                            string path,
+                                            uint[] bands,
+                                            BandLayout layout,
+                                            SampleType sampleType,
+                                            out uint width,
+                                            out uint height,
+                                            uint decoders = 1,
+                                            DecodeOptions options = null)
+        {
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+            if (path == null)
+                throw new ArgumentNullException(nameof(path));
+
+            options = options ?? new DecodeOptions();
+            var token = options.GetTokenPtr();
+            var area = options.Area;
+            var pathBytes = Encoding.UTF8.GetBytes(path);
+
+            unsafe
+            {
+                fixed (byte* ptr = data)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_raster_decode_file((IntPtr)ptr,
+                                                                                           (ulong)data.Length,
+                                                                                           options.Reduce,
+                                                                                           options.Layers,
+                                                                                           area.Left,
+                                                                                           area.Top,
+                                                                                           area.Right,
+                                                                                           area.Bottom,
+                                                                                           bands,
+                                                                                           (uint)(bands?.Length ?? 0),
+                                                                                           (int)layout,
+                                                                                           (int)sampleType,
+                                                                                           pathBytes,
+                                                                                           (uint)pathBytes.Length,
+                                                                                           decoders,
+                                                                                           options.NumberOfThreads,
+                                                                                           token,
+                                                                                           out width,
+                                                                                           out height);
+                    ErrorHelper.ThrowIfError(ret);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Decodes a JPEG 2000 codestream or JP2 file held in memory into a raster, tile by tile, without building the whole <see cref="Image"/>.
+        /// </summary>
+        /// <param name="data">The codestream or JP2 file.</param>
+        /// <param name="bands">The zero-based indices of the components, or null for every component in order. They must share the same grid.</param>
+        /// <param name="layout">The arrangement of the bands.</param>
+        /// <param name="sampleType">The sample type.</param>
+        /// <param name="width">When this method returns, contains the width of the raster.</param>
+        /// <param name="height">When this method returns, contains the height of the raster.</param>
+        /// <param name="decoders">The maximum number of codecs decoding at once.</param>
+        /// <param name="options">The options of the decode, or null for the whole image at full resolution.</param>
+        /// <returns>The samples of the bands. A single band of <see cref="SampleType.UInt8"/> is a plain grayscale bitmap.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="data"/> is null.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="data"/> is not a valid codestream or JP2 file.</exception>
+        /// <exception cref="OperationCanceledException">The decode was cancelled through <see cref="DecodeOptions.Token"/>.</exception>
+        /// <exception cref="TimeoutException">The deadline of <see cref="DecodeOptions.Token"/> passed.</exception>
+        public static byte[] RasterDecodeMemory(byte[] data,
+                                                uint[] bands,
+                                                BandLayout layout,
+                                                SampleType sampleType,
+                                                out uint width,
+                                                out uint height,
+                                                uint decoders = 1,
+                                                DecodeOptions options = null)
+        {
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+
+            options = options ?? new DecodeOptions();
+            var token = options.GetTokenPtr();
+            var area = options.Area;
+            var count = (uint)(bands?.Length ?? 0);
+
+            unsafe
+            {
+                fixed (byte* ptr = data)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_raster_get_info((IntPtr)ptr,
+                                                                                        (ulong)data.Length,
+                                                                                        options.Reduce,
+                                                                                        area.Left,
+                                                                                        area.Top,
+                                                                                        area.Right,
+                                                                                        area.Bottom,
+                                                                                        bands,
+                                                                                        count,
+                                                                                        (int)sampleType,
+                                                                                        out width,
+                                                                                        out height,
+                                                                                        out var length);
+                    ErrorHelper.ThrowIfError(ret);
+
+                    var raster = new byte[length];
+                    fixed (byte* dst = raster)
+                    {
+                        ret = NativeMethods.openjpeg_openjp2_extensions_raster_decode_memory((IntPtr)ptr,
+                                                                                             (ulong)data.Length,
+                                                                                             options.Reduce,
+                                                                                             options.Layers,
+                                                                                             area.Left,
+                                                                                             area.Top,
+                                                                                             area.Right,
+                                                                                             area.Bottom,
+                                                                                             bands,
+                                                                                             count,
+                                                                                             (int)layout,
+                                                                                             (int)sampleType,
+                                                                                             (IntPtr)dst,
+                                                                                             (ulong)raster.Length,
+                                                                                             decoders,
+                                                                                             options.NumberOfThreads,
+                                                                                             token,
+                                                                                             out width,
+                                                                                             out height);
+                        ErrorHelper.ThrowIfError(ret);
+                    }
+
+                    return raster;
+                }
+            }
+        }
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,185 @@
+﻿using System;
+using System.Runtime.ExceptionServices;
+using System.Runtime.InteropServices;
+
+namespace OpenJpegDotNet
+{
+
+    public static partial class OpenJpeg
+    {
+
+        #region Delegates
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        private delegate NativeMethods.ErrorType TilesCallback(IntPtr tile, IntPtr userData);
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        private delegate NativeMethods.ErrorType PyramidCallback(IntPtr tile, IntPtr userData);
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Decodes a JPEG 2000 codestream or JP2 file held in memory tile by tile and hands each tile over as soon as it is converted.
+        /// </summary>
+        /// <param name="data">The codestream or JP2 file.</param>
+        /// <param name="format">The pixel format of the tiles.</param>
+        /// <param name="callback">The method called with each tile, in codestream order. An exception thrown here stops the decode and is rethrown.</param>
+        /// <param name="flags">The options of the conversion.</param>
+        /// <param name="maxPending">The number of converted tiles which may wait for <paramref name="callback"/> on a thread of its own. 0 calls it on the decoding thread.</param>
+        /// <param name="options">The options of the decode, or null for the whole image at full resolution.</param>
+        /// <exception cref="ArgumentNullException"><paramref name="data"/> or <paramref name="callback"/> is null.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="data"/> is not a valid codestream or JP2 file.</exception>
+        /// <exception cref="OperationCanceledException">The decode was cancelled through <see cref="DecodeOptions.Token"/>.</exception>
+        /// <exception cref="TimeoutException">The deadline of <see cref="DecodeOptions.Token"/> passed.</exception>
+        public static void TilesDecode(byte[] data,
+                                       ExportFormat format,
+                                       Action<DecodedTile> callback,
+                                       ExportFlags flags = ExportFlags.None,
+                                       uint maxPending = 0,
+                                       DecodeOptions options = null)
+        {
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+            if (callback == null)
+                throw new ArgumentNullException(nameof(callback));
+
+            options = options ?? new DecodeOptions();
+            var token = options.GetTokenPtr();
+            var area = options.Area;
+
+            ExceptionDispatchInfo error = null;
+            var handler = new DelegateHandler<TilesCallback>((tile, userData) =>
+            {
+                try
+                {
+                    var pixels = Marshal.PtrToStructure<NativeMethods.extensions_tiles_pixels_t>(tile);
+                    callback(new DecodedTile(pixels.index,
+                                             pixels.x,
+                                             pixels.y,
+                                             Pixels.Copy(pixels.data, pixels.length, pixels.width, pixels.height, pixels.channels, pixels.bits)));
+                    return NativeMethods.ErrorType.OK;
+                }
+                catch (Exception e)
+                {
+                    error = ExceptionDispatchInfo.Capture(e);
+                    return NativeMethods.ErrorType.GeneralCancelled;
+                }
+            });
+
+            NativeMethods.ErrorType ret;
+            unsafe
+            {
+                fixed (byte* ptr = data)
+                {
+                    ret = NativeMethods.openjpeg_openjp2_extensions_tiles_decode((IntPtr)ptr,
+                                                                                 (ulong)data.Length,
+                                                                                 options.Reduce,
+                                                                                 options.Layers,
+                                                                                 area.Left,
+                                                                                 area.Top,
+                                                                                 area.Right,
+                                                                                 area.Bottom,
+                                                                                 (int)format,
+                                                                                 (uint)flags,
+                                                                                 options.NumberOfThreads,
+                                                                                 maxPending,
+                                                                                 token,
+                                                                                 handler.Handle,
+                                                                                 IntPtr.Zero);
+                }
+            }
+
+            GC.KeepAlive(handler);
+            error?.Throw();
+            ErrorHelper.ThrowIfError(ret);
+        }
+
+        /// <summary>
+        /// Decodes a JPEG 2000 codestream or JP2 file held in memory once and hands over the tiles of every level of a resolution pyramid, from the finest to the coarsest.
+        /// </summary>
+        /// <param name="data">The codestream or JP2 file.</param>
+        /// <param name="tileSize">The width and height of the tiles of every level.</param>
+        /// <param name="format">The pixel format of the tiles.</param>
+        /// <param name="callback">The method called with each tile. An exception thrown here stops the pyramid and is rethrown.</param>
+        /// <param name="levels">The maximum number of levels. 0 means until a whole level fits in one tile.</param>
+        /// <param name="flags">The options of the conversion.</param>
+        /// <param name="decoders">The maximum number of codecs decoding at once.</param>
+        /// <param name="options">The options of the decode, or null for the whole image at full resolution. <see cref="DecodeOptions.Reduce"/> is the first level and <see cref="DecodeOptions.Area"/> is ignored.</param>
+        /// <exception cref="ArgumentNullException"><paramref name="data"/> or <paramref name="callback"/> is null.</exception>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="tileSize"/> is 0.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="data"/> is not a valid codestream or JP2 file.</exception>
+        /// <exception cref="OperationCanceledException">The decode was cancelled through <see cref="DecodeOptions.Token"/>.</exception>
+        /// <exception cref="TimeoutException">The deadline of <see cref="DecodeOptions.Token"/> passed.</exception>
+        public static void PyramidDecode(byte[] data,
+                                         uint tileSize,
+                                         ExportFormat format,
+                                         Action<PyramidTile> callback,
+                                         uint levels = 0,
+                                         ExportFlags flags = ExportFlags.None,
+                                         uint decoders = 1,
+                                         DecodeOptions options = null)
+        {
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+            if (callback == null)
+                throw new ArgumentNullException(nameof(callback));
+            if (tileSize == 0)
+                throw new ArgumentOutOfRangeException(nameof(tileSize));
+
+            options = options ?? new DecodeOptions();
+            var token = options.GetTokenPtr();
+
+            ExceptionDispatchInfo error = null;
+            var handler = new DelegateHandler<PyramidCallback>((tile, userData) =>
+            {
+                try
+                {
+                    var pyramid = Marshal.PtrToStructure<NativeMethods.extensions_pyramid_tile_t>(tile);
+                    callback(new PyramidTile(pyramid.level,
+                                             pyramid.column,
+                                             pyramid.row,
+                                             pyramid.x,
+                                             pyramid.y,
+                                             Pixels.Copy(pyramid.data, pyramid.length, pyramid.width, pyramid.height, pyramid.channels, pyramid.bits)));
+                    return NativeMethods.ErrorType.OK;
+                }
+                catch (Exception e)
+                {
+                    error = ExceptionDispatchInfo.Capture(e);
+                    return NativeMethods.ErrorType.GeneralCancelled;
+                }
+            });
+
+            NativeMethods.ErrorType ret;
+            unsafe
+            {
+                fixed (byte* ptr = data)
+                {
+                    ret = NativeMethods.openjpeg_openjp2_extensions_pyramid_decode((IntPtr)ptr,
+                                                                                   (ulong)data.Length,
+                                                                                   options.Reduce,
+                                                                                   options.Layers,
+                                                                                   levels,
+                                                                                   tileSize,
+                                                                                   (int)format,
+                                                                                   (uint)flags,
+                                                                                   decoders,
+                                                                                   options.NumberOfThreads,
+                                                                                   token,
+                                                                                   handler.Handle,
+                                                                                   IntPtr.Zero);
+                }
+            }
+
+            GC.KeepAlive(handler);
+            error?.Throw();
+            ErrorHelper.ThrowIfError(ret);
+        }
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
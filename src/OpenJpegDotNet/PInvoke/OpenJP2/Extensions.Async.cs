@@ -0,0 +1,60 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+        #region Async
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern IntPtr openjpeg_openjp2_extensions_async_pool_new(int32_t num_threads);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_async_pool_delete(IntPtr pool);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern IntPtr openjpeg_openjp2_extensions_async_decode(IntPtr pool,
+                                                                             IntPtr p_codec,
+                                                                             IntPtr p_stream,
+                                                                             IntPtr p_image,
+                                                                             IntPtr callback,
+                                                                             IntPtr user_data);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern IntPtr openjpeg_openjp2_extensions_async_encode(IntPtr pool,
+                                                                             IntPtr p_codec,
+                                                                             IntPtr p_image,
+                                                                             IntPtr p_stream,
+                                                                             IntPtr callback,
+                                                                             IntPtr user_data);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        [return: MarshalAs(UnmanagedType.U1)]
+        public static extern bool openjpeg_openjp2_extensions_async_job_poll(IntPtr job, out ErrorType status);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        [return: MarshalAs(UnmanagedType.U1)]
+        public static extern bool openjpeg_openjp2_extensions_async_job_wait(IntPtr job,
+                                                                            int32_t timeout_ms,
+                                                                            out ErrorType status);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_async_job_delete(IntPtr job);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
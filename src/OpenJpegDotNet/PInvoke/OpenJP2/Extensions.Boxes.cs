@@ -0,0 +1,88 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+        #region Structs
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct extensions_box_info_t
+        {
+
+            public uint32_t type;
+
+            public uint32_t depth;
+
+            public uint64_t offset;
+
+            public uint64_t header_length;
+
+            public uint64_t length;
+
+        }
+
+        #endregion
+
+        #region Boxes
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_jp2_get_boxes(IntPtr buf,
+                                                                                 uint64_t len,
+                                                                                 [Out] extensions_box_info_t[] boxes,
+                                                                                 uint32_t boxes_len,
+                                                                                 out uint32_t count);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_jp2_find_box(IntPtr buf,
+                                                                                uint64_t len,
+                                                                                uint32_t type,
+                                                                                uint32_t index,
+                                                                                out uint64_t data_offset,
+                                                                                out uint64_t data_len);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_jp2_get_icc_profile(IntPtr buf,
+                                                                                       uint64_t len,
+                                                                                       out uint64_t icc_offset,
+                                                                                       out uint64_t icc_len);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_jp2_get_xml(IntPtr buf,
+                                                                               uint64_t len,
+                                                                               uint32_t index,
+                                                                               out uint64_t xml_offset,
+                                                                               out uint64_t xml_len);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_jp2_get_uuid(IntPtr buf,
+                                                                                uint64_t len,
+                                                                                uint32_t index,
+                                                                                [Out] byte[] uuid,
+                                                                                out uint64_t data_offset,
+                                                                                out uint64_t data_len);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_jp2_get_resolution(IntPtr buf,
+                                                                                      uint64_t len,
+                                                                                      bool capture,
+                                                                                      out double resolution_x,
+                                                                                      out double resolution_y);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+        #region Budget
+
+        public const uint32_t EXTENSIONS_BUDGET_ALLOW_REDUCE = 0x1;
+
+        public const uint32_t EXTENSIONS_BUDGET_ALLOW_TILED = 0x2;
+
+        public const int32_t EXTENSIONS_BUDGET_MODE_FULL = 0;
+
+        public const int32_t EXTENSIONS_BUDGET_MODE_TILED = 1;
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_budget_estimate(IntPtr data,
+                                                                                   uint64_t data_len,
+                                                                                   uint32_t reduce,
+                                                                                   int32_t x0,
+                                                                                   int32_t y0,
+                                                                                   int32_t x1,
+                                                                                   int32_t y1,
+                                                                                   out uint64_t image_bytes,
+                                                                                   out uint64_t tile_bytes);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_budget_admit(IntPtr data,
+                                                                                uint64_t data_len,
+                                                                                uint64_t budget,
+                                                                                uint32_t flags,
+                                                                                uint32_t reduce,
+                                                                                int32_t x0,
+                                                                                int32_t y0,
+                                                                                int32_t x1,
+                                                                                int32_t y1,
+                                                                                out uint32_t admitted_reduce,
+                                                                                out int32_t mode);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_budget_decode_memory(IntPtr data,
+                                                                                        uint64_t data_len,
+                                                                                        uint64_t budget,
+                                                                                        uint32_t flags,
+                                                                                        uint32_t reduce,
+                                                                                        uint32_t layers,
+                                                                                        int32_t x0,
+                                                                                        int32_t y0,
+                                                                                        int32_t x1,
+                                                                                        int32_t y1,
+                                                                                        int32_t num_threads,
+                                                                                        IntPtr token,
+                                                                                        out IntPtr image,
+                                                                                        out uint32_t admitted_reduce);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+        #region Cache
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern IntPtr openjpeg_openjp2_extensions_cache_new(uint64_t max_bytes);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_cache_clear(IntPtr cache);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_cache_delete(IntPtr cache);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_cache_decode(IntPtr cache,
+                                                                                IntPtr data,
+                                                                                uint64_t data_len,
+                                                                                uint32_t reduce,
+                                                                                uint32_t layers,
+                                                                                int32_t x0,
+                                                                                int32_t y0,
+                                                                                int32_t x1,
+                                                                                int32_t y1,
+                                                                                int32_t format,
+                                                                                uint32_t flags,
+                                                                                int32_t num_threads,
+                                                                                out IntPtr entry);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_cache_entry_get_pixels(IntPtr entry,
+                                                                                     out IntPtr pixels,
+                                                                                     out uint64_t pixels_len,
+                                                                                     out uint32_t width,
+                                                                                     out uint32_t height,
+                                                                                     out uint32_t channels,
+                                                                                     out uint32_t bits);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_cache_entry_release(IntPtr entry);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_cache_get_stats(IntPtr cache,
+                                                                              out uint64_t hits,
+                                                                              out uint64_t misses,
+                                                                              out uint64_t evictions,
+                                                                              out uint64_t entries,
+                                                                              out uint64_t bytes);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+        #region Catalog
+
+        public const int32_t EXTENSIONS_CATALOG_FORMAT_CSV = 0;
+
+        public const int32_t EXTENSIONS_CATALOG_FORMAT_BINARY = 1;
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_catalog_scan(byte[] directory,
+                                                                                uint32_t directory_len,
+                                                                                bool recursive,
+                                                                                byte[] output,
+                                                                                uint32_t output_len,
+                                                                                int32_t output_format,
+                                                                                uint32_t head_size,
+                                                                                bool tile_sizes,
+                                                                                int32_t num_threads,
+                                                                                out uint64_t scanned,
+                                                                                out uint64_t failed);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+
+        #region Encode
+
+        public const int32_t EXTENSIONS_ENCODE_TILE_SIZE = 1024;
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_encode_pixels(IntPtr p_codec,
+                                                                                 IntPtr parameters,
+                                                                                 IntPtr src,
+                                                                                 uint64_t src_len,
+                                                                                 uint32_t width,
+                                                                                 uint32_t height,
+                                                                                 uint32_t channels,
+                                                                                 uint32_t sample_bytes,
+                                                                                 uint64_t pixel_stride,
+                                                                                 uint64_t row_stride,
+                                                                                 uint64_t channel_stride,
+                                                                                 uint32_t prec,
+                                                                                 bool sgnd,
+                                                                                 int32_t color_space,
+                                                                                 uint32_t flags,
+                                                                                 IntPtr p_stream);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
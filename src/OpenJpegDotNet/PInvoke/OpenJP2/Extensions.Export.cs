@@ -0,0 +1,67 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+
+        #region Export
+
+        public const int32_t EXTENSIONS_BAND_LAYOUT_BSQ = 0;
+
+        public const int32_t EXTENSIONS_BAND_LAYOUT_BIL = 1;
+
+        public const int32_t EXTENSIONS_BAND_LAYOUT_BIP = 2;
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_export_get_info(IntPtr image,
+                                                                                  int32_t format,
+                                                                                  uint32_t flags,
+                                                                                  out uint32_t width,
+                                                                                  out uint32_t height,
+                                                                                  out uint32_t channels,
+                                                                                  out uint32_t bits);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_export_pixels(IntPtr image,
+                                                                                 int32_t format,
+                                                                                 uint32_t flags,
+                                                                                 IntPtr dst,
+                                                                                 uint64_t stride,
+                                                                                 uint64_t dst_len);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_export_component(IntPtr image,
+                                                                                    uint32_t compno,
+                                                                                    int32_t sample_type,
+                                                                                    IntPtr dst,
+                                                                                    uint64_t stride,
+                                                                                    uint64_t dst_len);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_export_bands(IntPtr image,
+                                                                                uint32_t[] bands,
+                                                                                uint32_t num_bands,
+                                                                                int32_t layout,
+                                                                                int32_t sample_type,
+                                                                                int32_t num_threads,
+                                                                                IntPtr dst,
+                                                                                uint64_t dst_len);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
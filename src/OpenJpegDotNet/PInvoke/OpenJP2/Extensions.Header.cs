@@ -0,0 +1,106 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+        #region Structs
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct extensions_header_info_t
+        {
+
+            public CodecFormat format;
+
+            public uint32_t x0;
+
+            public uint32_t y0;
+
+            public uint32_t x1;
+
+            public uint32_t y1;
+
+            public uint32_t tx0;
+
+            public uint32_t ty0;
+
+            public uint32_t tdx;
+
+            public uint32_t tdy;
+
+            public uint32_t tw;
+
+            public uint32_t th;
+
+            public uint32_t numcomps;
+
+            public uint32_t numresolutions;
+
+            public uint32_t numlayers;
+
+            public ProgressionOrder prog_order;
+
+            public uint32_t mct;
+
+            public uint32_t cblkw;
+
+            public uint32_t cblkh;
+
+            public uint32_t irreversible;
+
+            public uint32_t rsiz;
+
+            public ColorSpace color_space;
+
+            public uint32_t has_icc_profile;
+
+            public uint32_t has_xml;
+
+            public uint64_t codestream_offset;
+
+            public uint64_t codestream_length;
+
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct extensions_header_comp_info_t
+        {
+
+            public uint32_t dx;
+
+            public uint32_t dy;
+
+            public uint32_t prec;
+
+            public uint32_t sgnd;
+
+        }
+
+        #endregion
+
+        #region Header
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_read_header_info(IntPtr buf,
+                                                                                    uint64_t len,
+                                                                                    out extensions_header_info_t info,
+                                                                                    [Out] extensions_header_comp_info_t[] comps,
+                                                                                    uint32_t comps_len);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
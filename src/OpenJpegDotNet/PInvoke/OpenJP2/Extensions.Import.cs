@@ -0,0 +1,40 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+
+        #region Import
+
+        public const uint32_t EXTENSIONS_IMPORT_BIG_ENDIAN = 0x1;
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_import_pixels(IntPtr image,
+                                                                                 IntPtr src,
+                                                                                 uint64_t src_len,
+                                                                                 uint32_t channels,
+                                                                                 uint32_t sample_bytes,
+                                                                                 uint64_t pixel_stride,
+                                                                                 uint64_t row_stride,
+                                                                                 uint64_t channel_stride,
+                                                                                 uint32_t flags,
+                                                                                 int32_t num_threads);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
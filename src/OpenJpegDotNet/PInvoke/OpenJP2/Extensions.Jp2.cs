@@ -0,0 +1,42 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+        #region Jp2
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_j2k_to_jp2(IntPtr codestream,
+                                                                              uint64_t codestream_len,
+                                                                              ColorSpace color_space,
+                                                                              byte[] icc_profile,
+                                                                              uint32_t icc_profile_len,
+                                                                              double resolution_x,
+                                                                              double resolution_y,
+                                                                              out IntPtr jp2,
+                                                                              out uint64_t jp2_len);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_jp2_to_j2k(IntPtr jp2,
+                                                                              uint64_t jp2_len,
+                                                                              out uint64_t codestream_offset,
+                                                                              out uint64_t codestream_len);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
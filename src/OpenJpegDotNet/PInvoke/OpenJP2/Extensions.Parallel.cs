@@ -0,0 +1,39 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+        #region Parallel
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_parallel_decode_memory(IntPtr data,
+                                                                                          uint64_t data_len,
+                                                                                          uint32_t reduce,
+                                                                                          uint32_t layers,
+                                                                                          int32_t x0,
+                                                                                          int32_t y0,
+                                                                                          int32_t x1,
+                                                                                          int32_t y1,
+                                                                                          uint32_t num_decoders,
+                                                                                          int32_t num_threads,
+                                                                                          IntPtr token,
+                                                                                          out IntPtr image);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+        #region Pixels
+
+        public const int32_t EXTENSIONS_PIXEL_FORMAT_PLANAR = 0;
+
+        public const int32_t EXTENSIONS_PIXEL_FORMAT_RGB24 = 1;
+
+        public const int32_t EXTENSIONS_PIXEL_FORMAT_BGR24 = 2;
+
+        public const int32_t EXTENSIONS_PIXEL_FORMAT_RGBA32 = 3;
+
+        public const int32_t EXTENSIONS_PIXEL_FORMAT_BGRA32 = 4;
+
+        public const uint32_t EXTENSIONS_PIXEL_NO_COLOR_CONVERSION = 0x1;
+
+        public const uint32_t EXTENSIONS_PIXEL_UPSAMPLE_BILINEAR = 0x2;
+
+        public const uint32_t EXTENSIONS_PIXEL_PREMULTIPLY_ALPHA = 0x4;
+
+        public const int32_t EXTENSIONS_SAMPLE_UINT8 = 0;
+
+        public const int32_t EXTENSIONS_SAMPLE_UINT16 = 1;
+
+        public const int32_t EXTENSIONS_SAMPLE_FLOAT32 = 2;
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+        #region Structs
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct extensions_pyramid_tile_t
+        {
+
+            public uint32_t level;
+
+            public uint32_t column;
+
+            public uint32_t row;
+
+            public uint32_t x;
+
+            public uint32_t y;
+
+            public uint32_t width;
+
+            public uint32_t height;
+
+            public uint32_t channels;
+
+            public uint32_t bits;
+
+            public IntPtr data;
+
+            public uint64_t length;
+
+        }
+
+        #endregion
+
+        #region Pyramid
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_pyramid_decode(IntPtr data,
+                                                                                  uint64_t data_len,
+                                                                                  uint32_t reduce,
+                                                                                  uint32_t layers,
+                                                                                  uint32_t levels,
+                                                                                  uint32_t tile_size,
+                                                                                  int32_t format,
+                                                                                  uint32_t flags,
+                                                                                  uint32_t num_decoders,
+                                                                                  int32_t num_threads,
+                                                                                  IntPtr token,
+                                                                                  IntPtr callback,
+                                                                                  IntPtr user_data);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
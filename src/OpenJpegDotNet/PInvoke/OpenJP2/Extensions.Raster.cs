@@ -0,0 +1,82 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+        #region Raster
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_raster_decode_file(IntPtr data,
+                                                                                      uint64_t data_len,
+                                                                                      uint32_t reduce,
+                                                                                      uint32_t layers,
+                                                                                      int32_t x0,
+                                                                                      int32_t y0,
+                                                                                      int32_t x1,
+                                                                                      int32_t y1,
+                                                                                      uint32_t[] bands,
+                                                                                      uint32_t num_bands,
+                                                                                      int32_t layout,
+                                                                                      int32_t sample_type,
+                                                                                      byte[] path,
+                                                                                      uint32_t path_len,
+                                                                                      uint32_t num_decoders,
+                                                                                      int32_t num_threads,
+                                                                                      IntPtr token,
+                                                                                      out uint32_t width,
+                                                                                      out uint32_t height);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_raster_get_info(IntPtr data,
+                                                                                   uint64_t data_len,
+                                                                                   uint32_t reduce,
+                                                                                   int32_t x0,
+                                                                                   int32_t y0,
+                                                                                   int32_t x1,
+                                                                                   int32_t y1,
+                                                                                   uint32_t[] bands,
+                                                                                   uint32_t num_bands,
+                                                                                   int32_t sample_type,
+                                                                                   out uint32_t width,
+                                                                                   out uint32_t height,
+                                                                                   out uint64_t length);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_raster_decode_memory(IntPtr data,
+                                                                                        uint64_t data_len,
+                                                                                        uint32_t reduce,
+                                                                                        uint32_t layers,
+                                                                                        int32_t x0,
+                                                                                        int32_t y0,
+                                                                                        int32_t x1,
+                                                                                        int32_t y1,
+                                                                                        uint32_t[] bands,
+                                                                                        uint32_t num_bands,
+                                                                                        int32_t layout,
+                                                                                        int32_t sample_type,
+                                                                                        IntPtr dst,
+                                                                                        uint64_t dst_len,
+                                                                                        uint32_t num_decoders,
+                                                                                        int32_t num_threads,
+                                                                                        IntPtr token,
+                                                                                        out uint32_t width,
+                                                                                        out uint32_t height);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
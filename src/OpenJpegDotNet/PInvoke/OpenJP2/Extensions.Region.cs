@@ -0,0 +1,57 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+        #region Region
+
+        public const int32_t EXTENSIONS_REGION_MAX_IDLE = 4;
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_region_decoder_new(IntPtr source,
+                                                                                      int32_t num_threads,
+                                                                                      out IntPtr region);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_region_decoder_delete(IntPtr region);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_region_decoder_get_info(IntPtr region,
+                                                                                      out extensions_header_info_t info,
+                                                                                      [Out] extensions_header_comp_info_t[] comps,
+                                                                                      uint32_t comps_len);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_region_decoder_decode(IntPtr region,
+                                                                                         uint32_t reduce,
+                                                                                         uint32_t layers,
+                                                                                         int32_t x0,
+                                                                                         int32_t y0,
+                                                                                         int32_t x1,
+                                                                                         int32_t y1,
+                                                                                         IntPtr token,
+                                                                                         out IntPtr image);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_region_decoder_get_stats(IntPtr region,
+                                                                                       out uint64_t decodes,
+                                                                                       out uint64_t reused);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+        #region Structs
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct extensions_scheduler_tile_t
+        {
+
+            public uint32_t index;
+
+            public uint32_t reduce;
+
+            public uint64_t generation;
+
+            public uint32_t prefetch;
+
+            public int32_t status;
+
+            public uint32_t x;
+
+            public uint32_t y;
+
+            public uint32_t width;
+
+            public uint32_t height;
+
+            public uint32_t channels;
+
+            public uint32_t bits;
+
+            public IntPtr data;
+
+            public uint64_t length;
+
+        }
+
+        #endregion
+
+        #region Scheduler
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_scheduler_new(IntPtr source,
+                                                                                 uint32_t num_workers,
+                                                                                 int32_t num_threads,
+                                                                                 int32_t format,
+                                                                                 uint32_t flags,
+                                                                                 uint32_t prefetch,
+                                                                                 IntPtr callback,
+                                                                                 IntPtr user_data,
+                                                                                 out IntPtr scheduler);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_scheduler_delete(IntPtr scheduler);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_scheduler_submit(IntPtr scheduler,
+                                                                                    uint32_t tile_index,
+                                                                                    uint32_t reduce,
+                                                                                    int32_t priority,
+                                                                                    uint64_t generation);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_scheduler_advance(IntPtr scheduler,
+                                                                                uint64_t generation);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_scheduler_wait(IntPtr scheduler);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_scheduler_get_stats(IntPtr scheduler,
+                                                                                  out uint64_t decoded,
+                                                                                  out uint64_t prefetched,
+                                                                                  out uint64_t dropped,
+                                                                                  out uint64_t cancelled,
+                                                                                  out uint64_t failed);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
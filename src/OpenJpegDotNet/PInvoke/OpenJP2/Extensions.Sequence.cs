@@ -0,0 +1,52 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+        #region Sequence
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern IntPtr openjpeg_openjp2_extensions_sequence_new(uint32_t reduce,
+                                                                             uint32_t layers,
+                                                                             uint32_t queue_depth,
+                                                                             int32_t decode_threads,
+                                                                             int32_t codec_threads,
+                                                                             IntPtr pool);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_sequence_delete(IntPtr sequence);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_sequence_push(IntPtr sequence,
+                                                                                 IntPtr data,
+                                                                                 uint64_t data_len);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_sequence_finish(IntPtr sequence);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_sequence_pop(IntPtr sequence,
+                                                                                out IntPtr image,
+                                                                                out uint64_t frame_index);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_sequence_release(IntPtr sequence, IntPtr image);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
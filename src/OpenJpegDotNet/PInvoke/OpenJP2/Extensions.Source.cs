@@ -0,0 +1,62 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+        #region Source
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_source_new(IntPtr data,
+                                                                              uint64_t data_len,
+                                                                              out IntPtr source);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_source_new_file(byte[] path,
+                                                                                   uint32_t path_len,
+                                                                                   out IntPtr source);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_source_retain(IntPtr source);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_source_release(IntPtr source);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_extensions_source_get_data(IntPtr source,
+                                                                              out IntPtr data,
+                                                                              out uint64_t data_len);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern IntPtr openjpeg_openjp2_extensions_source_create_stream(IntPtr source,
+                                                                                     IntPtr token);
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_source_decode(IntPtr source,
+                                                                                 uint32_t reduce,
+                                                                                 uint32_t layers,
+                                                                                 int32_t x0,
+                                                                                 int32_t y0,
+                                                                                 int32_t x1,
+                                                                                 int32_t y1,
+                                                                                 int32_t num_threads,
+                                                                                 IntPtr token,
+                                                                                 out IntPtr image);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using uint8_t = System.Byte;
+using uint16_t = System.UInt16;
+using uint32_t = System.UInt32;
+using uint64_t = System.UInt64;
+using int64_t = System.Int64;
+using int8_t = System.SByte;
+using int16_t = System.Int16;
+using int32_t = System.Int32;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal sealed partial class NativeMethods
+    {
+
+        #region Structs
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct extensions_tiles_pixels_t
+        {
+
+            public uint32_t index;
+
+            public uint32_t x;
+
+            public uint32_t y;
+
+            public uint32_t width;
+
+            public uint32_t height;
+
+            public uint32_t channels;
+
+            public uint32_t bits;
+
+            public IntPtr data;
+
+            public uint64_t length;
+
+        }
+
+        #endregion
+
+        #region Tiles
+
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern ErrorType openjpeg_openjp2_extensions_tiles_decode(IntPtr data,
+                                                                                uint64_t data_len,
+                                                                                uint32_t reduce,
+                                                                                uint32_t layers,
+                                                                                int32_t x0,
+                                                                                int32_t y0,
+                                                                                int32_t x1,
+                                                                                int32_t y1,
+                                                                                int32_t format,
+                                                                                uint32_t flags,
+                                                                                int32_t num_threads,
+                                                                                uint32_t max_pending,
+                                                                                IntPtr token,
+                                                                                IntPtr callback,
+                                                                                IntPtr user_data);
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -137,6 +137,9 @@ namespace OpenJpegDotNet
         [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
         public static extern uint16_t openjpeg_openjp2_opj_image_comp_t_get_alpha(IntPtr comp);
 
+        [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
+        public static extern void openjpeg_openjp2_opj_image_comp_t_set_alpha(IntPtr comp, uint16_t value);
+
         [DllImport(NativeLibrary, CallingConvention = CallingConvention)]
         public static extern uint32_t openjpeg_openjp2_opj_image_comp_t_get_bpp(IntPtr comp);
 
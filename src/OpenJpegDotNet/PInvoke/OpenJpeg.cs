@@ -30,6 +30,14 @@ namespace OpenJpegDotNet
 
             GeneralMemAlloc         = -(GeneralError | 0x00000003),
 
+            GeneralEndOfData        = -(GeneralError | 0x00000004),
+
+            GeneralCancelled        = -(GeneralError | 0x00000005),
+
+            GeneralDeadlineExceeded = -(GeneralError | 0x00000006),
+
+            GeneralOverBudget       = -(GeneralError | 0x00000007),
+
             #endregion
 
             #region Image
@@ -38,7 +46,11 @@ namespace OpenJpegDotNet
 
             ImageFileInvalid        = -(ImageError | 0x00000001),
 
-            ImageFileWrongExtension = -(ImageError | 0x00000002)
+            ImageFileWrongExtension = -(ImageError | 0x00000002),
+
+            ImageDecodeFailed       = -(ImageError | 0x00000003),
+
+            ImageEncodeFailed       = -(ImageError | 0x00000004)
 
             #endregion
 
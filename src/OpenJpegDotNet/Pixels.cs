@@ -0,0 +1,84 @@
+﻿using System;
+using System.Runtime.InteropServices;
+
+namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Defines converted pixels. This class cannot be inherited.
+    /// </summary>
+    public sealed class Pixels
+    {
+
+        #region Constructors
+
+        internal Pixels(byte[] data, uint width, uint height, uint channels, uint bits)
+        {
+            this.Data = data;
+            this.Width = width;
+            this.Height = height;
+            this.Channels = channels;
+            this.Bits = bits;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the pixels. Rows follow each other without padding; planes, if any, follow each other.
+        /// </summary>
+        public byte[] Data
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the width in pixels.
+        /// </summary>
+        public uint Width
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the height in pixels.
+        /// </summary>
+        public uint Height
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the number of channels.
+        /// </summary>
+        public uint Channels
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the number of bits per sample.
+        /// </summary>
+        public uint Bits
+        {
+            get;
+        }
+
+        #endregion
+
+        #region Methods
+
+        internal static Pixels Copy(IntPtr data, ulong length, uint width, uint height, uint channels, uint bits)
+        {
+            var buffer = new byte[length];
+            if (buffer.Length > 0)
+                Marshal.Copy(data, buffer, 0, buffer.Length);
+            return new Pixels(buffer, width, height, channels, bits);
+        }
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+﻿namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Defines a tile of a level of a resolution pyramid. This class cannot be inherited.
+    /// </summary>
+    public sealed class PyramidTile
+    {
+
+        #region Constructors
+
+        internal PyramidTile(uint level, uint column, uint row, uint x, uint y, Pixels pixels)
+        {
+            this.Level = level;
+            this.Column = column;
+            this.Row = row;
+            this.X = x;
+            this.Y = y;
+            this.Pixels = pixels;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the level, counted as the reduce from the full resolution.
+        /// </summary>
+        public uint Level
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the column of the tile in the grid of its level.
+        /// </summary>
+        public uint Column
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the row of the tile in the grid of its level.
+        /// </summary>
+        public uint Row
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the horizontal position of the tile in its level.
+        /// </summary>
+        public uint X
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the vertical position of the tile in its level.
+        /// </summary>
+        public uint Y
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the pixels of the tile.
+        /// </summary>
+        public Pixels Pixels
+        {
+            get;
+        }
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
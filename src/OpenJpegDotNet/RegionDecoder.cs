@@ -0,0 +1,134 @@
+﻿using System;
+
+namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Decodes areas of a <see cref="CodestreamSource"/> from any number of threads, reusing idle codecs between requests. This class cannot be inherited.
+    /// </summary>
+    public sealed class RegionDecoder : OpenJpegObject
+    {
+
+        #region Constructors
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="RegionDecoder"/> class over the specified source.
+        /// </summary>
+        /// <param name="source">The source, which stays referenced until this object is disposed.</param>
+        /// <param name="threads">The number of threads handed to each codec.</param>
+        /// <exception cref="ArgumentNullException"><paramref name="source"/> is null.</exception>
+        /// <exception cref="ObjectDisposedException"><paramref name="source"/> is disposed.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="source"/> is not a valid codestream or JP2 file, or has a palette.</exception>
+        public RegionDecoder(CodestreamSource source, int threads = 0)
+        {
+            if (source == null)
+                throw new ArgumentNullException(nameof(source));
+
+            source.ThrowIfDisposed();
+
+            var ret = NativeMethods.openjpeg_openjp2_extensions_region_decoder_new(source.NativePtr, threads, out var region);
+            ErrorHelper.ThrowIfError(ret);
+            this.NativePtr = region;
+
+            NativeMethods.openjpeg_openjp2_extensions_region_decoder_get_info(this.NativePtr, out var info, null, 0);
+            var comps = new NativeMethods.extensions_header_comp_info_t[info.numcomps];
+            NativeMethods.openjpeg_openjp2_extensions_region_decoder_get_info(this.NativePtr, out info, comps, (uint)comps.Length);
+            this.Info = OpenJpeg.ToHeaderInfo(info, comps);
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the number of requests decoded.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public ulong Decodes
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                NativeMethods.openjpeg_openjp2_extensions_region_decoder_get_stats(this.NativePtr, out var decodes, out _);
+                return decodes;
+            }
+        }
+
+        /// <summary>
+        /// Gets the header of the source.
+        /// </summary>
+        public HeaderInfo Info
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the number of requests served by a codec left idle by an earlier one.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public ulong Reused
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                NativeMethods.openjpeg_openjp2_extensions_region_decoder_get_stats(this.NativePtr, out _, out var reused);
+                return reused;
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Decodes an area of the source. This can be called from several threads at the same time.
+        /// </summary>
+        /// <param name="options">The options of the decode, or null for the whole image at full resolution. <see cref="DecodeOptions.NumberOfThreads"/> is not used.</param>
+        /// <returns>The decoded <see cref="Image"/>.</returns>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        /// <exception cref="ArgumentOutOfRangeException"><see cref="DecodeOptions.Area"/> or <see cref="DecodeOptions.Reduce"/> is out of range.</exception>
+        /// <exception cref="OperationCanceledException">The decode was cancelled through <see cref="DecodeOptions.Token"/>.</exception>
+        /// <exception cref="TimeoutException">The deadline of <see cref="DecodeOptions.Token"/> passed.</exception>
+        public Image Decode(DecodeOptions options = null)
+        {
+            this.ThrowIfDisposed();
+
+            options = options ?? new DecodeOptions();
+            var token = options.GetTokenPtr();
+            var area = options.Area;
+
+            var ret = NativeMethods.openjpeg_openjp2_extensions_region_decoder_decode(this.NativePtr,
+                                                                                      options.Reduce,
+                                                                                      options.Layers,
+                                                                                      area.Left,
+                                                                                      area.Top,
+                                                                                      area.Right,
+                                                                                      area.Bottom,
+                                                                                      token,
+                                                                                      out var image);
+            ErrorHelper.ThrowIfError(ret);
+            return new Image(image);
+        }
+
+        #region Overrides 
+
+        /// <summary>
+        /// Releases all unmanaged resources.
+        /// </summary>
+        protected override void DisposeUnmanaged()
+        {
+            base.DisposeUnmanaged();
+
+            if (this.NativePtr == IntPtr.Zero)
+                return;
+
+            NativeMethods.openjpeg_openjp2_extensions_region_decoder_delete(this.NativePtr);
+        }
+
+        #endregion
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
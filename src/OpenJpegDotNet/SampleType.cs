@@ -0,0 +1,27 @@
+﻿namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Specifies the type of exported samples.
+    /// </summary>
+    public enum SampleType
+    {
+
+        /// <summary>
+        /// Specifies that 8 bit unsigned integer.
+        /// </summary>
+        UInt8 = 0,
+
+        /// <summary>
+        /// Specifies that 16 bit unsigned integer.
+        /// </summary>
+        UInt16 = 1,
+
+        /// <summary>
+        /// Specifies that 32 bit floating point number in the range of 0 to 1.
+        /// </summary>
+        Float32 = 2,
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+﻿using System;
+
+
+namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Defines a tile decoded by a <see cref="TileScheduler"/>. This class cannot be inherited.
+    /// </summary>
+    public sealed class ScheduledTile
+    {
+
+        #region Constructors
+
+        internal ScheduledTile(uint index, uint reduce, ulong generation, bool isPrefetch, uint x, uint y, Pixels pixels, Exception error)
+        {
+            this.Index = index;
+            this.Reduce = reduce;
+            this.Generation = generation;
+            this.IsPrefetch = isPrefetch;
+            this.X = x;
+            this.Y = y;
+            this.Pixels = pixels;
+            this.Error = error;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the tile index in the codestream.
+        /// </summary>
+        public uint Index
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the number of highest resolution levels discarded.
+        /// </summary>
+        public uint Reduce
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the generation the tile was requested for.
+        /// </summary>
+        public ulong Generation
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets a value indicating whether the tile was prefetched rather than requested.
+        /// </summary>
+        public bool IsPrefetch
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the horizontal position of the tile in the image decoded at the same reduce.
+        /// </summary>
+        public uint X
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the vertical position of the tile in the image decoded at the same reduce.
+        /// </summary>
+        public uint Y
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the pixels of the tile, or null when the tile failed to decode.
+        /// </summary>
+        public Pixels Pixels
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the reason the tile failed to decode, or null when it succeeded.
+        /// </summary>
+        public Exception Error
+        {
+            get;
+        }
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+﻿using System;
+
+namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Decodes a sequence of codestreams, such as the frames of a Digital Cinema Package, through a pipeline and hands them out in the order they were pushed. This class cannot be inherited.
+    /// </summary>
+    public sealed class SequenceDecoder : OpenJpegObject
+    {
+
+        #region Constructors
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="SequenceDecoder"/> class.
+        /// </summary>
+        /// <param name="reduce">The number of highest resolution levels to be discarded from every frame.</param>
+        /// <param name="layers">The maximum number of quality layers to decode. 0 decodes all of them.</param>
+        /// <param name="queueDepth">The number of frames in flight, held by the caller included.</param>
+        /// <param name="decodeThreads">The number of frames decoded at once. 0 or less means one per CPU.</param>
+        /// <param name="codecThreads">The number of threads handed to each codec.</param>
+        /// <param name="pool">The pool the frames are allocated from and returned to, which stays referenced until this object is disposed, or null.</param>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="queueDepth"/> is 0.</exception>
+        /// <exception cref="ObjectDisposedException"><paramref name="pool"/> is disposed.</exception>
+        /// <exception cref="OutOfMemoryException">Failed to allocate the sequence.</exception>
+        public SequenceDecoder(uint reduce, uint layers, uint queueDepth, int decodeThreads = 0, int codecThreads = 0, ImagePool pool = null)
+        {
+            if (queueDepth == 0)
+                throw new ArgumentOutOfRangeException(nameof(queueDepth));
+
+            pool?.ThrowIfDisposed();
+
+            this.NativePtr = NativeMethods.openjpeg_openjp2_extensions_sequence_new(reduce, layers, queueDepth, decodeThreads, codecThreads, pool?.NativePtr ?? IntPtr.Zero);
+            if (this.NativePtr == IntPtr.Zero)
+                throw new OutOfMemoryException();
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Tells the sequence that no more frames will be pushed, so <see cref="Pop"/> returns null once the last one is out.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public void Finish()
+        {
+            this.ThrowIfDisposed();
+            NativeMethods.openjpeg_openjp2_extensions_sequence_finish(this.NativePtr);
+        }
+
+        /// <summary>
+        /// Waits for the next frame in the order the frames were pushed.
+        /// </summary>
+        /// <returns>The next frame, which must be disposed to hand its slot back, or null after <see cref="Finish"/> once every frame has been popped.</returns>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        /// <exception cref="System.IO.InvalidDataException">The frame is not a valid codestream.</exception>
+        /// <exception cref="InvalidOperationException">The frame failed to decode.</exception>
+        public SequenceFrame Pop()
+        {
+            this.ThrowIfDisposed();
+
+            var ret = NativeMethods.openjpeg_openjp2_extensions_sequence_pop(this.NativePtr, out var image, out var index);
+            if (ret == NativeMethods.ErrorType.GeneralEndOfData)
+                return null;
+
+            ErrorHelper.ThrowIfError(ret);
+            return new SequenceFrame(this, image, index);
+        }
+
+        /// <summary>
+        /// Copies a codestream into a free slot of the sequence. This blocks while every slot is in flight or held, so frames must be popped on another thread.
+        /// </summary>
+        /// <param name="data">The codestream of the frame.</param>
+        /// <exception cref="ArgumentNullException"><paramref name="data"/> is null.</exception>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public void Push(byte[] data)
+        {
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+
+            this.ThrowIfDisposed();
+
+            unsafe
+            {
+                fixed (byte* ptr = data)
+                {
+                    var ret = NativeMethods.openjpeg_openjp2_extensions_sequence_push(this.NativePtr, (IntPtr)ptr, (ulong)data.Length);
+                    ErrorHelper.ThrowIfError(ret);
+                }
+            }
+        }
+
+        #region Overrides 
+
+        /// <summary>
+        /// Releases all unmanaged resources.
+        /// </summary>
+        protected override void DisposeUnmanaged()
+        {
+            base.DisposeUnmanaged();
+
+            if (this.NativePtr == IntPtr.Zero)
+                return;
+
+            NativeMethods.openjpeg_openjp2_extensions_sequence_delete(this.NativePtr);
+        }
+
+        #endregion
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+﻿using System;
+
+namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Represents a frame decoded by a <see cref="SequenceDecoder"/>. Its image belongs to a slot of the sequence, which is handed back on dispose. This class cannot be inherited.
+    /// </summary>
+    public sealed class SequenceFrame : OpenJpegObject
+    {
+
+        #region Fields
+
+        private readonly SequenceDecoder _Sequence;
+
+        #endregion
+
+        #region Constructors
+
+        internal SequenceFrame(SequenceDecoder sequence, IntPtr image, ulong index)
+        {
+            this._Sequence = sequence;
+            this.NativePtr = image;
+            this.Index = index;
+            this.Image = new Image(image, false);
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the decoded image, which is valid until this object is disposed.
+        /// </summary>
+        public Image Image
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the position of the frame in the order it was pushed.
+        /// </summary>
+        public ulong Index
+        {
+            get;
+        }
+
+        #endregion
+
+        #region Methods
+
+        #region Overrides 
+
+        /// <summary>
+        /// Releases all managed resources.
+        /// </summary>
+        protected override void DisposeManaged()
+        {
+            base.DisposeManaged();
+
+            this.Image.Dispose();
+        }
+
+        /// <summary>
+        /// Releases all unmanaged resources.
+        /// </summary>
+        protected override void DisposeUnmanaged()
+        {
+            base.DisposeUnmanaged();
+
+            if (this.NativePtr == IntPtr.Zero || this._Sequence.IsDisposed)
+                return;
+
+            NativeMethods.openjpeg_openjp2_extensions_sequence_release(this._Sequence.NativePtr, this.NativePtr);
+        }
+
+        #endregion
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
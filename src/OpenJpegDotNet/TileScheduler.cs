@@ -0,0 +1,252 @@
+﻿using System;
+using System.Runtime.ExceptionServices;
+using System.Runtime.InteropServices;
+
+namespace OpenJpegDotNet
+{
+
+    /// <summary>
+    /// Decodes whole tiles of a <see cref="CodestreamSource"/> on worker threads in priority order, for viewers that pan and zoom. This class cannot be inherited.
+    /// </summary>
+    public sealed class TileScheduler : OpenJpegObject
+    {
+
+        #region Fields
+
+        private readonly DelegateHandler<SchedulerCallback> _Handler;
+
+        private ExceptionDispatchInfo _Error;
+
+        #endregion
+
+        #region Delegates
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        private delegate void SchedulerCallback(IntPtr tile, IntPtr userData);
+
+        #endregion
+
+        #region Constructors
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TileScheduler"/> class over the specified source.
+        /// </summary>
+        /// <param name="source">The source, which stays referenced until this object is disposed.</param>
+        /// <param name="format">The pixel format of the tiles.</param>
+        /// <param name="callback">The method called with each tile on the worker threads, possibly at the same time. The first exception thrown here is rethrown by <see cref="Wait"/>.</param>
+        /// <param name="workers">The number of worker threads.</param>
+        /// <param name="threads">The number of threads handed to each codec.</param>
+        /// <param name="flags">The options of the conversion.</param>
+        /// <param name="prefetch">The number of levels coarser the neighbours of the requested tiles are prefetched at. 0 disables prefetching.</param>
+        /// <exception cref="ArgumentNullException"><paramref name="source"/> or <paramref name="callback"/> is null.</exception>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="workers"/> is 0.</exception>
+        /// <exception cref="ObjectDisposedException"><paramref name="source"/> is disposed.</exception>
+        /// <exception cref="System.IO.InvalidDataException"><paramref name="source"/> is not a valid codestream or JP2 file.</exception>
+        public TileScheduler(CodestreamSource source,
+                             ExportFormat format,
+                             Action<ScheduledTile> callback,
+                             uint workers = 1,
+                             int threads = 0,
+                             ExportFlags flags = ExportFlags.None,
+                             uint prefetch = 0)
+        {
+            if (source == null)
+                throw new ArgumentNullException(nameof(source));
+            if (callback == null)
+                throw new ArgumentNullException(nameof(callback));
+            if (workers == 0)
+                throw new ArgumentOutOfRangeException(nameof(workers));
+
+            source.ThrowIfDisposed();
+
+            this._Handler = new DelegateHandler<SchedulerCallback>((tile, userData) =>
+            {
+                try
+                {
+                    var scheduled = Marshal.PtrToStructure<NativeMethods.extensions_scheduler_tile_t>(tile);
+                    var status = (NativeMethods.ErrorType)scheduled.status;
+                    var pixels = status == NativeMethods.ErrorType.OK ?
+                                 Pixels.Copy(scheduled.data, scheduled.length, scheduled.width, scheduled.height, scheduled.channels, scheduled.bits) :
+                                 null;
+                    var error = status == NativeMethods.ErrorType.OK ? null : ErrorHelper.ToException(status);
+                    callback(new ScheduledTile(scheduled.index,
+                                               scheduled.reduce,
+                                               scheduled.generation,
+                                               scheduled.prefetch != 0,
+                                               scheduled.x,
+                                               scheduled.y,
+                                               pixels,
+                                               error));
+                }
+                catch (Exception e)
+                {
+                    lock (this._Handler)
+                        this._Error = this._Error ?? ExceptionDispatchInfo.Capture(e);
+                }
+            });
+
+            var ret = NativeMethods.openjpeg_openjp2_extensions_scheduler_new(source.NativePtr,
+                                                                              workers,
+                                                                              threads,
+                                                                              (int)format,
+                                                                              (uint)flags,
+                                                                              prefetch,
+                                                                              this._Handler.Handle,
+                                                                              IntPtr.Zero,
+                                                                              out var scheduler);
+            ErrorHelper.ThrowIfError(ret);
+            this.NativePtr = scheduler;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Gets the number of tiles cancelled while decoding for an older generation.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public ulong Cancelled
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                NativeMethods.openjpeg_openjp2_extensions_scheduler_get_stats(this.NativePtr, out _, out _, out _, out var cancelled, out _);
+                return cancelled;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of requested tiles delivered.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public ulong Decoded
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                NativeMethods.openjpeg_openjp2_extensions_scheduler_get_stats(this.NativePtr, out var decoded, out _, out _, out _, out _);
+                return decoded;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of queued tiles dropped by a newer generation.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public ulong Dropped
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                NativeMethods.openjpeg_openjp2_extensions_scheduler_get_stats(this.NativePtr, out _, out _, out var dropped, out _, out _);
+                return dropped;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of tiles which failed to decode.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public ulong Failed
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                NativeMethods.openjpeg_openjp2_extensions_scheduler_get_stats(this.NativePtr, out _, out _, out _, out _, out var failed);
+                return failed;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of prefetched tiles delivered.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public ulong Prefetched
+        {
+            get
+            {
+                this.ThrowIfDisposed();
+                NativeMethods.openjpeg_openjp2_extensions_scheduler_get_stats(this.NativePtr, out _, out var prefetched, out _, out _, out _);
+                return prefetched;
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Drops the queued work of the generations before <paramref name="generation"/> and cancels their tiles in progress.
+        /// </summary>
+        /// <param name="generation">The current generation.</param>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public void Advance(ulong generation)
+        {
+            this.ThrowIfDisposed();
+            NativeMethods.openjpeg_openjp2_extensions_scheduler_advance(this.NativePtr, generation);
+        }
+
+        /// <summary>
+        /// Queues a tile, higher priorities first. A newer generation drops everything queued for the older ones first.
+        /// </summary>
+        /// <param name="tileIndex">The index of the tile.</param>
+        /// <param name="reduce">The number of highest resolution levels to be discarded.</param>
+        /// <param name="priority">The priority of the tile.</param>
+        /// <param name="generation">The generation of the request.</param>
+        /// <returns>false if <paramref name="generation"/> is older than the current one; otherwise, true.</returns>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="tileIndex"/> or <paramref name="reduce"/> is out of range.</exception>
+        public bool Submit(uint tileIndex, uint reduce, int priority, ulong generation)
+        {
+            this.ThrowIfDisposed();
+
+            var ret = NativeMethods.openjpeg_openjp2_extensions_scheduler_submit(this.NativePtr, tileIndex, reduce, priority, generation);
+            if (ret == NativeMethods.ErrorType.GeneralCancelled)
+                return false;
+
+            ErrorHelper.ThrowIfError(ret);
+            return true;
+        }
+
+        /// <summary>
+        /// Blocks until nothing is queued, prefetches included, and no tile is decoding.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">This object is disposed.</exception>
+        public void Wait()
+        {
+            this.ThrowIfDisposed();
+            NativeMethods.openjpeg_openjp2_extensions_scheduler_wait(this.NativePtr);
+
+            ExceptionDispatchInfo error;
+            lock (this._Handler)
+            {
+                error = this._Error;
+                this._Error = null;
+            }
+
+            error?.Throw();
+        }
+
+        #region Overrides 
+
+        /// <summary>
+        /// Releases all unmanaged resources.
+        /// </summary>
+        protected override void DisposeUnmanaged()
+        {
+            base.DisposeUnmanaged();
+
+            if (this.NativePtr == IntPtr.Zero)
+                return;
+
+            NativeMethods.openjpeg_openjp2_extensions_scheduler_delete(this.NativePtr);
+        }
+
+        #endregion
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+﻿using System;
+using System.IO;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet
+{
+
+    internal static class ErrorHelper
+    {
+
+        #region Methods
+
+        public static Exception ToException(NativeMethods.ErrorType error)
+        {
+            switch (error)
+            {
+                case NativeMethods.ErrorType.OK:
+                    return null;
+                case NativeMethods.ErrorType.GeneralFileIOError:
+                    return new IOException("Failed to access the file.");
+                case NativeMethods.ErrorType.GeneralOutOfRange:
+                    return new ArgumentOutOfRangeException(null, "The specified argument is out of range.");
+                case NativeMethods.ErrorType.GeneralMemAlloc:
+                    return new OutOfMemoryException();
+                case NativeMethods.ErrorType.GeneralEndOfData:
+                    return new EndOfStreamException();
+                case NativeMethods.ErrorType.GeneralCancelled:
+                    return new OperationCanceledException();
+                case NativeMethods.ErrorType.GeneralDeadlineExceeded:
+                    return new TimeoutException("The deadline of the operation has passed.");
+                case NativeMethods.ErrorType.GeneralOverBudget:
+                    return new InsufficientMemoryException("The operation does not fit within the memory budget.");
+                case NativeMethods.ErrorType.ImageFileInvalid:
+                case NativeMethods.ErrorType.ImageFileWrongExtension:
+                    return new InvalidDataException("The data is not a valid JPEG 2000 codestream or JP2 file.");
+                case NativeMethods.ErrorType.ImageDecodeFailed:
+                    return new InvalidOperationException("Failed to decode the image.");
+                case NativeMethods.ErrorType.ImageEncodeFailed:
+                    return new InvalidOperationException("Failed to encode the image.");
+                default:
+                    return new InvalidOperationException($"The operation failed with {error}.");
+            }
+        }
+
+        public static void ThrowIfError(NativeMethods.ErrorType error)
+        {
+            var exception = ToException(error);
+            if (exception != null)
+                throw exception;
+        }
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file
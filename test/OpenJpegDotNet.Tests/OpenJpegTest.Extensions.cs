@@ -0,0 +1,1164 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Drawing;
+using System.IO;
+using System.Linq;
+using System.Runtime.InteropServices;
+using System.Threading;
+using System.Threading.Tasks;
+using Xunit;
+
+// ReSharper disable once CheckNamespace
+namespace OpenJpegDotNet.Tests
+{
+
+    public sealed partial class OpenJpegTest
+    {
+
+        #region Extensions
+
+        [Fact]
+        public void ExtensionsReadHeaderInfo()
+        {
+            var data = File.ReadAllBytes(Path.Combine(TestImageDirectory, "Bretagne1_0.j2k"));
+            var info = OpenJpeg.ReadHeaderInfo(data);
+
+            Assert.Equal(CodecFormat.J2k, info.Format);
+            Assert.Equal(0u, info.X0);
+            Assert.Equal(0u, info.Y0);
+            Assert.Equal(640u, info.X1);
+            Assert.Equal(480u, info.Y1);
+            Assert.Equal(640u, info.TileWidth);
+            Assert.Equal(480u, info.TileHeight);
+            Assert.Equal(1u, info.TilesX);
+            Assert.Equal(1u, info.TilesY);
+            Assert.Equal(3u, info.NumberOfComponents);
+            Assert.Equal(6u, info.NumberOfResolutions);
+            Assert.Equal(3u, info.NumberOfLayers);
+            Assert.Equal(ProgressionOrder.LayerResolutionComponentPrecinct, info.ProgressionOrder);
+            Assert.Equal(1u, info.Mct);
+            Assert.Equal(64u, info.CodeBlockWidth);
+            Assert.Equal(64u, info.CodeBlockHeight);
+            Assert.False(info.Irreversible);
+            Assert.Equal(0u, info.Rsiz);
+            Assert.False(info.HasIccProfile);
+            Assert.False(info.HasXml);
+            Assert.Equal(0ul, info.CodestreamOffset);
+
+            Assert.Equal(3, info.Components.Length);
+            foreach (var component in info.Components)
+            {
+                Assert.Equal(1u, component.Dx);
+                Assert.Equal(1u, component.Dy);
+                Assert.Equal(8u, component.Precision);
+                Assert.False(component.Signed);
+            }
+
+            Assert.Throws<InvalidDataException>(() => OpenJpeg.ReadHeaderInfo(new byte[16]));
+        }
+
+        [Fact]
+        public void ExtensionsJp2RoundTrip()
+        {
+            var j2k = File.ReadAllBytes(Path.Combine(TestImageDirectory, "Bretagne1_0.j2k"));
+            var jp2 = OpenJpeg.J2kToJp2(j2k, ColorSpace.Srgb, null, 2835, 2835);
+
+            var info = OpenJpeg.ReadHeaderInfo(jp2);
+            Assert.Equal(CodecFormat.Jp2, info.Format);
+            Assert.Equal(ColorSpace.Srgb, info.ColorSpace);
+            Assert.Equal((ulong)j2k.Length, info.CodestreamLength);
+            Assert.Equal(640u, info.X1);
+            Assert.Equal(480u, info.Y1);
+
+            var boxes = OpenJpeg.GetJp2Boxes(jp2);
+            Assert.Contains(boxes, box => box.Type == 0x6A703268 && box.Depth == 0); // jp2h
+            Assert.Contains(boxes, box => box.Type == 0x6A703263 && box.Length == (ulong)j2k.Length + box.HeaderLength); // jp2c
+            Assert.NotNull(OpenJpeg.FindJp2Box(jp2, 0x69686472)); // ihdr
+            Assert.Null(OpenJpeg.GetJp2IccProfile(jp2));
+            Assert.True(OpenJpeg.GetJp2Resolution(jp2, true, out var resolutionX, out var resolutionY));
+            Assert.Equal(2835.0, resolutionX, 0);
+            Assert.Equal(2835.0, resolutionY, 0);
+
+            Assert.Equal(j2k, OpenJpeg.Jp2ToJ2k(jp2));
+
+            using var expected = OpenJpeg.DecodeMemory(j2k);
+            using var actual = OpenJpeg.DecodeMemory(jp2);
+            AssertSameImage(expected, actual);
+            Assert.Equal(ColorSpace.Srgb, actual.ColorSpace);
+        }
+
+        [Fact]
+        public void ExtensionsCatalogScan()
+        {
+            const uint width = 640;
+            const uint height = 480;
+
+            var directory = Path.Combine(ResultDirectory, nameof(this.ExtensionsCatalogScan), "Images");
+            if (Directory.Exists(directory))
+                Directory.Delete(directory, true);
+            Directory.CreateDirectory(directory);
+            foreach (var file in Directory.GetFiles(TestImageDirectory))
+                File.Copy(file, Path.Combine(directory, Path.GetFileName(file)));
+
+            var raw = File.ReadAllBytes(Path.Combine(TestImageDirectory, "Bretagne1_0.raw"));
+
+            using var compressionParameters = new CompressionParameters();
+            OpenJpeg.SetDefaultEncoderParameters(compressionParameters);
+            compressionParameters.TcpNumLayers = 1;
+            compressionParameters.CodingParameterDistortionAllocation = 1;
+            compressionParameters.TileSizeOn = true;
+            compressionParameters.CodingParameterTdx = 128;
+            compressionParameters.CodingParameterTdy = 96;
+
+            var files = new Dictionary<string, byte[]>
+            {
+                ["Bretagne1_0.j2k"] = File.ReadAllBytes(Path.Combine(TestImageDirectory, "Bretagne1_0.j2k")),
+                ["tiled.j2k"] = OpenJpeg.EncodePixels(CodecFormat.J2k, compressionParameters, raw, width, height, 3, 1, 8, ColorSpace.Srgb)
+            };
+            files["tiled.jp2"] = OpenJpeg.J2kToJp2(files["tiled.j2k"], ColorSpace.Srgb, null, 2835, 2835);
+            Assert.Equal(5u, OpenJpeg.ReadHeaderInfo(files["tiled.j2k"]).TilesX);
+            Assert.Equal(5u, OpenJpeg.ReadHeaderInfo(files["tiled.j2k"]).TilesY);
+            File.WriteAllBytes(Path.Combine(directory, "tiled.j2k"), files["tiled.j2k"]);
+            File.WriteAllBytes(Path.Combine(directory, "tiled.jp2"), files["tiled.jp2"]);
+
+            // The raw and JPEG files are not indexed
+            var output = Path.Combine(ResultDirectory, nameof(this.ExtensionsCatalogScan), "catalog.csv");
+            OpenJpeg.CatalogScan(directory, output, CatalogFormat.Csv, out var scanned, out var failed, tileSizes: true);
+            Assert.Equal((ulong)files.Count, scanned);
+            Assert.Equal(0ul, failed);
+
+            var lines = File.ReadAllLines(output);
+            Assert.Equal(files.Count + 1, lines.Length);
+            Assert.Equal("path,status,file_size,format,x0,y0,x1,y1,tx0,ty0,tdx,tdy,tw,th,numcomps,prec,sgnd,dx,dy," +
+                         "numresolutions,numlayers,prog_order,irreversible,color_space,has_icc_profile,has_xml,tile_sizes", lines[0]);
+
+            foreach (var line in lines.Skip(1))
+            {
+                // The path is quoted and followed by the fields in header order
+                var close = line.LastIndexOf('"');
+                var data = files[Path.GetFileName(line.Substring(1, close - 1))];
+                var info = OpenJpeg.ReadHeaderInfo(data);
+                var component = info.Components[0];
+                var tileSizes = GetTileSizes(data, info);
+                Assert.Equal(info.TilesX * info.TilesY, (uint)tileSizes.Length);
+
+                var expected = new object[]
+                {
+                    0, data.Length, (int)info.Format,
+                    info.X0, info.Y0, info.X1, info.Y1,
+                    info.TileX0, info.TileY0, info.TileWidth, info.TileHeight, info.TilesX, info.TilesY,
+                    info.NumberOfComponents, component.Precision, component.Signed ? 1 : 0, component.Dx, component.Dy,
+                    info.NumberOfResolutions, info.NumberOfLayers, (int)info.ProgressionOrder,
+                    info.Irreversible ? 1 : 0, (int)info.ColorSpace, info.HasIccProfile ? 1 : 0, info.HasXml ? 1 : 0,
+                    string.Join(";", tileSizes)
+                };
+                Assert.Equal(expected.Select(value => value.ToString()), line.Substring(close + 2).Split(','));
+            }
+        }
+
+        [Fact]
+        public void ExtensionsDecodeMemory()
+        {
+            const string testImage = "Bretagne1_0.j2k";
+            var path = Path.GetFullPath(Path.Combine(TestImageDirectory, testImage));
+            var data = File.ReadAllBytes(path);
+
+            var targets = new[]
+            {
+                new { Reduce = 0u, Area = Rectangle.Empty },
+                new { Reduce = 1u, Area = Rectangle.Empty },
+                new { Reduce = 3u, Area = Rectangle.Empty },
+                new { Reduce = 0u, Area = Rectangle.FromLTRB(17, 33, 401, 290) },
+                new { Reduce = 2u, Area = Rectangle.FromLTRB(17, 33, 401, 290) },
+                new { Reduce = 0u, Area = Rectangle.FromLTRB(600, 450, 640, 480) },
+            };
+
+            using var source = new CodestreamSource(data);
+            using var region = new RegionDecoder(source);
+            Assert.Equal(640u, region.Info.X1);
+
+            foreach (var target in targets)
+            {
+                var options = new DecodeOptions
+                {
+                    Reduce = target.Reduce,
+                    Area = target.Area
+                };
+
+                using var expected = DecodeReference(path, CodecFormat.J2k, target.Reduce, target.Area);
+                using (var actual = OpenJpeg.DecodeMemory(data, options))
+                    AssertSameImage(expected, actual);
+                using (var actual = OpenJpeg.ParallelDecodeMemory(data, 2, options))
+                    AssertSameImage(expected, actual);
+                using (var actual = source.Decode(options))
+                    AssertSameImage(expected, actual);
+                using (var actual = region.Decode(options))
+                    AssertSameImage(expected, actual);
+            }
+
+            Assert.Equal((ulong)targets.Length, region.Decodes);
+
+            this.DisposeAndCheckDisposedState(region);
+            this.DisposeAndCheckDisposedState(source);
+        }
+
+        [Fact]
+        public void ExtensionsDecodeMemoryTiledArea()
+        {
+            const uint width = 640;
+            const uint height = 480;
+
+            var raw = File.ReadAllBytes(Path.Combine(TestImageDirectory, "Bretagne1_0.raw"));
+
+            using var compressionParameters = new CompressionParameters();
+            OpenJpeg.SetDefaultEncoderParameters(compressionParameters);
+            compressionParameters.TcpNumLayers = 1;
+            compressionParameters.CodingParameterDistortionAllocation = 1;
+            compressionParameters.TileSizeOn = true;
+            compressionParameters.CodingParameterTdx = 128;
+            compressionParameters.CodingParameterTdy = 96;
+
+            var data = OpenJpeg.EncodePixels(CodecFormat.J2k, compressionParameters, raw, width, height, 3, 1, 8, ColorSpace.Srgb);
+            Assert.Equal(5u, OpenJpeg.ReadHeaderInfo(data).TilesX);
+
+            var path = Path.Combine(ResultDirectory, nameof(this.ExtensionsDecodeMemoryTiledArea), "tiled.j2k");
+            Directory.CreateDirectory(Path.GetDirectoryName(path));
+            File.WriteAllBytes(path, data);
+
+            // Neither edge of the areas is on the tile grid, so the tiles around them are only partly covered
+            var targets = new[]
+            {
+                new { Reduce = 0u, Area = Rectangle.FromLTRB(70, 50, 390, 301) },
+                new { Reduce = 1u, Area = Rectangle.FromLTRB(70, 50, 390, 301) },
+                new { Reduce = 0u, Area = Rectangle.FromLTRB(129, 97, 130, 98) },
+                new { Reduce = 2u, Area = Rectangle.FromLTRB(1, 1, 639, 479) },
+            };
+
+            foreach (var target in targets)
+            {
+                var options = new DecodeOptions
+                {
+                    Reduce = target.Reduce,
+                    Area = target.Area
+                };
+
+                using var expected = DecodeReference(path, CodecFormat.J2k, target.Reduce, target.Area);
+                using (var actual = OpenJpeg.DecodeMemory(data, options))
+                    AssertSameImage(expected, actual);
+                using (var actual = OpenJpeg.ParallelDecodeMemory(data, 3, options))
+                    AssertSameImage(expected, actual);
+
+                var rgb = expected.ExportPixels(ExportFormat.Rgb24);
+                var raster = OpenJpeg.RasterDecodeMemory(data, new[] { 0u, 1u, 2u }, BandLayout.Bip, SampleType.UInt8, out var rasterWidth, out var rasterHeight, 2, options);
+                Assert.Equal(rgb.Width, rasterWidth);
+                Assert.Equal(rgb.Height, rasterHeight);
+                Assert.Equal(rgb.Data, raster);
+
+                // The tiles handed out are cropped to the area and cover it exactly once
+                var covered = new byte[rgb.Data.Length];
+                OpenJpeg.TilesDecode(data, ExportFormat.Rgb24, tile =>
+                {
+                    for (var y = 0; y < tile.Pixels.Height; y++)
+                        Array.Copy(tile.Pixels.Data, y * tile.Pixels.Width * 3, covered, ((tile.Y + y) * rgb.Width + tile.X) * 3, tile.Pixels.Width * 3);
+                }, options: options);
+                Assert.Equal(rgb.Data, covered);
+            }
+        }
+
+        [Fact]
+        public void ExtensionsRasterDecodeFile()
+        {
+            const uint width = 640;
+            const uint height = 480;
+
+            var raw = File.ReadAllBytes(Path.Combine(TestImageDirectory, "Bretagne1_0.raw"));
+
+            using var compressionParameters = new CompressionParameters();
+            OpenJpeg.SetDefaultEncoderParameters(compressionParameters);
+            compressionParameters.TcpNumLayers = 1;
+            compressionParameters.CodingParameterDistortionAllocation = 1;
+            compressionParameters.TileSizeOn = true;
+            compressionParameters.CodingParameterTdx = 32;
+            compressionParameters.CodingParameterTdy = 32;
+
+            var data = OpenJpeg.EncodePixels(CodecFormat.J2k, compressionParameters, raw, width, height, 3, 1, 8, ColorSpace.Srgb);
+
+            var path = Path.Combine(ResultDirectory, nameof(this.ExtensionsRasterDecodeFile), "raster.raw");
+            Directory.CreateDirectory(Path.GetDirectoryName(path));
+
+            var options = new DecodeOptions { Area = Rectangle.FromLTRB(70, 50, 390, 301) };
+            foreach (var layout in new[] { BandLayout.Bsq, BandLayout.Bil, BandLayout.Bip })
+            {
+                foreach (var sampleType in new[] { SampleType.UInt8, SampleType.UInt16, SampleType.Float32 })
+                {
+                    var expected = OpenJpeg.RasterDecodeMemory(data, new[] { 2u, 0u }, layout, sampleType, out var expectedWidth, out var expectedHeight, 2, options);
+                    OpenJpeg.RasterDecodeFile(data, path, new[] { 2u, 0u }, layout, sampleType, out var actualWidth, out var actualHeight, 2, options);
+                    Assert.Equal(expectedWidth, actualWidth);
+                    Assert.Equal(expectedHeight, actualHeight);
+                    Assert.Equal(expected, File.ReadAllBytes(path));
+                }
+            }
+
+            File.Delete(path);
+
+            // Cancelled once the file is there, between two of the 300 tiles, which removes the file again
+            using var token = new CancelToken();
+            var cancelOptions = new DecodeOptions { Token = token };
+            var decode = Task.Run(() => OpenJpeg.RasterDecodeFile(data, path, null, BandLayout.Bsq, SampleType.Float32, out _, out _, 1, cancelOptions));
+            SpinWait.SpinUntil(() => File.Exists(path) || decode.IsCompleted);
+            token.Cancel();
+            Assert.Throws<OperationCanceledException>(() => decode.GetAwaiter().GetResult());
+            Assert.False(File.Exists(path));
+        }
+
+        [Fact]
+        public void ExtensionsDecodeMemoryWithBudget()
+        {
+            var data = File.ReadAllBytes(Path.Combine(TestImageDirectory, "Bretagne1_0.j2k"));
+
+            OpenJpeg.EstimateBudget(data, 0, Rectangle.Empty, out var imageBytes, out var tileBytes);
+            Assert.Equal(640ul * 480 * 3 * sizeof(int), imageBytes);
+            Assert.True(tileBytes > 0);
+
+            OpenJpeg.EstimateBudget(data, 1, Rectangle.Empty, out var reducedImageBytes, out var reducedTileBytes);
+            Assert.Equal(320ul * 240 * 3 * sizeof(int), reducedImageBytes);
+
+            var budget = reducedImageBytes + reducedTileBytes;
+            Assert.Throws<InsufficientMemoryException>(() => OpenJpeg.AdmitBudget(data, budget, BudgetFlags.None, 0, Rectangle.Empty, out _));
+            Assert.Equal(BudgetMode.Full, OpenJpeg.AdmitBudget(data, budget, BudgetFlags.AllowReduce, 0, Rectangle.Empty, out var admittedReduce));
+            Assert.Equal(1u, admittedReduce);
+            Assert.Equal(BudgetMode.Tiled, OpenJpeg.AdmitBudget(data, tileBytes, BudgetFlags.AllowTiled, 0, Rectangle.Empty, out admittedReduce));
+            Assert.Equal(0u, admittedReduce);
+
+            Assert.Throws<ArgumentOutOfRangeException>(() => OpenJpeg.DecodeMemoryWithBudget(data, budget, BudgetFlags.AllowTiled, out _));
+
+            using var image = OpenJpeg.DecodeMemoryWithBudget(data, budget, BudgetFlags.AllowReduce, out admittedReduce);
+            Assert.Equal(1u, admittedReduce);
+            Assert.Equal(320u, image.Components[0].Width);
+            Assert.Equal(240u, image.Components[0].Height);
+        }
+
+        [Fact]
+        public void ExtensionsExportPixels()
+        {
+            var data = File.ReadAllBytes(Path.Combine(TestImageDirectory, "Bretagne1_0.j2k"));
+            using var image = OpenJpeg.DecodeMemory(data);
+
+            var rgb = image.ExportPixels(ExportFormat.Rgb24);
+            Assert.Equal(640u, rgb.Width);
+            Assert.Equal(480u, rgb.Height);
+            Assert.Equal(3u, rgb.Channels);
+            Assert.Equal(8u, rgb.Bits);
+            Assert.Equal(640 * 480 * 3, rgb.Data.Length);
+
+            var red = image.ExportComponent(0, SampleType.UInt8);
+            for (var index = 0; index < red.Length; index++)
+                Assert.Equal(red[index], rgb.Data[index * 3]);
+
+            var bgr = image.ExportPixels(ExportFormat.Bgr24);
+            var rgba = image.ExportPixels(ExportFormat.Rgba32);
+            var bgra = image.ExportPixels(ExportFormat.Bgra32);
+            for (var index = 0; index < 640 * 480; index++)
+            {
+                Assert.Equal(rgb.Data[index * 3 + 0], bgr.Data[index * 3 + 2]);
+                Assert.Equal(rgb.Data[index * 3 + 1], bgr.Data[index * 3 + 1]);
+                Assert.Equal(rgb.Data[index * 3 + 2], bgr.Data[index * 3 + 0]);
+                Assert.Equal(rgb.Data[index * 3 + 0], rgba.Data[index * 4 + 0]);
+                Assert.Equal(rgb.Data[index * 3 + 2], bgra.Data[index * 4 + 0]);
+                Assert.Equal(byte.MaxValue, rgba.Data[index * 4 + 3]);
+                Assert.Equal(byte.MaxValue, bgra.Data[index * 4 + 3]);
+            }
+
+            var bip = image.ExportBands(new[] { 0u, 1u, 2u }, BandLayout.Bip, SampleType.UInt8);
+            Assert.Equal(rgb.Data, bip);
+            var raster = OpenJpeg.RasterDecodeMemory(data, new[] { 0u, 1u, 2u }, BandLayout.Bip, SampleType.UInt8, out var width, out var height);
+            Assert.Equal(640u, width);
+            Assert.Equal(480u, height);
+            Assert.Equal(rgb.Data, raster);
+        }
+
+        [Fact]
+        public void ExtensionsExportPixelsSycc()
+        {
+            const uint width = 33;
+            const uint height = 19;
+
+            using var compressionParameters = new CompressionParameters();
+            OpenJpeg.SetDefaultEncoderParameters(compressionParameters);
+            compressionParameters.TcpNumLayers = 1;
+            compressionParameters.CodingParameterDistortionAllocation = 1;
+            compressionParameters.TcpMCT = 0;
+
+            // 4:2:0 chroma without a color space, which is taken for sYCC as opj_decompress does
+            byte[] data;
+            using (var image = CreateSubsampledImage(0, 0, width, height, 2, 2, ColorSpace.Unspecified))
+            {
+                var components = image.Components;
+                SetComponentData(components[0], (x, y) => (x * 7 + y * 13) % 256);
+                SetComponentData(components[1], (x, y) => (x * 29 + y * 3 + 40) % 256);
+                SetComponentData(components[2], (x, y) => (x * 5 + y * 31 + 90) % 256);
+                data = OpenJpeg.EncodeImage(CodecFormat.J2k, compressionParameters, image);
+            }
+
+            using var decoded = OpenJpeg.DecodeMemory(data);
+            var decodedComponents = decoded.Components;
+            var luma = GetComponentData(decodedComponents[0]);
+            var cb = GetComponentData(decodedComponents[1]);
+            var cr = GetComponentData(decodedComponents[2]);
+            var chromaWidth = (int)decodedComponents[1].Width;
+
+            var rgb = decoded.ExportPixels(ExportFormat.Rgb24);
+            Assert.Equal(width, rgb.Width);
+            Assert.Equal(height, rgb.Height);
+            for (var y = 0; y < height; y++)
+            {
+                for (var x = 0; x < width; x++)
+                {
+                    var index = y * (int)width + x;
+                    var chroma = y / 2 * chromaWidth + x / 2;
+                    var expected = SyccToRgb(8, luma[index], cb[chroma], cr[chroma]);
+                    for (var channel = 0; channel < 3; channel++)
+                        Assert.InRange(rgb.Data[index * 3 + channel] - expected[channel], -1, 1);
+                }
+            }
+
+            var ycc = decoded.ExportPixels(ExportFormat.Rgb24, ExportFlags.NoColorConversion);
+            for (var index = 0; index < luma.Length; index++)
+                Assert.Equal(luma[index], ycc.Data[index * 3]);
+        }
+
+        [Fact]
+        public void ExtensionsExportPixelsUpsample()
+        {
+            // 4:2:0 on an odd origin, so the first and last luma columns and rows lie beyond the chroma samples
+            using var image = CreateSubsampledImage(3, 1, 16, 10, 2, 2, ColorSpace.Srgb);
+            var components = image.Components;
+            for (var index = 0; index < components.Length; index++)
+            {
+                var offset = index * 50 + 11;
+                SetComponentData(components[index], (x, y) => (x * 37 + y * 91 + offset) % 256);
+            }
+
+            foreach (var bilinear in new[] { false, true })
+            {
+                var flags = ExportFlags.NoColorConversion | (bilinear ? ExportFlags.UpsampleBilinear : ExportFlags.None);
+                var pixels = image.ExportPixels(ExportFormat.Rgb24, flags);
+                Assert.Equal(13u, pixels.Width);
+                Assert.Equal(9u, pixels.Height);
+
+                for (var channel = 0; channel < components.Length; channel++)
+                {
+                    var expected = Upsample(components[0], components[channel], bilinear);
+                    for (var index = 0; index < expected.Length; index++)
+                        Assert.Equal(expected[index], pixels.Data[index * 3 + channel]);
+                }
+            }
+        }
+
+        [Fact]
+        public void ExtensionsExportComponentRescale()
+        {
+            // UInt8 and UInt16 take the replicate path from 1 bit, the float path from 12 to 8 bits, the double path
+            // from 12 to 16 and 16 to 8 bits and copy 16 bits as they are
+            foreach (var precision in new[] { 1, 12, 16 })
+            {
+                foreach (var signed in new[] { false, true })
+                {
+                    var low = signed ? -(1 << (precision - 1)) : 0;
+                    var high = signed ? (1 << (precision - 1)) - 1 : (1 << precision) - 1;
+                    var range = (1L << precision) - 1;
+
+                    // Every value, or every seventh for 16 bits, and one beyond each end which is clamped
+                    var step = precision == 16 ? 7 : 1;
+                    var samples = Enumerable.Range(0, (high - low + 2) / step + 1).Select(index => low - 1 + index * step).Append(high).Append(high + 1).ToArray();
+
+                    using var image = CreateImage((uint)samples.Length, 1, 1, ColorSpace.Gray, (uint)precision, signed);
+                    Marshal.Copy(samples, 0, image.Components[0].Data, samples.Length);
+
+                    var uint8 = image.ExportComponent(0, SampleType.UInt8);
+                    var uint16 = image.ExportComponent(0, SampleType.UInt16);
+                    var float32 = image.ExportComponent(0, SampleType.Float32);
+                    for (var index = 0; index < samples.Length; index++)
+                    {
+                        var u = Math.Min(high, Math.Max(low, samples[index])) - low;
+                        Assert.Equal(Rescale(u, range, byte.MaxValue), uint8[index]);
+                        Assert.Equal(Rescale(u, range, ushort.MaxValue), BitConverter.ToUInt16(uint16, index * 2));
+                        Assert.Equal((float)u / range, BitConverter.ToSingle(float32, index * 4));
+                    }
+                }
+            }
+        }
+
+        [Fact]
+        public void ExtensionsExportPixelsAlpha()
+        {
+            const uint width = 31;
+            const uint height = 17;
+
+            var source = new byte[width * height * 4];
+            for (var index = 0; index < source.Length; index++)
+                source[index] = (byte)(index * 7 % 256);
+
+            using var image = CreateImage(width, height, 4, ColorSpace.Srgb);
+            image.ImportPixels(source, 4, 1);
+            image.Components[3].Alpha = 1;
+
+            var rgba = image.ExportPixels(ExportFormat.Rgba32);
+            Assert.Equal(4u, rgba.Channels);
+            Assert.Equal(source, rgba.Data);
+
+            var bgra = image.ExportPixels(ExportFormat.Bgra32);
+            var premultiplied = image.ExportPixels(ExportFormat.Rgba32, ExportFlags.PremultiplyAlpha);
+            for (var index = 0; index < width * height; index++)
+            {
+                Assert.Equal(source[index * 4 + 2], bgra.Data[index * 4 + 0]);
+                Assert.Equal(source[index * 4 + 0], bgra.Data[index * 4 + 2]);
+                Assert.Equal(source[index * 4 + 3], bgra.Data[index * 4 + 3]);
+
+                var alpha = source[index * 4 + 3];
+                Assert.Equal(alpha, premultiplied.Data[index * 4 + 3]);
+                for (var channel = 0; channel < 3; channel++)
+                    Assert.InRange(premultiplied.Data[index * 4 + channel] - source[index * 4 + channel] * alpha / 255.0, -1.0, 1.0);
+            }
+
+            // Without the flag the fourth component is a color channel and the pixels are opaque
+            image.Components[3].Alpha = 0;
+            rgba = image.ExportPixels(ExportFormat.Rgba32);
+            for (var index = 0; index < width * height; index++)
+                Assert.Equal(byte.MaxValue, rgba.Data[index * 4 + 3]);
+        }
+
+        [Fact]
+        public void ExtensionsDecodeMemoryAlpha()
+        {
+            const uint width = 256;
+            const uint height = 192;
+
+            var source = new byte[width * height * 4];
+            for (var index = 0; index < source.Length; index++)
+                source[index] = (byte)(index * 7 % 256);
+
+            using var compressionParameters = new CompressionParameters();
+            OpenJpeg.SetDefaultEncoderParameters(compressionParameters);
+            compressionParameters.TcpNumLayers = 1;
+            compressionParameters.CodingParameterDistortionAllocation = 1;
+            compressionParameters.TileSizeOn = true;
+            compressionParameters.CodingParameterTdx = 128;
+            compressionParameters.CodingParameterTdy = 96;
+
+            byte[] data;
+            using (var image = CreateImage(width, height, 4, ColorSpace.Srgb))
+            {
+                image.ImportPixels(source, 4, 1);
+                image.Components[3].Alpha = 1;
+                data = OpenJpeg.EncodeImage(CodecFormat.Jp2, compressionParameters, image);
+            }
+
+            var path = Path.Combine(ResultDirectory, nameof(this.ExtensionsDecodeMemoryAlpha), "rgba.jp2");
+            Directory.CreateDirectory(Path.GetDirectoryName(path));
+            File.WriteAllBytes(path, data);
+
+            // The channel definition of the JP2 file marks the fourth component as opacity
+            using (var expected = DecodeReference(path, CodecFormat.Jp2, 0, Rectangle.Empty))
+            {
+                Assert.Equal(1, expected.Components[3].Alpha);
+                using var actual = OpenJpeg.DecodeMemory(data);
+                AssertSameImage(expected, actual);
+                Assert.Equal(source, actual.ExportPixels(ExportFormat.Rgba32).Data);
+            }
+
+            var covered = new byte[source.Length];
+            OpenJpeg.TilesDecode(data, ExportFormat.Rgba32, tile =>
+            {
+                for (var y = 0; y < tile.Pixels.Height; y++)
+                    Array.Copy(tile.Pixels.Data, y * tile.Pixels.Width * 4, covered, ((tile.Y + y) * width + tile.X) * 4, tile.Pixels.Width * 4);
+            });
+            Assert.Equal(source, covered);
+
+            // The first tile alone, decoded twice by the same codec of the region decoder and by the scheduler
+            var first = new byte[128 * 96 * 4];
+            for (var y = 0; y < 96; y++)
+                Array.Copy(source, y * width * 4, first, y * 128 * 4, 128 * 4);
+
+            using var codestream = new CodestreamSource(data);
+            using (var region = new RegionDecoder(codestream))
+            {
+                for (var index = 0; index < 2; index++)
+                {
+                    using var actual = region.Decode(new DecodeOptions { Area = Rectangle.FromLTRB(0, 0, 128, 96) });
+                    Assert.Equal(1, actual.Components[3].Alpha);
+                    Assert.Equal(first, actual.ExportPixels(ExportFormat.Rgba32).Data);
+                }
+            }
+
+            var tiles = new List<ScheduledTile>();
+            using (var scheduler = new TileScheduler(codestream, ExportFormat.Rgba32, tile =>
+            {
+                lock (tiles)
+                    tiles.Add(tile);
+            }, 1))
+            {
+                Assert.True(scheduler.Submit(0, 0, 0, 1));
+                scheduler.Wait();
+            }
+
+            var scheduled = Assert.Single(tiles);
+            Assert.Null(scheduled.Error);
+            Assert.Equal(first, scheduled.Pixels.Data);
+        }
+
+        [Fact]
+        public void ExtensionsImportEncodeDecode()
+        {
+            const uint width = 640;
+            const uint height = 480;
+
+            var raw = File.ReadAllBytes(Path.Combine(TestImageDirectory, "Bretagne1_0.raw"));
+
+            using var compressionParameters = new CompressionParameters();
+            OpenJpeg.SetDefaultEncoderParameters(compressionParameters);
+            compressionParameters.TcpNumLayers = 1;
+            compressionParameters.CodingParameterDistortionAllocation = 1;
+
+            using var image = CreateImage(width, height, 3, ColorSpace.Srgb);
+            image.ImportPixels(raw, 3, 1);
+
+            foreach (var format in new[] { CodecFormat.J2k, CodecFormat.Jp2 })
+            {
+                var encoded = OpenJpeg.EncodeImage(format, compressionParameters, image);
+                Assert.Equal(format, OpenJpeg.ReadHeaderInfo(encoded).Format);
+                using (var decoded = OpenJpeg.DecodeMemory(encoded))
+                    Assert.Equal(raw, decoded.ExportPixels(ExportFormat.Rgb24).Data);
+
+                encoded = OpenJpeg.EncodePixels(format, compressionParameters, raw, width, height, 3, 1, 8, ColorSpace.Srgb);
+                using (var decoded = OpenJpeg.DecodeMemory(encoded))
+                    Assert.Equal(raw, decoded.ExportPixels(ExportFormat.Rgb24).Data);
+            }
+
+            Assert.Throws<ArgumentOutOfRangeException>(() => image.ImportPixels(new byte[16], 3, 1));
+        }
+
+        [Fact]
+        public void ExtensionsDecodeCache()
+        {
+            var data = File.ReadAllBytes(Path.Combine(TestImageDirectory, "Bretagne1_0.j2k"));
+
+            using var cache = new DecodeCache(64 * 1024 * 1024);
+            var first = cache.Decode(data, ExportFormat.Rgb24);
+            Assert.Equal(0ul, cache.Hits);
+            Assert.Equal(1ul, cache.Misses);
+            Assert.Equal(1ul, cache.Entries);
+            Assert.Equal((ulong)(first.Data.Length + data.Length), cache.Bytes);
+
+            var second = cache.Decode(data, ExportFormat.Rgb24);
+            Assert.Equal(1ul, cache.Hits);
+            Assert.Equal(1ul, cache.Misses);
+            Assert.Equal(first.Data, second.Data);
+
+            var reduced = cache.Decode(data, ExportFormat.Rgb24, new DecodeOptions { Reduce = 1 });
+            Assert.Equal(320u, reduced.Width);
+            Assert.Equal(2ul, cache.Misses);
+
+            var bgr = cache.Decode(data, ExportFormat.Bgr24);
+            Assert.Equal(3ul, cache.Misses);
+            Assert.Equal(3ul, cache.Entries);
+            Assert.Equal(first.Data[0], bgr.Data[2]);
+
+            // The conversion flags are part of the request
+            cache.Decode(data, ExportFormat.Rgba32);
+            cache.Decode(data, ExportFormat.Rgba32, flags: ExportFlags.PremultiplyAlpha);
+            Assert.Equal(5ul, cache.Misses);
+
+            cache.Clear();
+            Assert.Equal(0ul, cache.Entries);
+            Assert.Equal(0ul, cache.Bytes);
+
+            cache.Decode(data, ExportFormat.Rgb24);
+            Assert.Equal(6ul, cache.Misses);
+
+            this.DisposeAndCheckDisposedState(cache);
+        }
+
+        [Fact]
+        public void ExtensionsCancel()
+        {
+            var data = File.ReadAllBytes(Path.Combine(TestImageDirectory, "Bretagne1_0.j2k"));
+
+            using var token = new CancelToken();
+            Assert.False(token.IsCancellationRequested);
+            token.Cancel();
+            Assert.True(token.IsCancellationRequested);
+            Assert.False(token.IsDeadlineExceeded);
+
+            var options = new DecodeOptions { Token = token };
+            Assert.Throws<OperationCanceledException>(() => OpenJpeg.DecodeMemory(data, options));
+            Assert.Throws<OperationCanceledException>(() => OpenJpeg.TilesDecode(data, ExportFormat.Rgb24, tile => { }, options: options));
+            Assert.Throws<OperationCanceledException>(() => OpenJpeg.PyramidDecode(data, 256, ExportFormat.Rgb24, tile => { }, options: options));
+
+            using var source = new CodestreamSource(data);
+            Assert.Throws<OperationCanceledException>(() => source.Decode(options));
+
+            // An exception thrown by the callback stops the decode and comes out as is
+            Assert.Throws<NotSupportedException>(() => OpenJpeg.TilesDecode(data, ExportFormat.Rgb24, tile => throw new NotSupportedException()));
+
+            this.DisposeAndCheckDisposedState(token);
+            Assert.Throws<ObjectDisposedException>(() => OpenJpeg.DecodeMemory(data, options));
+        }
+
+        [Fact]
+        public void ExtensionsTilesDecode()
+        {
+            var data = File.ReadAllBytes(Path.Combine(TestImageDirectory, "Bretagne1_0.j2k"));
+            using var image = OpenJpeg.DecodeMemory(data);
+            var expected = image.ExportPixels(ExportFormat.Rgb24);
+
+            foreach (var maxPending in new[] { 0u, 2u })
+            {
+                var tiles = new List<DecodedTile>();
+                OpenJpeg.TilesDecode(data, ExportFormat.Rgb24, tiles.Add, maxPending: maxPending);
+
+                Assert.Single(tiles);
+                Assert.Equal(0u, tiles[0].Index);
+                Assert.Equal(0u, tiles[0].X);
+                Assert.Equal(0u, tiles[0].Y);
+                Assert.Equal(expected.Data, tiles[0].Pixels.Data);
+            }
+        }
+
+        [Fact]
+        public void ExtensionsPyramidDecode()
+        {
+            const uint tileSize = 256;
+
+            var data = File.ReadAllBytes(Path.Combine(TestImageDirectory, "Bretagne1_0.j2k"));
+
+            var tiles = new List<PyramidTile>();
+            OpenJpeg.PyramidDecode(data, tileSize, ExportFormat.Rgb24, tiles.Add);
+
+            // 640x480 down to the first level which fits in a tile
+            var expected = new[] { new Size(640, 480), new Size(320, 240), new Size(160, 120) };
+            Assert.Equal(Enumerable.Range(0, expected.Length).Select(level => (uint)level), tiles.Select(tile => tile.Level).Distinct());
+            for (var level = 0; level < expected.Length; level++)
+            {
+                var levelTiles = tiles.Where(tile => tile.Level == level).ToArray();
+                var columns = (expected[level].Width + tileSize - 1) / tileSize;
+                var rows = (expected[level].Height + tileSize - 1) / tileSize;
+                Assert.Equal(columns * rows, levelTiles.Length);
+                Assert.Equal(expected[level].Width, (int)levelTiles.Max(tile => tile.X + tile.Pixels.Width));
+                Assert.Equal(expected[level].Height, (int)levelTiles.Max(tile => tile.Y + tile.Pixels.Height));
+
+                foreach (var tile in levelTiles)
+                {
+                    Assert.Equal(tile.Column * tileSize, tile.X);
+                    Assert.Equal(tile.Row * tileSize, tile.Y);
+                    Assert.Equal(tile.Pixels.Width * tile.Pixels.Height * 3, (uint)tile.Pixels.Data.Length);
+                }
+            }
+
+            // The first level is the full decode at the requested reduce
+            using var image = OpenJpeg.DecodeMemory(data, new DecodeOptions { Reduce = 1 });
+            var reduced = image.ExportPixels(ExportFormat.Rgb24);
+            tiles.Clear();
+            OpenJpeg.PyramidDecode(data, 512, ExportFormat.Rgb24, tiles.Add, 1, options: new DecodeOptions { Reduce = 1 });
+            Assert.Single(tiles);
+            Assert.Equal(1u, tiles[0].Level);
+            Assert.Equal(reduced.Data, tiles[0].Pixels.Data);
+        }
+
+        [Fact]
+        public void ExtensionsImagePool()
+        {
+            using var pool = new ImagePool(64 * 1024 * 1024);
+            var parameters = Enumerable.Range(0, 3).Select(_ => new ImageComponentParameters
+            {
+                Dx = 1,
+                Dy = 1,
+                Width = 64,
+                Height = 32,
+                Precision = 8
+            }).ToArray();
+
+            var image = pool.Acquire(parameters, ColorSpace.Srgb);
+            Assert.Equal(1ul, pool.Misses);
+            Assert.Equal(3u, image.NumberOfComponents);
+            pool.Release(image);
+            Assert.True(image.IsDisposed);
+            Assert.Equal(1ul, pool.PooledImages);
+
+            image = pool.Acquire(parameters, ColorSpace.Srgb);
+            Assert.Equal(1ul, pool.Hits);
+            Assert.Equal(0ul, pool.PooledImages);
+            Assert.Equal(64u, image.Components[0].Width);
+            pool.Release(image);
+
+            pool.Trim();
+            Assert.Equal(0ul, pool.PooledImages);
+            Assert.Equal(0ul, pool.PooledBytes);
+
+            // Decoded images come from the pool as well
+            var data = File.ReadAllBytes(Path.Combine(TestImageDirectory, "Bretagne1_0.j2k"));
+            using (var expected = OpenJpeg.DecodeMemory(data))
+            {
+                image = pool.Decode(data);
+                AssertSameImage(expected, image);
+                pool.Release(image);
+                Assert.Equal(1ul, pool.PooledImages);
+
+                image = pool.Decode(data);
+                Assert.Equal(2ul, pool.Hits);
+                AssertSameImage(expected, image);
+                pool.Release(image);
+            }
+
+            foreach (var parameter in parameters)
+                parameter.Dispose();
+            this.DisposeAndCheckDisposedState(pool);
+        }
+
+        [Fact]
+        public void ExtensionsSequenceDecoder()
+        {
+            const int frames = 5;
+
+            var data = File.ReadAllBytes(Path.Combine(TestImageDirectory, "Bretagne1_0.j2k"));
+            using var expected = OpenJpeg.DecodeMemory(data, new DecodeOptions { Reduce = 1 });
+
+            using var sequence = new SequenceDecoder(1, 0, 2);
+            var push = Task.Run(() =>
+            {
+                for (var index = 0; index < frames; index++)
+                    sequence.Push(data);
+                sequence.Finish();
+            });
+
+            for (var index = 0; index < frames; index++)
+            {
+                using var frame = sequence.Pop();
+                Assert.NotNull(frame);
+                Assert.Equal((ulong)index, frame.Index);
+                AssertSameImage(expected, frame.Image);
+            }
+
+            Assert.Null(sequence.Pop());
+            push.Wait();
+
+            this.DisposeAndCheckDisposedState(sequence);
+
+            // The frames are taken from the pool, which outlives its own disposal until the sequence goes
+            var pool = new ImagePool(64 * 1024 * 1024);
+            using (var pooled = new SequenceDecoder(1, 0, 2, 1, 0, pool))
+            {
+                pool.Dispose();
+                pooled.Push(data);
+                pooled.Finish();
+
+                using (var frame = pooled.Pop())
+                    AssertSameImage(expected, frame.Image);
+                Assert.Null(pooled.Pop());
+            }
+        }
+
+        [Fact]
+        public void ExtensionsTileScheduler()
+        {
+            var data = File.ReadAllBytes(Path.Combine(TestImageDirectory, "Bretagne1_0.j2k"));
+            using var image = OpenJpeg.DecodeMemory(data, new DecodeOptions { Reduce = 1 });
+            var expected = image.ExportPixels(ExportFormat.Rgb24);
+
+            var tiles = new List<ScheduledTile>();
+            using var source = CodestreamSource.FromFile(Path.Combine(TestImageDirectory, "Bretagne1_0.j2k"));
+            using var scheduler = new TileScheduler(source, ExportFormat.Rgb24, tile =>
+            {
+                lock (tiles)
+                    tiles.Add(tile);
+            }, 2);
+
+            Assert.True(scheduler.Submit(0, 1, 0, 1));
+            scheduler.Wait();
+            Assert.Equal(1ul, scheduler.Decoded);
+
+            var scheduled = Assert.Single(tiles);
+            Assert.Null(scheduled.Error);
+            Assert.False(scheduled.IsPrefetch);
+            Assert.Equal(1u, scheduled.Reduce);
+            Assert.Equal(1ul, scheduled.Generation);
+            Assert.Equal(expected.Data, scheduled.Pixels.Data);
+
+            scheduler.Advance(2);
+            Assert.False(scheduler.Submit(0, 0, 0, 1));
+
+            this.DisposeAndCheckDisposedState(scheduler);
+            this.DisposeAndCheckDisposedState(source);
+        }
+
+        [Fact]
+        public async Task ExtensionsAsyncPool()
+        {
+            var path = Path.Combine(TestImageDirectory, "Bretagne1_0.j2k");
+            using var expected = DecodeReference(path, CodecFormat.J2k, 0, Rectangle.Empty);
+
+            using var pool = new AsyncPool(2);
+
+            var streams = new List<Stream>();
+            var codecs = new List<Codec>();
+            var images = new List<Image>();
+            var tasks = new List<Task>();
+            for (var index = 0; index < 4; index++)
+            {
+                var stream = OpenJpeg.StreamCreateDefaultFileStream(path, true);
+                var codec = OpenJpeg.CreateDecompress(CodecFormat.J2k);
+                using var decompressionParameters = new DecompressionParameters();
+                OpenJpeg.SetDefaultDecoderParameters(decompressionParameters);
+                Assert.True(OpenJpeg.SetupDecoder(codec, decompressionParameters));
+                Assert.True(OpenJpeg.ReadHeader(stream, codec, out var image));
+
+                tasks.Add(pool.DecodeAsync(codec, stream, image));
+                streams.Add(stream);
+                codecs.Add(codec);
+                images.Add(image);
+            }
+
+            await Task.WhenAll(tasks);
+            foreach (var image in images)
+                AssertSameImage(expected, image);
+
+            Directory.CreateDirectory(Path.Combine(ResultDirectory, nameof(this.ExtensionsAsyncPool)));
+            var encodedPath = Path.Combine(ResultDirectory, nameof(this.ExtensionsAsyncPool), "Bretagne1_0.j2k");
+            using (var codec = OpenJpeg.CreateCompress(CodecFormat.J2k))
+            using (var compressionParameters = new CompressionParameters())
+            {
+                OpenJpeg.SetDefaultEncoderParameters(compressionParameters);
+                Assert.True(OpenJpeg.SetupEncoder(codec, compressionParameters, expected));
+                using var stream = OpenJpeg.StreamCreateDefaultFileStream(encodedPath, false);
+                await pool.EncodeAsync(codec, expected, stream);
+            }
+
+            using var encoded = OpenJpeg.DecodeMemory(File.ReadAllBytes(encodedPath));
+            AssertSameImage(expected, encoded);
+
+            foreach (var image in images)
+                this.DisposeAndCheckDisposedState(image);
+            foreach (var codec in codecs)
+                this.DisposeAndCheckDisposedState(codec);
+            foreach (var stream in streams)
+                this.DisposeAndCheckDisposedState(stream);
+            this.DisposeAndCheckDisposedState(pool);
+        }
+
+        #endregion
+
+        #region Helpers
+
+        private static void AssertSameImage(Image expected, Image actual)
+        {
+            Assert.Equal(expected.NumberOfComponents, actual.NumberOfComponents);
+
+            var expectedComponents = expected.Components;
+            var actualComponents = actual.Components;
+            for (var index = 0; index < expectedComponents.Length; index++)
+            {
+                var expectedComponent = expectedComponents[index];
+                var actualComponent = actualComponents[index];
+                Assert.Equal(expectedComponent.X0, actualComponent.X0);
+                Assert.Equal(expectedComponent.Y0, actualComponent.Y0);
+                Assert.Equal(expectedComponent.Width, actualComponent.Width);
+                Assert.Equal(expectedComponent.Height, actualComponent.Height);
+                Assert.Equal(expectedComponent.Precision, actualComponent.Precision);
+                Assert.Equal(expectedComponent.Signed, actualComponent.Signed);
+                Assert.Equal(expectedComponent.Factor, actualComponent.Factor);
+                Assert.Equal(expectedComponent.Alpha, actualComponent.Alpha);
+
+                var length = (int)(expectedComponent.Width * expectedComponent.Height);
+                var expectedData = new int[length];
+                var actualData = new int[length];
+                Marshal.Copy(expectedComponent.Data, expectedData, 0, length);
+                Marshal.Copy(actualComponent.Data, actualData, 0, length);
+                Assert.Equal(expectedData, actualData);
+            }
+        }
+
+        private static Image CreateImage(uint width, uint height, uint numComps, ColorSpace colorSpace, uint precision = 8, bool signed = false)
+        {
+            var parameters = new ImageComponentParameters[numComps];
+            for (var index = 0; index < parameters.Length; index++)
+            {
+                parameters[index] = new ImageComponentParameters
+                {
+                    Dx = 1,
+                    Dy = 1,
+                    Width = width,
+                    Height = height,
+                    Signed = signed,
+                    Precision = precision
+                };
+            }
+
+            var image = OpenJpeg.ImageCreate(numComps, parameters, colorSpace);
+            image.X1 = width;
+            image.Y1 = height;
+
+            foreach (var parameter in parameters)
+                parameter.Dispose();
+
+            return image;
+        }
+
+        private static Image CreateSubsampledImage(uint x0, uint y0, uint x1, uint y1, uint dx, uint dy, ColorSpace colorSpace)
+        {
+            // The first component is on the reference grid and the other two are subsampled by dx and dy
+            var parameters = new ImageComponentParameters[3];
+            for (var index = 0; index < parameters.Length; index++)
+            {
+                var stepX = index == 0 ? 1 : dx;
+                var stepY = index == 0 ? 1 : dy;
+                var componentX0 = (x0 + stepX - 1) / stepX;
+                var componentY0 = (y0 + stepY - 1) / stepY;
+                parameters[index] = new ImageComponentParameters
+                {
+                    Dx = stepX,
+                    Dy = stepY,
+                    X0 = componentX0,
+                    Y0 = componentY0,
+                    Width = (x1 + stepX - 1) / stepX - componentX0,
+                    Height = (y1 + stepY - 1) / stepY - componentY0,
+                    Signed = false,
+                    Precision = 8
+                };
+            }
+
+            var image = OpenJpeg.ImageCreate((uint)parameters.Length, parameters, colorSpace);
+            image.X0 = x0;
+            image.Y0 = y0;
+            image.X1 = x1;
+            image.Y1 = y1;
+
+            foreach (var parameter in parameters)
+                parameter.Dispose();
+
+            return image;
+        }
+
+        private static int[] GetComponentData(ImageComponent component)
+        {
+            var data = new int[component.Width * component.Height];
+            Marshal.Copy(component.Data, data, 0, data.Length);
+            return data;
+        }
+
+        private static void SetComponentData(ImageComponent component, Func<int, int, int> sample)
+        {
+            var width = (int)component.Width;
+            var height = (int)component.Height;
+            var data = new int[width * height];
+            for (var y = 0; y < height; y++)
+            {
+                for (var x = 0; x < width; x++)
+                    data[y * width + x] = sample(x, y);
+            }
+            Marshal.Copy(data, 0, component.Data, data.Length);
+        }
+
+        // Samples of a component sit at (x0 + i) * dx on the reference grid. Nearest takes the sample at or left of
+        // the output position and bilinear interpolates between it and the next one, clamping both to the component.
+        private static int[] Upsample(ImageComponent reference, ImageComponent component, bool bilinear)
+        {
+            var width = (int)reference.Width;
+            var height = (int)reference.Height;
+            var columns = (int)component.Width;
+            var data = GetComponentData(component);
+
+            var result = new int[width * height];
+            for (var y = 0; y < height; y++)
+            {
+                MapSample(reference.Y0 + (uint)y, reference.Dy, component.Y0, component.Dy, component.Height, out var top, out var bottom, out var weightY);
+                for (var x = 0; x < width; x++)
+                {
+                    MapSample(reference.X0 + (uint)x, reference.Dx, component.X0, component.Dx, component.Width, out var left, out var right, out var weightX);
+                    if (!bilinear)
+                    {
+                        result[y * width + x] = data[top * columns + left];
+                        continue;
+                    }
+
+                    var upper = data[top * columns + left] + (data[top * columns + right] - (float)data[top * columns + left]) * weightX;
+                    var lower = data[bottom * columns + left] + (data[bottom * columns + right] - (float)data[bottom * columns + left]) * weightX;
+                    result[y * width + x] = (int)Math.Round(upper + (lower - upper) * weightY, MidpointRounding.ToEven);
+                }
+            }
+
+            return result;
+        }
+
+        private static void MapSample(uint position, uint referenceStep, uint origin, uint step, uint size, out int near, out int far, out float weight)
+        {
+            var scaled = (long)position * referenceStep;
+            var index = scaled / step - origin;
+            near = (int)Math.Min(size - 1, Math.Max(0, index));
+            far = (int)Math.Min(size - 1, Math.Max(0, index + 1));
+            weight = near == far ? 0.0f : scaled % step / (float)step;
+        }
+
+        // https://github.com/uclouvain/openjpeg/blob/v2.4.0/src/bin/common/color.c (sycc_to_rgb)
+        private static int[] SyccToRgb(int precision, int y, int cb, int cr)
+        {
+            var offset = 1 << (precision - 1);
+            var upb = (1 << precision) - 1;
+            cb -= offset;
+            cr -= offset;
+
+            var r = y + (int)(1.402 * (float)cr);
+            var g = y - (int)(0.344 * (float)cb + 0.714 * (float)cr);
+            var b = y + (int)(1.772 * (float)cb);
+            return new[] { Math.Min(upb, Math.Max(0, r)), Math.Min(upb, Math.Max(0, g)), Math.Min(upb, Math.Max(0, b)) };
+        }
+
+        // round(u * max / range) in integers; the quotient never falls on a half because range is odd
+        private static long Rescale(long u, long range, long max)
+        {
+            return (2 * u * max + range) / (2 * range);
+        }
+
+        // Sums Psot over the tile-parts of each tile, walking the marker segments from the start of the codestream
+        private static ulong[] GetTileSizes(byte[] data, HeaderInfo info)
+        {
+            var sizes = new ulong[info.TilesX * info.TilesY];
+            var position = (int)info.CodestreamOffset + 2;
+            while (ReadUInt16(data, position) != 0xFF90)
+                position += 2 + ReadUInt16(data, position + 2);
+
+            while (ReadUInt16(data, position) == 0xFF90)
+            {
+                var psot = (uint)(ReadUInt16(data, position + 6) << 16 | ReadUInt16(data, position + 8));
+                sizes[ReadUInt16(data, position + 4)] += psot;
+                position += (int)psot;
+            }
+
+            Assert.Equal(0xFFD9, ReadUInt16(data, position));
+            return sizes;
+        }
+
+        private static int ReadUInt16(byte[] data, int position)
+        {
+            return data[position] << 8 | data[position + 1];
+        }
+
+        private static Image DecodeReference(string path, CodecFormat format, uint reduce, Rectangle area)
+        {
+            using var stream = OpenJpeg.StreamCreateDefaultFileStream(path, true);
+            using var codec = OpenJpeg.CreateDecompress(format);
+            using var decompressionParameters = new DecompressionParameters();
+            OpenJpeg.SetDefaultDecoderParameters(decompressionParameters);
+            decompressionParameters.CodingParameterReduce = reduce;
+            Assert.True(OpenJpeg.SetupDecoder(codec, decompressionParameters));
+            Assert.True(OpenJpeg.ReadHeader(stream, codec, out var image));
+            Assert.True(OpenJpeg.SetDecodeArea(codec, image, (uint)area.Left, (uint)area.Top, (uint)area.Right, (uint)area.Bottom));
+            Assert.True(OpenJpeg.Decode(codec, stream, image));
+            Assert.True(OpenJpeg.EndDecompress(codec, stream));
+            return image;
+        }
+
+        #endregion
+
+    }
+
+}
\ No newline at end of file